@@ -0,0 +1,753 @@
+/**
+ * @brief Motor de adquisición por lotes
+ * @description Implementa el registro de descriptores, el reparto del búfer
+ *              en ranuras alineadas y la lectura de todas las ranuras en
+ *              cada ciclo: un envío de io_uring por lote (tantas lecturas
+ *              como entradas tenga el anillo) o, sin io_uring, un bucle de
+ *              preadv(). Cada lectura lleva en user_data el número de lote,
+ *              así un resultado tardío de un lote anterior (una espera
+ *              interrumpida) nunca se confunde con uno del lote actual.
+ *              Con plazo, un resultado tardío es el de una lectura atascada
+ *              que por fin terminó: su archivo vuelve al lote. Un anillo
+ *              con lecturas atascadas no se vuelve a registrar (el kernel
+ *              esperaría a que terminen): se retira con su búfer, que el
+ *              kernel aún puede escribir, y se libera cuando terminan.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdlib.h>     // Para malloc(), calloc(), realloc(), free(), posix_memalign()
+#include <string.h>     // Para memset(), memcpy()
+#include <errno.h>      // Para errno, EINTR, ETIME, ETIMEDOUT
+#include <time.h>       // Para clock_gettime()
+#include <signal.h>     // Para sigfillset()
+#include <pthread.h>    // Para pthread_create(), pthread_cond_timedwait()
+#include <sys/uio.h>    // Para preadv(), struct iovec
+#include <sys/stat.h>   // Para fstat()
+#include "acquire.h"    // Header con declaraciones del módulo
+
+// Máximo de lecturas por envío de io_uring
+#define ACQUIRE_MAX_BATCH 4096
+
+// Búfer propio del hilo lector (mayor que cualquier lectura de los módulos)
+#define ACQUIRE_WORKER_BUF 4096
+
+/**
+ * @brief Lectura atascada: su lote e índice y el archivo que lee
+ * @description El resultado tardío se reconoce por su user_data exacto,
+ *              nunca por el descriptor, que el módulo puede haber cerrado y
+ *              reutilizado para otro archivo.
+ */
+typedef struct acquire_req {
+    uint64_t user_data;        // Lote (parte alta) e índice de la ranura
+    uint64_t dev, ino;         // Archivo leído
+} acquire_req;
+
+/**
+ * @brief Hilo lector para el bucle de lecturas con plazo sin io_uring
+ * @description El hilo recorre las ranuras del trabajo y el daemon espera
+ *              con plazo a que termine. Si vence, la ranura en curso queda
+ *              atascada y el hilo se abandona: cuando su lectura vuelva, ve
+ *              orphan y termina sin tocar el motor (lee en su propio búfer,
+ *              nunca en arena). Otro hilo sigue con las ranuras restantes.
+ */
+typedef struct acquire_worker {
+    pthread_t tid;
+    pthread_mutex_t mu;
+    pthread_cond_t wake;       // Trabajo nuevo o salida (daemon -> hilo)
+    pthread_cond_t progress;   // Trabajo terminado (hilo -> daemon), CLOCK_MONOTONIC
+    acquire *a;
+    int next, end;             // Ranuras pendientes del trabajo actual
+    int busy;                  // 1 = trabajo en curso
+    int quit;                  // 1 = terminar
+    int orphan;                // 1 = abandonado con una lectura atascada
+    int finished;              // 1 = el hilo terminó (se puede unir)
+    int detached;              // 1 = nadie lo unirá: se libera a sí mismo
+    acquire_req stuck;         // Lectura atascada (user_data = ranura)
+    uint32_t gen;              // Registro en que se atascó
+    struct acquire_worker *next_orphan;
+    char buf[ACQUIRE_WORKER_BUF];
+} acquire_worker;
+
+/**
+ * @brief Anillo sustituido que aún tiene lecturas atascadas
+ */
+typedef struct acquire_retired {
+    uring ring;
+    char *arena;               // Búfer registrado en el anillo
+    acquire_req *req;          // Lecturas que aún no terminaron
+    int pending;               // Entradas usadas de req
+    struct acquire_retired *next;
+} acquire_retired;
+
+/**
+ * @brief Tiempo monotónico en nanosegundos
+ */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Indica si la lectura atascada es del archivo de la ranura
+ */
+static int same_file(const acquire_req *q, const acquire_slot *s) {
+    return (s->dev | s->ino) != 0 && q->dev == s->dev && q->ino == s->ino;
+}
+
+/**
+ * @brief Quita la lectura atascada con ese user_data
+ * @return int 1 si estaba, 0 si no (resultado de una lectura no atascada)
+ */
+static int drop_req(acquire_req *req, int *n, uint64_t user_data) {
+    for (int j = 0; j < *n; j++) {
+        if (req[j].user_data == user_data) {
+            req[j] = req[--*n];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Recalcula qué ranuras están atascadas
+ * @description Una ranura está atascada si su archivo tiene una lectura en
+ *              curso: en el anillo actual (por índice, que no cambia hasta
+ *              el siguiente registro), en un anillo retirado o en un hilo
+ *              abandonado (por identidad del archivo, o por ranura si el
+ *              registro no cambió).
+ */
+static void refresh_stuck(acquire *a) {
+    a->stuck = 0;
+    for (int i = 0; i < a->count; i++) {
+        acquire_slot *s = &a->slot[i];
+        s->stuck = 0;
+        for (int j = 0; j < a->inflight && !s->stuck; j++) {
+            s->stuck = (uint32_t)a->req[j].user_data == (uint32_t)i || same_file(&a->req[j], s);
+        }
+        for (acquire_retired *r = a->retired; r != NULL && !s->stuck; r = r->next) {
+            for (int j = 0; j < r->pending && !s->stuck; j++) {
+                s->stuck = same_file(&r->req[j], s);
+            }
+        }
+        for (acquire_worker *w = a->orphans; w != NULL && !s->stuck; w = w->next_orphan) {
+            s->stuck = w->gen == a->gen ? w->stuck.user_data == (uint64_t)i
+                                        : same_file(&w->stuck, s);
+        }
+        a->stuck += s->stuck;
+    }
+}
+
+/**
+ * @brief Inicializa un motor vacío
+ */
+void acquire_init(acquire *a, int use_uring) {
+    memset(a, 0, sizeof(*a));
+    a->use_uring = use_uring;
+    a->ring.fd = -1;
+}
+
+/**
+ * @brief Quita todos los archivos registrados
+ */
+void acquire_clear(acquire *a) {
+    for (int i = 0; i < a->count; i++) {
+        a->fd_slot[a->slot[i].fd] = -1;
+    }
+    a->count = 0;
+    a->arena_len = 0;
+}
+
+/**
+ * @brief Registra un descriptor abierto
+ * @description La posición en el búfer se asigna en acquire_commit().
+ */
+int acquire_add(acquire *a, int fd, size_t len) {
+    if (fd < 0 || len == 0) {
+        return 0;
+    }
+
+    if (fd >= a->fd_cap) {
+        int cap = a->fd_cap ? a->fd_cap : 64;
+        while (cap <= fd) {
+            cap *= 2;
+        }
+        int *map = realloc(a->fd_slot, (size_t)cap * sizeof(*map));
+        if (!map) {
+            return -1;
+        }
+        a->fd_slot = map;
+        for (int i = a->fd_cap; i < cap; i++) {
+            map[i] = -1;
+        }
+        a->fd_cap = cap;
+    }
+
+    int idx = a->fd_slot[fd];
+    if (idx >= 0) {
+        if (len > a->slot[idx].len) {
+            a->slot[idx].len = (uint32_t)len;
+        }
+        return 0;
+    }
+
+    if (a->count == a->cap) {
+        int cap = a->cap ? a->cap * 2 : 64;
+        acquire_slot *slot = realloc(a->slot, (size_t)cap * sizeof(*slot));
+        if (!slot) {
+            return -1;
+        }
+        a->slot = slot;
+        a->cap = cap;
+    }
+    a->slot[a->count] = (acquire_slot){.fd = fd, .len = (uint32_t)len, .res = ACQUIRE_NOT_READ};
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        a->slot[a->count].dev = (uint64_t)st.st_dev;
+        a->slot[a->count].ino = (uint64_t)st.st_ino;
+    }
+    a->fd_slot[fd] = a->count++;
+    return 0;
+}
+
+/**
+ * @brief Libera el anillo actual (sin lecturas atascadas)
+ */
+static void free_ring(acquire *a) {
+    uring_free(&a->ring);
+}
+
+/**
+ * @brief Retira el anillo actual y su búfer hasta que terminen sus lecturas
+ * @return int 0 si éxito, -1 si no hay memoria
+ */
+static int retire_ring(acquire *a) {
+    acquire_retired *r = malloc(sizeof(*r));
+    if (!r) {
+        return -1;
+    }
+    *r = (acquire_retired){.ring = a->ring, .arena = a->arena, .req = a->req,
+                           .pending = a->inflight, .next = a->retired};
+    a->retired = r;
+
+    memset(&a->ring, 0, sizeof(a->ring));
+    a->ring.fd = -1;
+    a->req = NULL;
+    a->arena = NULL;
+    a->arena_cap = 0;
+    a->inflight = 0;
+    return 0;
+}
+
+/**
+ * @brief Recoge las lecturas atascadas que terminaron en anillos retirados
+ */
+static void reap_retired(acquire *a) {
+    uring_completion c[16];
+    int changed = 0;
+
+    for (acquire_retired **p = &a->retired; *p != NULL;) {
+        acquire_retired *r = *p;
+        unsigned k;
+        while ((k = uring_reap(&r->ring, c, 16)) > 0) {
+            for (unsigned j = 0; j < k; j++) {
+                changed |= drop_req(r->req, &r->pending, c[j].user_data);
+            }
+        }
+        if (r->pending > 0) {
+            p = &r->next;
+            continue;
+        }
+        *p = r->next;
+        uring_free(&r->ring);
+        free(r->arena);
+        free(r->req);
+        free(r);
+    }
+    if (changed) {
+        refresh_stuck(a);
+    }
+}
+
+/**
+ * @brief Recoge las lecturas atascadas que terminaron en el anillo actual
+ * @description Se hace antes del lote: si todas las ranuras están atascadas
+ *              no se envía nada y run_batch() no recogería resultados.
+ */
+static void reap_late(acquire *a) {
+    int changed = 0;
+    unsigned k;
+
+    while ((k = uring_reap(&a->ring, a->done, (unsigned)a->count)) > 0) {
+        for (unsigned j = 0; j < k; j++) {
+            changed |= drop_req(a->req, &a->inflight, a->done[j].user_data);
+        }
+    }
+    if (changed) {
+        refresh_stuck(a);
+    }
+}
+
+/**
+ * @brief Registra descriptores y búfer en el anillo
+ * @description El anillo se reutiliza si tiene entradas suficientes; si
+ *              no, se crea de nuevo. Ante cualquier fallo se libera y el
+ *              motor usa preadv().
+ */
+static void register_ring(acquire *a) {
+    unsigned want = 1;
+    while (want < (unsigned)a->count && want < ACQUIRE_MAX_BATCH) {
+        want <<= 1;
+    }
+    if (a->ring.fd >= 0 && a->ring.entries < want) {
+        free_ring(a);
+    }
+    if (a->ring.fd < 0 && uring_init(&a->ring, want) < 0) {
+        return;
+    }
+
+    int *fds = malloc((size_t)a->count * sizeof(*fds));
+    if (!fds) {
+        free_ring(a);
+        return;
+    }
+    for (int i = 0; i < a->count; i++) {
+        fds[i] = a->slot[i].fd;
+    }
+    struct iovec iov = {.iov_base = a->arena, .iov_len = a->arena_len};
+    if (uring_register_files(&a->ring, fds, (unsigned)a->count) < 0
+        || uring_register_buffers(&a->ring, &iov, 1) < 0) {
+        free_ring(a);
+    }
+    free(fds);
+}
+
+/**
+ * @brief Prepara el búfer y registra descriptores y búfer en el anillo
+ */
+int acquire_commit(acquire *a) {
+    if (a->ring.fd >= 0 && a->inflight > 0 && retire_ring(a) < 0) {
+        return -1;
+    }
+
+    size_t off = 0;
+    for (int i = 0; i < a->count; i++) {
+        a->slot[i].off = (uint32_t)off;
+        a->slot[i].res = ACQUIRE_NOT_READ;
+        off += (a->slot[i].len + ACQUIRE_ALIGN - 1) & ~(size_t)(ACQUIRE_ALIGN - 1);
+    }
+    a->arena_len = off;
+
+    // Búfer alineado a página: io_uring fija sus páginas al registrarlo
+    if (off > a->arena_cap) {
+        void *p;
+        if (posix_memalign(&p, 4096, off) != 0) {
+            return -1;
+        }
+        free(a->arena);
+        a->arena = p;
+        a->arena_cap = off;
+    }
+    uring_completion *done = realloc(a->done, (size_t)(a->count ? a->count : 1) * sizeof(*done));
+    if (!done) {
+        return -1;
+    }
+    a->done = done;
+    // Cada ranura tiene como mucho una lectura atascada en el anillo actual
+    acquire_req *req = realloc(a->req, (size_t)(a->count ? a->count : 1) * sizeof(*req));
+    if (!req) {
+        return -1;
+    }
+    a->req = req;
+    a->gen++;
+
+    if (a->use_uring && a->count > 0) {
+        register_ring(a);
+    } else if (a->ring.fd >= 0) {
+        free_ring(a);
+    }
+    // Sin esperas con plazo en el kernel (anterior a 5.11): hilo lector
+    if (a->ring.fd >= 0 && a->timeout_ms > 0 && !uring_has_timeout(&a->ring)) {
+        free_ring(a);
+    }
+    a->batch = a->ring.fd >= 0 ? a->ring.entries : (unsigned)a->count;
+    refresh_stuck(a);
+    return 0;
+}
+
+/**
+ * @brief Envía un lote de ranuras consecutivas y recoge sus resultados
+ * @description Con plazo (deadline != 0), las lecturas enviadas que no
+ *              terminan a tiempo siguen en curso en el anillo y su ranura
+ *              queda atascada. Las que el kernel no llegó a tomar (plazo
+ *              vencido antes del envío, envío parcial) se retiran de la
+ *              cola: no se leen en este ciclo, pero no quedan en curso. Un
+ *              resultado de otro lote es el de una lectura atascada que
+ *              terminó, si su user_data coincide con una de ellas.
+ *
+ * @return int Ranuras leídas con éxito
+ */
+static int run_batch(acquire *a, int first, int n, uint32_t seq, uint64_t deadline) {
+    int ok = 0, changed = 0;
+    unsigned got = 0, want = 0;
+
+    for (int i = first; i < first + n; i++) {
+        acquire_slot *s = &a->slot[i];
+        if (s->stuck) {
+            s->res = -ETIMEDOUT;
+            continue;
+        }
+        if (uring_queue_read(&a->ring, (unsigned)i, a->arena + s->off, s->len, 0,
+                             (uint64_t)seq << 32 | (uint32_t)i) < 0) {
+            break;
+        }
+        want++;
+    }
+
+    while (got < want) {
+        int rc;
+        if (deadline != 0) {
+            uint64_t now = now_ns();
+            if (now >= deadline) {
+                break;
+            }
+            rc = uring_submit_timeout(&a->ring, want - got, deadline - now);
+        } else {
+            rc = uring_submit(&a->ring, want - got);
+        }
+        if (rc < 0 && errno != EINTR && errno != ETIME) {
+            break;
+        }
+        unsigned k = uring_reap(&a->ring, a->done, (unsigned)a->count);
+        for (unsigned j = 0; j < k; j++) {
+            if ((uint32_t)(a->done[j].user_data >> 32) != seq) {
+                changed |= drop_req(a->req, &a->inflight, a->done[j].user_data);
+                continue;
+            }
+            acquire_slot *s = &a->slot[(uint32_t)a->done[j].user_data];
+            s->res = a->done[j].res;
+            ok += s->res >= 0;
+            got++;
+        }
+    }
+    unsigned sent = want - uring_unqueue(&a->ring);
+
+    // Las ranuras se encolaron en orden y el kernel toma la cola en orden:
+    // las primeras sent se enviaron
+    if (deadline != 0 && got < want) {
+        unsigned q = 0;
+        for (int i = first; i < first + n; i++) {
+            acquire_slot *s = &a->slot[i];
+            if (s->stuck) {
+                continue;
+            }
+            int submitted = q++ < sent;
+            if (s->res != ACQUIRE_NOT_READ) {
+                continue;
+            }
+            s->res = -ETIMEDOUT;
+            if (submitted) {
+                a->req[a->inflight++] = (acquire_req){.user_data = (uint64_t)seq << 32 | (uint32_t)i,
+                                                      .dev = s->dev, .ino = s->ino};
+                a->timeouts++;
+                changed = 1;
+            }
+        }
+    }
+    if (changed) {
+        refresh_stuck(a);
+    }
+    return ok;
+}
+
+/**
+ * @brief Libera un hilo lector ya terminado
+ */
+static void worker_destroy(acquire_worker *w) {
+    pthread_mutex_destroy(&w->mu);
+    pthread_cond_destroy(&w->wake);
+    pthread_cond_destroy(&w->progress);
+    free(w);
+}
+
+/**
+ * @brief Cuerpo del hilo lector: lee las ranuras de cada trabajo
+ * @description Las ranuras con resultado ya asignado (atascadas) se saltan.
+ *              La lectura se hace sin el cerrojo y en el búfer del hilo.
+ */
+static void *worker_main(void *arg) {
+    acquire_worker *w = arg;
+
+    pthread_mutex_lock(&w->mu);
+    while (!w->quit && !w->orphan) {
+        if (!w->busy) {
+            pthread_cond_wait(&w->wake, &w->mu);
+            continue;
+        }
+        if (w->next == w->end) {
+            w->busy = 0;
+            pthread_cond_signal(&w->progress);
+            continue;
+        }
+        acquire_slot *s = &w->a->slot[w->next];
+        if (s->res != ACQUIRE_NOT_READ) {
+            w->next++;
+            continue;
+        }
+
+        int fd = s->fd;
+        size_t len = s->len < sizeof(w->buf) ? s->len : sizeof(w->buf);
+        pthread_mutex_unlock(&w->mu);
+        ssize_t n = pread(fd, w->buf, len, 0);
+        int err = errno;
+        pthread_mutex_lock(&w->mu);
+        if (w->orphan) {
+            break;
+        }
+
+        s = &w->a->slot[w->next];
+        if (n >= 0) {
+            memcpy(w->a->arena + s->off, w->buf, (size_t)n);
+        }
+        s->res = n >= 0 ? (int32_t)n : -err;
+        w->next++;
+    }
+
+    w->finished = 1;
+    int detached = w->detached;
+    pthread_mutex_unlock(&w->mu);
+    if (detached) {
+        worker_destroy(w);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Crea un hilo lector
+ * @return acquire_worker* Hilo, o NULL si no se pudo crear
+ */
+static acquire_worker *worker_start(acquire *a) {
+    acquire_worker *w = calloc(1, sizeof(*w));
+    if (!w) {
+        return NULL;
+    }
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&w->mu, NULL);
+    pthread_cond_init(&w->wake, NULL);
+    pthread_cond_init(&w->progress, &attr);
+    pthread_condattr_destroy(&attr);
+    w->a = a;
+
+    // Las señales del daemon las atiende siempre el hilo principal
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    int rc = pthread_create(&w->tid, NULL, worker_main, w);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (rc != 0) {
+        worker_destroy(w);
+        return NULL;
+    }
+    return w;
+}
+
+/**
+ * @brief Une los hilos abandonados cuya lectura atascada terminó
+ */
+static void reap_orphans(acquire *a) {
+    int reaped = 0;
+
+    for (acquire_worker **p = &a->orphans; *p != NULL;) {
+        acquire_worker *w = *p;
+        pthread_mutex_lock(&w->mu);
+        int finished = w->finished;
+        pthread_mutex_unlock(&w->mu);
+        if (!finished) {
+            p = &w->next_orphan;
+            continue;
+        }
+        *p = w->next_orphan;
+        pthread_join(w->tid, NULL);
+        worker_destroy(w);
+        reaped = 1;
+    }
+    if (reaped) {
+        refresh_stuck(a);
+    }
+}
+
+/**
+ * @brief Lee las ranuras desde first con preadv(), sin plazo
+ */
+static void read_inline(acquire *a, int first) {
+    for (int i = first; i < a->count; i++) {
+        acquire_slot *s = &a->slot[i];
+        if (s->res != ACQUIRE_NOT_READ) {
+            continue;
+        }
+        struct iovec iov = {.iov_base = a->arena + s->off, .iov_len = s->len};
+        ssize_t n = preadv(s->fd, &iov, 1, 0);
+        s->res = n >= 0 ? (int32_t)n : -errno;
+    }
+}
+
+/**
+ * @brief Lee las ranuras en el hilo lector esperando con plazo
+ * @description Cada vez que vence el plazo, la ranura en curso queda
+ *              atascada, el hilo se abandona y uno nuevo sigue desde la
+ *              siguiente ranura con un plazo nuevo.
+ */
+static void run_worker(acquire *a) {
+    int first = 0;
+
+    while (first < a->count) {
+        if (a->worker == NULL && (a->worker = worker_start(a)) == NULL) {
+            read_inline(a, first);
+            return;
+        }
+        acquire_worker *w = a->worker;
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += a->timeout_ms / 1000;
+        deadline.tv_nsec += (long)(a->timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        pthread_mutex_lock(&w->mu);
+        w->next = first;
+        w->end = a->count;
+        w->busy = 1;
+        pthread_cond_signal(&w->wake);
+        int rc = 0;
+        while (w->busy && rc != ETIMEDOUT) {
+            rc = pthread_cond_timedwait(&w->progress, &w->mu, &deadline);
+        }
+        if (!w->busy) {
+            pthread_mutex_unlock(&w->mu);
+            return;
+        }
+
+        // Venció el plazo con la ranura w->next en curso
+        acquire_slot *s = &a->slot[w->next];
+        first = w->next + 1;
+        w->orphan = 1;
+        w->stuck = (acquire_req){.user_data = (uint64_t)(w->next), .dev = s->dev, .ino = s->ino};
+        w->gen = a->gen;
+        pthread_mutex_unlock(&w->mu);
+
+        s->res = -ETIMEDOUT;
+        a->timeouts++;
+        w->next_orphan = a->orphans;
+        a->orphans = w;
+        a->worker = NULL;
+        refresh_stuck(a);
+    }
+}
+
+/**
+ * @brief Lee todos los archivos registrados en un lote
+ * @description Sin plazo, las ranuras que no se completan (error del envío)
+ *              quedan como ACQUIRE_NOT_READ y acquire_pread() las lee
+ *              directamente. Con plazo, todas terminan con un resultado.
+ */
+int acquire_run(acquire *a) {
+    int ok = 0;
+
+    reap_orphans(a);
+    reap_retired(a);
+    for (int i = 0; i < a->count; i++) {
+        a->slot[i].res = ACQUIRE_NOT_READ;
+    }
+
+    if (a->ring.fd >= 0) {
+        if (a->inflight > 0) {
+            reap_late(a);
+        }
+        uint64_t deadline = a->timeout_ms > 0 ? now_ns() + a->timeout_ms * 1000000ull : 0;
+        a->seq++;
+        for (int first = 0; first < a->count; first += (int)a->batch) {
+            int n = a->count - first < (int)a->batch ? a->count - first : (int)a->batch;
+            ok += run_batch(a, first, n, a->seq, deadline);
+        }
+        return ok;
+    }
+
+    for (int i = 0; i < a->count; i++) {
+        if (a->slot[i].stuck) {
+            a->slot[i].res = -ETIMEDOUT;
+        }
+    }
+    if (a->timeout_ms > 0) {
+        run_worker(a);
+    } else {
+        read_inline(a, 0);
+    }
+    for (int i = 0; i < a->count; i++) {
+        ok += a->slot[i].res >= 0;
+    }
+    return ok;
+}
+
+/**
+ * @brief Nombre del mecanismo en uso
+ */
+const char *acquire_backend(const acquire *a) {
+    return a->ring.fd >= 0 ? "io_uring" : "preadv";
+}
+
+/**
+ * @brief Libera el motor (no cierra los descriptores registrados)
+ */
+void acquire_free(acquire *a) {
+    acquire_worker *w = a->worker;
+    if (w != NULL) {
+        pthread_mutex_lock(&w->mu);
+        w->quit = 1;
+        pthread_cond_signal(&w->wake);
+        pthread_mutex_unlock(&w->mu);
+        pthread_join(w->tid, NULL);
+        worker_destroy(w);
+    }
+    while (a->orphans != NULL) {
+        w = a->orphans;
+        a->orphans = w->next_orphan;
+        pthread_mutex_lock(&w->mu);
+        int finished = w->finished;
+        w->detached = !finished;
+        pthread_mutex_unlock(&w->mu);
+        if (finished) {
+            pthread_join(w->tid, NULL);
+            worker_destroy(w);
+        } else {
+            pthread_detach(w->tid);
+        }
+    }
+
+    // Un búfer con lecturas atascadas no se libera: el kernel aún puede
+    // escribir en él
+    while (a->retired != NULL) {
+        acquire_retired *r = a->retired;
+        a->retired = r->next;
+        uring_free(&r->ring);
+        free(r->req);
+        free(r);
+    }
+    if (a->inflight == 0) {
+        free(a->arena);
+    }
+    free_ring(a);
+
+    free(a->slot);
+    free(a->fd_slot);
+    free(a->req);
+    free(a->done);
+    unsigned timeout_ms = a->timeout_ms;
+    acquire_init(a, a->use_uring);
+    a->timeout_ms = timeout_ms;
+}
@@ -0,0 +1,169 @@
+/**
+ * @brief Header del motor de adquisición por lotes
+ * @description Define el motor que lee en cada ciclo todos los archivos de
+ *              sysfs y /proc que el daemon mantiene abiertos (canales de
+ *              temperatura, /proc/stat, frecuencias, throttling, RAPL, PSI
+ *              y cpu.stat de los cgroups). Los descriptores se registran una
+ *              sola vez; en cada ciclo se envía un único lote de lecturas
+ *              con io_uring (descriptores y búfer registrados) y se recogen
+ *              todos los resultados de una vez. Sin io_uring se leen con un
+ *              bucle de preadv() sobre el mismo búfer.
+ *              Los módulos no cambian su forma de leer: llaman a
+ *              acquire_pread(), que copia el resultado del lote si el
+ *              descriptor está en él y hace una pread() directa si no (o si
+ *              el motor es NULL, como en cpu_stressor).
+ *              Con un plazo (timeout_ms) ningún archivo bloquea el ciclo:
+ *              con io_uring la espera del lote tiene plazo; sin io_uring las
+ *              lecturas se hacen en un hilo dedicado y el daemon espera con
+ *              plazo. Un archivo que no responde queda atascado: su lectura
+ *              sigue en curso, el archivo se omite (acquire_pread() falla
+ *              con ETIMEDOUT, sin leerlo directamente) y vuelve al lote
+ *              cuando esa lectura termina. El atasco es del archivo
+ *              (dispositivo e inodo), no del número de descriptor: un
+ *              descriptor reutilizado para otro archivo no lo hereda.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef ACQUIRE_H  // Si ACQUIRE_H no está definido
+#define ACQUIRE_H  // Definir ACQUIRE_H como macro de protección
+
+#include <stdint.h>     // Para tipos de ancho fijo
+#include <stddef.h>     // Para size_t
+#include <string.h>     // Para memcpy()
+#include <errno.h>      // Para errno
+#include <unistd.h>     // Para pread(), ssize_t
+#include "uring.h"      // Para uring
+
+// Resultado de una ranura que no se leyó en el último lote
+#define ACQUIRE_NOT_READ INT32_MIN
+
+// Alineación de cada ranura en el búfer (una línea de caché)
+#define ACQUIRE_ALIGN 64
+
+/**
+ * @brief Un archivo registrado y el resultado de su última lectura
+ */
+typedef struct {
+    int fd;                    // Descriptor (propiedad del módulo que lo abrió)
+    uint32_t off;              // Posición de su búfer en arena
+    uint32_t len;              // Bytes a leer
+    int32_t res;               // Bytes leídos, -errno o ACQUIRE_NOT_READ
+    uint8_t stuck;             // 1 = una lectura de este archivo sigue en curso
+    uint64_t dev, ino;         // Identidad del archivo (0 = desconocida)
+} acquire_slot;
+
+struct acquire_worker;
+struct acquire_retired;
+struct acquire_req;
+
+/**
+ * @brief Estado del motor
+ */
+typedef struct {
+    int use_uring;             // 1 = intentar io_uring (clave acquire_uring)
+    acquire_slot *slot;        // Archivos registrados
+    int count, cap;
+    int *fd_slot;              // Ranura de cada descriptor (-1 = ninguna)
+    int fd_cap;
+    char *arena;               // Búfer de destino de todas las lecturas
+    size_t arena_len, arena_cap;
+    uring ring;                // Anillo (fd = -1 = bucle de preadv())
+    uring_completion *done;    // Resultados recogidos
+    unsigned batch;            // Ranuras por envío (capacidad del anillo)
+    uint32_t seq;              // Número del lote actual (parte alta de user_data)
+    unsigned timeout_ms;       // Plazo de cada lote (0 = sin plazo, lecturas en línea)
+    uint32_t gen;              // Número del registro actual (acquire_commit())
+    struct acquire_req *req;   // Lecturas atascadas en el anillo actual (count)
+    int inflight;              // Entradas usadas de req
+    int stuck;                 // Ranuras atascadas en total
+    unsigned long timeouts;    // Lecturas que vencieron el plazo desde el inicio
+    struct acquire_worker *worker;   // Hilo lector (sin io_uring y con plazo)
+    struct acquire_worker *orphans;  // Hilos abandonados con una lectura atascada
+    struct acquire_retired *retired; // Anillos sustituidos con lecturas atascadas
+} acquire;
+
+/**
+ * @brief Inicializa un motor vacío
+ * @param use_uring 1 para usar io_uring si está disponible
+ */
+void acquire_init(acquire *a, int use_uring);
+
+/**
+ * @brief Quita todos los archivos registrados
+ * @description Se llama antes de volver a registrar el conjunto tras
+ *              reabrir descriptores (recarga, hotplug, nuevos cgroups).
+ */
+void acquire_clear(acquire *a);
+
+/**
+ * @brief Registra un descriptor abierto
+ * @description Un descriptor ya registrado conserva la mayor longitud
+ *              pedida. Los descriptores negativos se ignoran.
+ *
+ * @param len Bytes que lee el módulo en cada muestra
+ *
+ * @return int 0 si éxito, -1 si no hay memoria
+ */
+int acquire_add(acquire *a, int fd, size_t len);
+
+/**
+ * @brief Prepara el búfer y registra descriptores y búfer en el anillo
+ * @description Si io_uring no está disponible o el registro falla, el motor
+ *              queda en el bucle de preadv().
+ *
+ * @return int 0 si éxito, -1 si no hay memoria
+ */
+int acquire_commit(acquire *a);
+
+/**
+ * @brief Lee todos los archivos registrados en un lote
+ * @description Con timeout_ms > 0 vuelve como mucho tras un plazo más un
+ *              plazo por cada archivo que se atasca en este ciclo; los ya
+ *              atascados no se leen.
+ *
+ * @return int Archivos leídos con éxito
+ */
+int acquire_run(acquire *a);
+
+/**
+ * @brief Nombre del mecanismo en uso ("io_uring" o "preadv")
+ */
+const char *acquire_backend(const acquire *a);
+
+/**
+ * @brief Libera el motor (no cierra los descriptores registrados)
+ */
+void acquire_free(acquire *a);
+
+/**
+ * @brief Indica si la última lectura del descriptor sigue atascada
+ */
+static inline int acquire_stuck(const acquire *a, int fd) {
+    return a != NULL && fd >= 0 && fd < a->fd_cap && a->fd_slot[fd] >= 0
+        && a->slot[a->fd_slot[fd]].stuck;
+}
+
+/**
+ * @brief Lectura desde el desplazamiento 0 servida por el último lote
+ * @description Misma semántica que pread(fd, buf, len, 0). Si el motor es
+ *              NULL, el descriptor no está registrado o no se leyó en el
+ *              último lote, hace la pread() directamente.
+ */
+static inline ssize_t acquire_pread(const acquire *a, int fd, void *buf, size_t len) {
+    if (a != NULL && fd >= 0 && fd < a->fd_cap && a->fd_slot[fd] >= 0) {
+        const acquire_slot *s = &a->slot[a->fd_slot[fd]];
+        if (s->res >= 0) {
+            size_t n = (size_t)s->res < len ? (size_t)s->res : len;
+            memcpy(buf, a->arena + s->off, n);
+            return (ssize_t)n;
+        }
+        if (s->res != ACQUIRE_NOT_READ) {
+            errno = -s->res;
+            return -1;
+        }
+    }
+    return pread(fd, buf, len, 0);
+}
+
+#endif // ACQUIRE_H - Fin de las guardas de inclusión
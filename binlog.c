@@ -0,0 +1,142 @@
+/**
+ * @brief Módulo de log binario de muestras y eventos
+ * @description Implementa el escritor con buffer (una write() por ciclo del
+ *              daemon) y el lector secuencial usado por cpu_trace_export.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <string.h>     // Para memcpy(), memset()
+#include <unistd.h>     // Para write(), lseek(), ftruncate(), close(), getpid()
+#include <fcntl.h>      // Para open() y constantes O_*
+#include <errno.h>      // Para errno, EINTR
+#include <time.h>       // Para clock_gettime()
+#include "binlog.h"     // Header con declaraciones del módulo
+
+/**
+ * @brief Tiempo actual de un reloj en nanosegundos
+ */
+static uint64_t clock_ns(clockid_t id) {
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Abre (o crea) un log binario en modo anexado
+ */
+int binlog_open(binlog_writer *w, const char *path) {
+    w->len = 0;
+    w->fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (w->fd < 0) {
+        return -1;
+    }
+
+    binlog_start start;
+    memset(&start, 0, sizeof(start));
+    start.pid = (int32_t)getpid();
+    start.version = BINLOG_VERSION;
+    start.realtime_ns = (int64_t)clock_ns(CLOCK_REALTIME);
+
+    binlog_append(w, BINLOG_START, clock_ns(CLOCK_MONOTONIC), &start, sizeof(start));
+    return binlog_flush(w);
+}
+
+/**
+ * @brief Añade un registro al buffer del escritor
+ */
+void binlog_append(binlog_writer *w, binlog_type type, uint64_t ts_ns,
+                   const void *payload, uint16_t size) {
+    binlog_header hdr;
+
+    if (w->fd < 0 || size > BINLOG_MAX_PAYLOAD) {
+        return;
+    }
+    if (w->len + sizeof(hdr) + size > sizeof(w->buf)) {
+        binlog_flush(w);
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.type = (uint16_t)type;
+    hdr.size = size;
+    hdr.ts_ns = ts_ns;
+
+    memcpy(w->buf + w->len, &hdr, sizeof(hdr));
+    memcpy(w->buf + w->len + sizeof(hdr), payload, size);
+    w->len += sizeof(hdr) + size;
+}
+
+/**
+ * @brief Escribe los registros pendientes con una sola write()
+ * @description Con O_APPEND cada write() es atómica respecto a la posición,
+ *              por lo que un lector concurrente nunca ve registros
+ *              intercalados; como mucho ve el último incompleto.
+ *              Una escritura parcial (disco lleno, cuota, señal) se completa
+ *              con más write(). Si aun así el lote queda a medias, se
+ *              trunca el archivo al tamaño previo: un registro cortado
+ *              desalinearía todos los siguientes para el lector.
+ */
+int binlog_flush(binlog_writer *w) {
+    size_t done = 0;
+
+    if (w->fd < 0 || w->len == 0) {
+        return 0;
+    }
+
+    while (done < w->len) {
+        ssize_t n = write(w->fd, w->buf + done, w->len - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        done += (size_t)n;
+    }
+
+    int complete = done == w->len;
+    if (done > 0 && !complete) {
+        // Con O_APPEND la posición queda al final de lo escrito
+        off_t end = lseek(w->fd, 0, SEEK_CUR);
+        if (end >= (off_t)done) {
+            ftruncate(w->fd, end - (off_t)done);
+        }
+    }
+    w->len = 0;
+    return complete ? 0 : -1;
+}
+
+/**
+ * @brief Vacía y cierra el log binario
+ */
+void binlog_close(binlog_writer *w) {
+    if (w->fd >= 0) {
+        binlog_flush(w);
+        close(w->fd);
+        w->fd = -1;
+    }
+}
+
+/**
+ * @brief Lee el siguiente registro de un log binario
+ */
+int binlog_read(FILE *in, binlog_record *rec) {
+    size_t n = fread(&rec->hdr, 1, sizeof(rec->hdr), in);
+    if (n == 0) {
+        return 0;
+    }
+    if (n != sizeof(rec->hdr)) {
+        return -1;
+    }
+
+    size_t keep = rec->hdr.size < BINLOG_MAX_PAYLOAD ? rec->hdr.size : BINLOG_MAX_PAYLOAD;
+    memset(rec->payload, 0, sizeof(rec->payload));
+    if (fread(rec->payload, 1, keep, in) != keep) {
+        return -1;
+    }
+
+    // Saltar la parte de la carga útil que no cabe en el registro
+    if (rec->hdr.size > keep && fseek(in, (long)(rec->hdr.size - keep), SEEK_CUR) < 0) {
+        return -1;
+    }
+    return 1;
+}
@@ -0,0 +1,308 @@
+/**
+ * @brief Header del módulo de log binario de muestras y eventos
+ * @description Define un formato de log binario de solo anexado, compuesto de
+ *              registros tipados de tamaño variable: cada registro lleva una
+ *              cabecera fija (tipo, tamaño, marca de tiempo CLOCK_MONOTONIC)
+ *              seguida de su carga útil. Los lectores saltan los tipos que no
+ *              conocen, así que se pueden añadir tipos nuevos sin romper el
+ *              formato. El daemon lo escribe con una sola write() por ciclo;
+ *              cpu_trace_export lo lee en streaming.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef BINLOG_H  // Si BINLOG_H no está definido
+#define BINLOG_H  // Definir BINLOG_H como macro de protección
+
+#include <stdio.h>   // Para FILE
+#include <stdint.h>  // Para tipos de ancho fijo
+
+// Versión del formato (registro BINLOG_START)
+#define BINLOG_VERSION 1
+
+// Tamaño máximo de la carga útil de un registro
+#define BINLOG_MAX_PAYLOAD 240
+
+// Capacidad del buffer de escritura (registros de un ciclo, incluido un
+// BINLOG_CPU por CPU)
+#define BINLOG_BUF_SIZE 16384
+
+/**
+ * @brief Tipos de registro
+ */
+typedef enum {
+    BINLOG_START = 1,    // Arranque del daemon (pid, versión, ancla de reloj)
+    BINLOG_CHANNEL = 2,  // Descripción de un canal de sensor
+    BINLOG_SAMPLE = 3,   // Muestra de temperatura
+    BINLOG_ALERT = 4,    // Alerta por umbral superado
+    BINLOG_SPAN = 5,         // Duración de una etapa del ciclo del daemon
+    BINLOG_CGROUP_NAME = 6,  // Nombre de un cgroup muestreado
+    BINLOG_CGROUP = 7,       // Consumo de CPU de un cgroup en el último intervalo
+    BINLOG_CPU = 8,          // Utilización, frecuencia y throttling de una CPU
+    BINLOG_THROTTLE = 9,     // Episodio de throttling cerrado de un núcleo
+    BINLOG_POWER_ZONE = 10,  // Nombre de una zona de energía (RAPL)
+    BINLOG_POWER = 11,       // Potencia media de una zona en el último intervalo
+    BINLOG_PSI = 12,         // Presión (PSI) de un recurso en el último intervalo
+    BINLOG_PMU = 13,         // IPC y frecuencia efectiva de una CPU (perf_event)
+    BINLOG_TOPO = 14,        // Agregados de un núcleo, CCD, paquete o nodo NUMA
+    BINLOG_STRESS = 15,      // Rendimiento de cpu_stressor en el último intervalo
+    BINLOG_CHUNK_INFO = 16,  // Log de latencias de cpu_stressor: núcleo y ventana
+    BINLOG_CHUNK = 17,       // Latencia de los bloques de un hilo en una ventana
+    BINLOG_CHUNK_SUMMARY = 18 // Percentiles finales de la latencia de un hilo
+} binlog_type;
+
+/**
+ * @brief Cabecera común de todos los registros
+ */
+typedef struct {
+    uint16_t type;      // binlog_type
+    uint16_t size;      // Bytes de carga útil tras la cabecera
+    uint32_t reserved;
+    uint64_t ts_ns;     // CLOCK_MONOTONIC, mismo reloj que perf y Perfetto
+} binlog_header;
+
+/**
+ * @brief Carga útil de BINLOG_START
+ */
+typedef struct {
+    int32_t pid;          // PID del daemon
+    uint32_t version;     // BINLOG_VERSION
+    int64_t realtime_ns;  // CLOCK_REALTIME en el mismo instante que ts_ns
+} binlog_start;
+
+/**
+ * @brief Carga útil de BINLOG_CHANNEL
+ */
+typedef struct {
+    int32_t channel;   // Índice en la tabla de sensores (-1 = 'sensors')
+    char driver[32];   // Driver hwmon
+    char label[32];    // Etiqueta del canal
+} binlog_channel;
+
+/**
+ * @brief Carga útil de BINLOG_SAMPLE
+ */
+typedef struct {
+    int32_t channel;   // Canal de la muestra
+    int32_t milli;     // Temperatura en miligrados Celsius
+} binlog_sample;
+
+/**
+ * @brief Carga útil de BINLOG_ALERT
+ */
+typedef struct {
+    int32_t channel;           // Canal que disparó la alerta
+    int32_t milli;             // Temperatura en miligrados Celsius
+    int32_t threshold_milli;   // Umbral configurado en miligrados
+    int32_t reserved;
+} binlog_alert;
+
+/**
+ * @brief Carga útil de BINLOG_SPAN (ts_ns es el inicio de la etapa)
+ */
+typedef struct {
+    uint32_t stage;    // selfstat_stage
+    uint32_t reserved;
+    uint64_t dur_ns;   // Duración de la etapa
+} binlog_span;
+
+/**
+ * @brief Carga útil de BINLOG_CGROUP_NAME
+ */
+typedef struct {
+    int32_t id;        // Índice del grupo en las muestras BINLOG_CGROUP
+    uint32_t reserved;
+    char name[128];    // Ruta relativa a cgroup_root
+} binlog_cgroup_name;
+
+/**
+ * @brief Carga útil de BINLOG_CGROUP (deltas desde la muestra anterior)
+ */
+typedef struct {
+    int32_t id;              // Índice del grupo
+    uint32_t nr_throttled;   // Periodos limitados por cpu.max
+    uint64_t usage_usec;     // Tiempo de CPU consumido
+    uint64_t throttled_usec; // Tiempo limitado
+    uint32_t host_share_ppm; // Partes por millón de la capacidad del host
+    uint32_t reserved;
+} binlog_cgroup;
+
+/**
+ * @brief Carga útil de BINLOG_CPU (misma marca de tiempo que la muestra)
+ */
+typedef struct {
+    uint16_t cpu;            // Número de CPU
+    uint16_t util_pm;        // Utilización en el último intervalo (por mil)
+    uint16_t freq_mhz;       // Frecuencia actual en MHz
+    uint16_t reserved;
+    uint32_t core_throttle;  // Eventos de throttling del núcleo en el intervalo
+    uint32_t pkg_throttle;   // Eventos de throttling del paquete en el intervalo
+} binlog_cpu;
+
+/**
+ * @brief Carga útil de BINLOG_THROTTLE (ts_ns es el inicio del episodio)
+ */
+typedef struct {
+    uint16_t cpu;            // Núcleo
+    uint16_t reserved;
+    int32_t peak_milli;      // Temperatura máxima durante el episodio
+    uint64_t dur_ns;         // Duración del episodio
+    uint64_t lost_cycles;    // Ciclos perdidos estimados
+} binlog_throttle;
+
+/**
+ * @brief Carga útil de BINLOG_POWER_ZONE
+ */
+typedef struct {
+    int32_t id;        // Índice de la zona en las muestras BINLOG_POWER
+    uint32_t kind;     // power_kind
+    char name[48];     // Nombre de la zona ("package-0/core")
+} binlog_power_zone;
+
+/**
+ * @brief Carga útil de BINLOG_POWER (misma marca de tiempo que la muestra)
+ */
+typedef struct {
+    int32_t id;           // Índice de la zona
+    uint32_t milliwatts;  // Potencia media del intervalo
+} binlog_power;
+
+/**
+ * @brief Carga útil de BINLOG_PSI (misma marca de tiempo que la muestra)
+ */
+typedef struct {
+    uint32_t resource;       // psi_resource
+    uint32_t some_avg10;     // avg10 "some" (x100)
+    uint32_t full_avg10;     // avg10 "full" (x100)
+    uint32_t reserved;
+    uint64_t some_us;        // Espera "some" en el intervalo
+    uint64_t full_us;        // Espera "full" en el intervalo
+} binlog_psi;
+
+/**
+ * @brief Carga útil de BINLOG_PMU (misma marca de tiempo que la muestra)
+ */
+typedef struct {
+    uint16_t cpu;            // Número de CPU
+    uint16_t hardware;       // 1 (0 en logs antiguos con solo task-clock: sin IPC ni GHz)
+    uint16_t ipc_milli;      // Instrucciones por ciclo (x1000)
+    uint16_t eff_mhz;        // Ciclos por tiempo ocupado, en MHz
+    uint32_t busy_pm;        // Utilización (/proc/stat) usada como tiempo ocupado (por mil)
+    uint32_t reserved;
+} binlog_pmu;
+
+/**
+ * @brief Carga útil de BINLOG_TOPO (misma marca de tiempo que la muestra)
+ */
+typedef struct {
+    uint16_t level;          // topo_level
+    uint16_t id;             // Identificador de sysfs de la unidad
+    int32_t temp_milli;      // Temperatura máxima de sus CPUs en miligrados
+    uint16_t util_pm;        // Utilización media (por mil)
+    uint16_t freq_mhz;       // Frecuencia media en MHz
+    uint32_t throttle;       // Eventos de throttling en el intervalo
+} binlog_topo;
+
+/**
+ * @brief Carga útil de BINLOG_STRESS (misma marca de tiempo que la muestra)
+ */
+typedef struct {
+    char kernel[16];         // Núcleo de carga ("fma")
+    char unit[16];           // Unidad de trabajo ("flop")
+    uint32_t threads;        // Hilos de trabajo
+    int32_t pid;             // PID de cpu_stressor
+    uint64_t ops_per_s;      // Trabajo por segundo
+} binlog_stress;
+
+/**
+ * @brief Carga útil de BINLOG_CHUNK_INFO (tras BINLOG_START de cpu_stressor)
+ */
+typedef struct {
+    char kernel[16];         // Núcleo de carga ("fma")
+    uint32_t threads;        // Hilos de trabajo
+    uint32_t window_us;      // Duración de las ventanas de BINLOG_CHUNK
+} binlog_chunk_info;
+
+/**
+ * @brief Carga útil de BINLOG_CHUNK (ts_ns es el final de la ventana)
+ */
+typedef struct {
+    uint16_t thread;         // Número de hilo
+    uint16_t cpu;            // CPU a la que está fijado
+    uint32_t count;          // Bloques terminados en la ventana
+    uint32_t min_ns;         // Bloque más rápido
+    uint32_t mean_ns;        // Media
+    uint32_t max_ns;         // Bloque más lento
+    uint32_t reserved;
+} binlog_chunk;
+
+/**
+ * @brief Carga útil de BINLOG_CHUNK_SUMMARY (al terminar la prueba)
+ */
+typedef struct {
+    uint16_t thread;         // Número de hilo
+    uint16_t cpu;            // CPU a la que está fijado
+    uint32_t reserved;
+    uint64_t count;          // Bloques medidos
+    uint64_t p50_ns, p99_ns, p999_ns, max_ns;
+} binlog_chunk_summary;
+
+/**
+ * @brief Escritor de log binario con buffer por ciclo
+ */
+typedef struct {
+    int fd;                          // Archivo abierto en modo O_APPEND (-1 = desactivado)
+    size_t len;                      // Bytes pendientes en buf
+    unsigned char buf[BINLOG_BUF_SIZE];
+} binlog_writer;
+
+/**
+ * @brief Registro leído por binlog_read()
+ */
+typedef struct {
+    binlog_header hdr;
+    unsigned char payload[BINLOG_MAX_PAYLOAD];
+} binlog_record;
+
+/**
+ * @brief Abre (o crea) un log binario en modo anexado
+ * @description Escribe un registro BINLOG_START con el ancla entre
+ *              CLOCK_MONOTONIC y CLOCK_REALTIME.
+ *
+ * @return int 0 si éxito, -1 si error (el escritor queda desactivado)
+ */
+int binlog_open(binlog_writer *w, const char *path);
+
+/**
+ * @brief Añade un registro al buffer del escritor
+ * @description Si el buffer no tiene espacio se vacía primero. No hace
+ *              syscalls en el caso habitual.
+ */
+void binlog_append(binlog_writer *w, binlog_type type, uint64_t ts_ns,
+                   const void *payload, uint16_t size);
+
+/**
+ * @brief Escribe los registros pendientes con una sola write()
+ * @description Si el lote no se puede escribir completo se descarta y el
+ *              archivo vuelve a terminar en un límite de registro.
+ *
+ * @return int 0 si éxito, -1 si error (lote descartado)
+ */
+int binlog_flush(binlog_writer *w);
+
+/**
+ * @brief Vacía y cierra el log binario
+ */
+void binlog_close(binlog_writer *w);
+
+/**
+ * @brief Lee el siguiente registro de un log binario
+ * @description Las cargas útiles mayores que BINLOG_MAX_PAYLOAD se saltan
+ *              (se devuelven truncadas con hdr.size intacto).
+ *
+ * @return int 1 si se leyó un registro, 0 al final del archivo, -1 si el
+ *             archivo está truncado o corrupto
+ */
+int binlog_read(FILE *in, binlog_record *rec);
+
+#endif // BINLOG_H - Fin de las guardas de inclusión
@@ -0,0 +1,347 @@
+/**
+ * @brief Módulo de consumo de CPU por cgroup (v2)
+ * @description Implementa el recorrido del subárbol de cgroups con openat()
+ *              relativo a descriptores de directorio abiertos, la lectura de
+ *              cpu.stat con pread() y un parser manual de sus líneas
+ *              "clave valor".
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdio.h>        // Para snprintf()
+#include <stdlib.h>       // Para malloc(), free()
+#include <string.h>       // Para strcmp(), memcpy(), memset()
+#include <unistd.h>       // Para pread(), close(), dup(), sysconf()
+#include <fcntl.h>        // Para open(), openat() y constantes O_*
+#include <errno.h>        // Para errno, ETIMEDOUT
+#include <dirent.h>       // Para fdopendir(), readdir()
+#include <sys/stat.h>     // Para fstat(), fstatat()
+#include "cgroup_stat.h"  // Header con declaraciones del módulo
+
+/**
+ * @brief Tiempo monótono actual en nanosegundos
+ */
+static uint64_t mono_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Busca un grupo por nombre en un arreglo de entradas
+ * @return int Índice o -1 si no existe
+ */
+static int find_entry(const cgroup_entry *cg, int count, const char *name) {
+    for (int i = 0; i < count; i++) {
+        if (cg[i].dir_fd >= 0 && strcmp(cg[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Indica si el descriptor viejo sigue siendo el directorio actual
+ * @description Un grupo eliminado y creado de nuevo con la misma ruta entre
+ *              dos recorridos (reinicio de un servicio de systemd) tiene
+ *              otro inodo: los descriptores viejos apuntan al grupo muerto y
+ *              su cpu.stat falla con ENODEV.
+ */
+static int same_dir(int old_fd, int parent_fd, const char *dirname) {
+    struct stat o, n;
+    if (fstat(old_fd, &o) < 0 || fstatat(parent_fd, dirname, &n, 0) < 0) {
+        return 0;
+    }
+    return o.st_dev == n.st_dev && o.st_ino == n.st_ino;
+}
+
+/**
+ * @brief Añade un grupo a la lista nueva, reutilizando el de la lista vieja
+ * @description Si el grupo ya se muestreaba y su directorio es el mismo, se
+ *              trasladan sus descriptores y contadores (la entrada vieja
+ *              queda con dir_fd = -1). Si es nuevo o se volvió a crear, se
+ *              abren sus descriptores; los viejos se cierran con el resto de
+ *              la lista vieja.
+ *
+ * @return int Descriptor del directorio del grupo, o -1 si no se añadió
+ */
+static int add_group(cgroup_set *s, cgroup_entry *next, int *count, int parent,
+                     int parent_fd, const char *dirname, const char *name) {
+    if (*count >= CGROUP_MAX) {
+        return -1;
+    }
+
+    int old = find_entry(s->cg, s->count, name);
+    cgroup_entry *e = &next[*count];
+
+    if (old >= 0 && same_dir(s->cg[old].dir_fd, parent_fd, dirname)) {
+        *e = s->cg[old];
+        s->cg[old].dir_fd = -1;
+        s->cg[old].stat_fd = -1;
+    } else {
+        memset(e, 0, sizeof(*e));
+        snprintf(e->name, sizeof(e->name), "%s", name);
+        e->dir_fd = openat(parent_fd, dirname, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (e->dir_fd < 0) {
+            return -1;
+        }
+        e->stat_fd = openat(e->dir_fd, "cpu.stat", O_RDONLY | O_CLOEXEC);
+        if (e->stat_fd < 0) {
+            close(e->dir_fd);
+            return -1;
+        }
+    }
+    e->parent = parent;
+    (*count)++;
+    return e->dir_fd;
+}
+
+/**
+ * @brief Recorre recursivamente los subdirectorios del grupo next[parent]
+ */
+static void walk(cgroup_set *s, cgroup_entry *next, int *count, int parent,
+                 int dir_fd, const char *prefix, unsigned depth_left) {
+    if (depth_left == 0) {
+        return;
+    }
+
+    DIR *d = fdopendir(dup(dir_fd));
+    if (!d) {
+        return;
+    }
+    // dup() comparte la posición con dir_fd, que un recorrido anterior dejó
+    // al final del directorio
+    rewinddir(d);
+
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL && *count < CGROUP_MAX) {
+        if (de->d_type != DT_DIR || de->d_name[0] == '.') {
+            continue;
+        }
+
+        char name[CGROUP_NAME_LEN];
+        int len = strcmp(prefix, ".") == 0
+                  ? snprintf(name, sizeof(name), "%s", de->d_name)
+                  : snprintf(name, sizeof(name), "%s/%s", prefix, de->d_name);
+        if (len >= (int)sizeof(name)) {
+            // Un nombre truncado podría coincidir con el de otro grupo
+            continue;
+        }
+
+        int child = add_group(s, next, count, parent, dir_fd, de->d_name, name);
+        if (child >= 0) {
+            walk(s, next, count, *count - 1, child, name, depth_left - 1);
+        }
+    }
+    closedir(d);
+}
+
+/**
+ * @brief Reconstruye la lista de grupos recorriendo el subárbol
+ * @return int Número de grupos, -1 si la raíz no es accesible
+ */
+static int rewalk(cgroup_set *s) {
+    cgroup_entry *next = malloc(sizeof(cgroup_entry) * CGROUP_MAX);
+    int count = 0;
+
+    if (!next) {
+        return -1;
+    }
+
+    // La raíz se abre por ruta absoluta ("." como nombre)
+    int root_fd = add_group(s, next, &count, -1, AT_FDCWD, s->root, ".");
+    if (root_fd >= 0) {
+        walk(s, next, &count, 0, root_fd, ".", s->depth);
+    }
+
+    // Cerrar los grupos que ya no existen (los trasladados tienen fd = -1)
+    cgroup_set_close(s);
+    memcpy(s->cg, next, sizeof(cgroup_entry) * (size_t)count);
+    s->count = count;
+    s->last_walk = time(NULL);
+    free(next);
+
+    return root_fd >= 0 ? count : -1;
+}
+
+/**
+ * @brief Recorre el subárbol y abre los descriptores de cada grupo
+ */
+int cgroup_set_open(cgroup_set *s, const char *root, unsigned depth) {
+    memset(s, 0, sizeof(*s));
+    snprintf(s->root, sizeof(s->root), "%s", root);
+    s->depth = depth;
+    s->ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (root[0] == '\0') {
+        return -1;
+    }
+    return rewalk(s);
+}
+
+/**
+ * @brief Extrae usage_usec, nr_throttled y throttled_usec de cpu.stat
+ * @description Formato: una línea "clave valor" por contador. Las claves de
+ *              throttling solo existen si el controlador cpu está activo.
+ */
+static void parse_cpu_stat(const char *buf, size_t len, uint64_t *usage,
+                           uint64_t *nr_throttled, uint64_t *throttled) {
+    const char *p = buf;
+    const char *end = buf + len;
+
+    *usage = *nr_throttled = *throttled = 0;
+    while (p < end) {
+        const char *key = p;
+        while (p < end && *p != ' ') {
+            p++;
+        }
+        size_t key_len = (size_t)(p - key);
+        p++;
+
+        uint64_t v = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            v = v * 10 + (uint64_t)(*p++ - '0');
+        }
+        while (p < end && *p++ != '\n') {
+        }
+
+        if (key_len == 10 && memcmp(key, "usage_usec", 10) == 0) {
+            *usage = v;
+        } else if (key_len == 12 && memcmp(key, "nr_throttled", 12) == 0) {
+            *nr_throttled = v;
+        } else if (key_len == 14 && memcmp(key, "throttled_usec", 14) == 0) {
+            *throttled = v;
+        }
+    }
+}
+
+/**
+ * @brief Muestrea cpu.stat de todos los grupos y calcula los deltas
+ */
+int cgroup_set_sample(cgroup_set *s, const acquire *a) {
+    int changed = 0;
+    int vanished = 0;
+    char buf[CGROUP_STAT_READ_LEN + 1];
+
+    if (s->root[0] == '\0') {
+        return -1;
+    }
+
+    if (time(NULL) - s->last_walk >= CGROUP_REWALK_S) {
+        rewalk(s);
+        changed = 1;
+        // Un descriptor nuevo puede reutilizar el número de uno cerrado
+        // que el lote aún tiene registrado
+        a = NULL;
+    }
+
+    for (int i = 0; i < s->count; i++) {
+        cgroup_entry *e = &s->cg[i];
+        ssize_t n = acquire_pread(a, e->stat_fd, buf, CGROUP_STAT_READ_LEN);
+        if (n <= 0) {
+            // El grupo fue eliminado (ENODEV): re-recorrer en la próxima
+            // muestra. Una lectura atascada (ETIMEDOUT) no indica que lo fuera
+            int timed_out = n < 0 && errno == ETIMEDOUT;
+            e->d_usage_usec = e->d_nr_throttled = e->d_throttled_usec = 0;
+            vanished |= !timed_out;
+            continue;
+        }
+
+        uint64_t usage, nr_throttled, throttled;
+        parse_cpu_stat(buf, (size_t)n, &usage, &nr_throttled, &throttled);
+        if (e->primed) {
+            e->d_usage_usec = usage - e->usage_usec;
+            e->d_nr_throttled = nr_throttled - e->nr_throttled;
+            e->d_throttled_usec = throttled - e->throttled_usec;
+        }
+        e->usage_usec = usage;
+        e->nr_throttled = nr_throttled;
+        e->throttled_usec = throttled;
+        e->primed = 1;
+    }
+
+    // Consumo propio: usage_usec incluye el de los descendientes. Los hijos
+    // se leen después que el padre, así que la resta se satura en cero
+    for (int i = 0; i < s->count; i++) {
+        s->cg[i].d_self_usec = s->cg[i].d_usage_usec;
+    }
+    for (int i = 0; i < s->count; i++) {
+        cgroup_entry *p = s->cg[i].parent >= 0 ? &s->cg[s->cg[i].parent] : NULL;
+        if (p) {
+            uint64_t d = s->cg[i].d_usage_usec;
+            p->d_self_usec = p->d_self_usec > d ? p->d_self_usec - d : 0;
+        }
+    }
+
+    uint64_t now = mono_ns();
+    s->elapsed_s = s->last_ns ? (double)(now - s->last_ns) / 1e9 : 0.0;
+    s->last_ns = now;
+
+    if (vanished) {
+        // Forzar el re-recorrido en la siguiente muestra
+        s->last_walk = 0;
+    }
+    return changed;
+}
+
+/**
+ * @brief Porcentaje de la capacidad total del host usado por un grupo
+ */
+double cgroup_host_share(const cgroup_set *s, int idx) {
+    if (s->elapsed_s <= 0.0 || s->ncpus <= 0) {
+        return 0.0;
+    }
+    return 100.0 * (double)s->cg[idx].d_usage_usec / (s->elapsed_s * 1e6 * (double)s->ncpus);
+}
+
+/**
+ * @brief Porcentaje de la capacidad del host usado por un grupo sin sus hijos
+ */
+double cgroup_self_share(const cgroup_set *s, int idx) {
+    if (s->elapsed_s <= 0.0 || s->ncpus <= 0) {
+        return 0.0;
+    }
+    return 100.0 * (double)s->cg[idx].d_self_usec / (s->elapsed_s * 1e6 * (double)s->ncpus);
+}
+
+/**
+ * @brief Índices de los @p n grupos con mayor consumo propio en el último intervalo
+ * @description Con el consumo propio cada microsegundo cuenta en un solo
+ *              grupo, así que la raíz (".") compite como uno más: solo
+ *              conserva lo que no se atribuyó a ningún subgrupo muestreado.
+ */
+int cgroup_set_top(const cgroup_set *s, int *out, int n) {
+    int count = 0;
+
+    for (int i = 0; i < s->count; i++) {
+        if (s->cg[i].d_self_usec == 0) {
+            continue;
+        }
+        if (count == n && s->cg[i].d_self_usec <= s->cg[out[count - 1]].d_self_usec) {
+            continue;
+        }
+
+        int pos = count < n ? count++ : n - 1;
+        while (pos > 0 && s->cg[out[pos - 1]].d_self_usec < s->cg[i].d_self_usec) {
+            out[pos] = out[pos - 1];
+            pos--;
+        }
+        out[pos] = i;
+    }
+    return count;
+}
+
+/**
+ * @brief Cierra todos los descriptores del conjunto
+ */
+void cgroup_set_close(cgroup_set *s) {
+    for (int i = 0; i < s->count; i++) {
+        if (s->cg[i].stat_fd >= 0) {
+            close(s->cg[i].stat_fd);
+        }
+        if (s->cg[i].dir_fd >= 0) {
+            close(s->cg[i].dir_fd);
+        }
+        s->cg[i].stat_fd = s->cg[i].dir_fd = -1;
+    }
+    s->count = 0;
+}
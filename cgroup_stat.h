@@ -0,0 +1,119 @@
+/**
+ * @brief Header del módulo de consumo de CPU por cgroup (v2)
+ * @description Define la interfaz para recorrer un subárbol de cgroup v2 y
+ *              muestrear el cpu.stat de cada grupo en cada ciclo del daemon.
+ *              Los descriptores del directorio y de cpu.stat de cada grupo se
+ *              mantienen abiertos, así una muestra cuesta una pread() por
+ *              grupo. Los deltas entre muestras indican qué servicio consumía
+ *              CPU (o estaba siendo limitado) en el momento de cada lectura
+ *              de temperatura.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef CGROUP_STAT_H  // Si CGROUP_STAT_H no está definido
+#define CGROUP_STAT_H  // Definir CGROUP_STAT_H como macro de protección
+
+#include <stdint.h>  // Para uint64_t
+#include <time.h>    // Para time_t
+#include <limits.h>  // Para PATH_MAX
+#include "acquire.h" // Para acquire (lecturas servidas por el lote del ciclo)
+
+// Número máximo de cgroups muestreados
+#define CGROUP_MAX 256
+
+// Longitud máxima del nombre (ruta relativa a la raíz configurada)
+#define CGROUP_NAME_LEN 128
+
+// Periodo de re-recorrido del subárbol para detectar grupos nuevos
+#define CGROUP_REWALK_S 60
+
+// Bytes leídos de cada cpu.stat
+#define CGROUP_STAT_READ_LEN 511
+
+/**
+ * @brief Estado de un cgroup muestreado
+ */
+typedef struct {
+    char name[CGROUP_NAME_LEN];   // Ruta relativa ("." = la raíz configurada)
+    int dir_fd;                   // Descriptor del directorio del grupo
+    int stat_fd;                  // Descriptor de cpu.stat
+    uint64_t usage_usec;          // Contadores acumulados de la última muestra
+    uint64_t nr_throttled;
+    uint64_t throttled_usec;
+    uint64_t d_usage_usec;        // Deltas entre las dos últimas muestras
+    uint64_t d_nr_throttled;
+    uint64_t d_throttled_usec;
+    uint64_t d_self_usec;         // d_usage_usec menos el de los hijos muestreados
+    int parent;                   // Índice del grupo padre en cg[] (-1 = raíz)
+    int primed;                   // 1 si ya hay una muestra previa para deltas
+} cgroup_entry;
+
+/**
+ * @brief Conjunto de cgroups de un subárbol
+ */
+typedef struct {
+    char root[PATH_MAX];          // Raíz del subárbol ("" = desactivado)
+    unsigned depth;               // Profundidad máxima del recorrido
+    int count;                    // Grupos válidos en cg[]
+    cgroup_entry cg[CGROUP_MAX];
+    uint64_t last_ns;             // Instante de la última muestra (CLOCK_MONOTONIC)
+    double elapsed_s;             // Segundos entre las dos últimas muestras
+    long ncpus;                   // CPUs en línea, para la cuota del host
+    time_t last_walk;             // Último recorrido del subárbol
+} cgroup_set;
+
+/**
+ * @brief Recorre el subárbol y abre los descriptores de cada grupo
+ *
+ * @param s     Conjunto a inicializar
+ * @param root  Directorio raíz del subárbol de cgroup v2
+ * @param depth Profundidad máxima (0 = solo la raíz, 1 = hijos directos...)
+ *
+ * @return int Número de grupos, -1 si la raíz no es accesible
+ */
+int cgroup_set_open(cgroup_set *s, const char *root, unsigned depth);
+
+/**
+ * @brief Muestrea cpu.stat de todos los grupos y calcula los deltas
+ * @description Cada CGROUP_REWALK_S segundos, o si un grupo desapareció,
+ *              vuelve a recorrer el subárbol conservando los contadores de
+ *              los grupos que siguen existiendo. Tras un re-recorrido los
+ *              descriptores pueden ser nuevos y no se usa el lote.
+ *
+ * @param s Conjunto de grupos
+ * @param a Lote del ciclo (NULL = pread() directa)
+ *
+ * @return int 1 si el conjunto de grupos cambió (nombres nuevos), 0 si no,
+ *             -1 si el conjunto está desactivado
+ */
+int cgroup_set_sample(cgroup_set *s, const acquire *a);
+
+/**
+ * @brief Porcentaje de la capacidad total del host usado por un grupo
+ */
+double cgroup_host_share(const cgroup_set *s, int idx);
+
+/**
+ * @brief Porcentaje de la capacidad del host usado por un grupo sin sus hijos
+ * @description Igual que cgroup_host_share() pero sobre d_self_usec: el
+ *              consumo de los subgrupos muestreados se atribuye a ellos.
+ */
+double cgroup_self_share(const cgroup_set *s, int idx);
+
+/**
+ * @brief Índices de los @p n grupos con mayor consumo propio en el último intervalo
+ * @description Se ordena por d_self_usec: el usage_usec de un grupo incluye
+ *              el de sus descendientes, así que ordenar por él repetiría el
+ *              mismo consumo en cada antepasado.
+ *
+ * @return int Número de índices escritos en @p out
+ */
+int cgroup_set_top(const cgroup_set *s, int *out, int n);
+
+/**
+ * @brief Cierra todos los descriptores del conjunto
+ */
+void cgroup_set_close(cgroup_set *s);
+
+#endif // CGROUP_STAT_H - Fin de las guardas de inclusión
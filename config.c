@@ -0,0 +1,198 @@
+/**
+ * @brief Módulo de configuración del daemon
+ * @description Implementa la carga de la configuración desde un archivo de
+ *              texto con formato "clave = valor". Las claves se describen en
+ *              una tabla (nombre, tipo, desplazamiento dentro de la
+ *              estructura), de modo que añadir un parámetro nuevo solo
+ *              requiere una entrada más en la tabla.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdio.h>      // Para FILE, fopen(), fgets()
+#include <stdlib.h>     // Para strtoul(), strtof()
+#include <string.h>     // Para strcmp(), strlen(), strchr()
+#include <stddef.h>     // Para offsetof()
+#include <ctype.h>      // Para isspace()
+#include <errno.h>      // Para errno, ENOENT
+#include "config.h"     // Header con declaraciones del módulo de configuración
+
+// Tipos de valor admitidos en el archivo de configuración
+typedef enum {
+    CFG_UINT,   // Entero sin signo
+    CFG_FLOAT,  // Número en punto flotante
+    CFG_PATH    // Ruta (cadena de hasta PATH_MAX caracteres)
+} config_type;
+
+// Entrada de la tabla de claves: nombre, tipo y posición en daemon_config
+typedef struct {
+    const char *key;
+    config_type type;
+    size_t offset;
+} config_key;
+
+// Tabla de claves reconocidas en el archivo de configuración
+static const config_key config_keys[] = {
+    {"interval_ms",         CFG_UINT,  offsetof(daemon_config, interval_ms)},
+    {"temp_threshold",      CFG_FLOAT, offsetof(daemon_config, temp_threshold)},
+    {"shutdown_deadline_s", CFG_UINT,  offsetof(daemon_config, shutdown_deadline_s)},
+    {"snapshot_interval_s", CFG_UINT,  offsetof(daemon_config, snapshot_interval_s)},
+    {"top_n",               CFG_UINT,  offsetof(daemon_config, top_n)},
+    {"cgroup_depth",        CFG_UINT,  offsetof(daemon_config, cgroup_depth)},
+    {"perf_counters",       CFG_UINT,  offsetof(daemon_config, perf_counters)},
+    {"acquire_uring",       CFG_UINT,  offsetof(daemon_config, acquire_uring)},
+    {"acquire_timeout_ms",  CFG_UINT,  offsetof(daemon_config, acquire_timeout_ms)},
+    {"log_path",            CFG_PATH,  offsetof(daemon_config, log_path)},
+    {"snapshot_path",       CFG_PATH,  offsetof(daemon_config, snapshot_path)},
+    {"sysfs_root",          CFG_PATH,  offsetof(daemon_config, sysfs_root)},
+    {"status_path",         CFG_PATH,  offsetof(daemon_config, status_path)},
+    {"binlog_path",         CFG_PATH,  offsetof(daemon_config, binlog_path)},
+    {"cgroup_root",         CFG_PATH,  offsetof(daemon_config, cgroup_root)},
+    {"stress_shm",          CFG_PATH,  offsetof(daemon_config, stress_shm)},
+};
+
+/**
+ * @brief Inicializa la configuración con los valores por defecto
+ * @description Reproduce las constantes originales de main.c (INTERVAL = 5 s,
+ *              TEMP_THRESHOLD = 65.0) y la ruta de log histórica.
+ */
+void config_defaults(daemon_config *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->interval_ms = 5000;
+    cfg->temp_threshold = 65.0f;
+    cfg->shutdown_deadline_s = 3;
+    cfg->snapshot_interval_s = 60;
+    cfg->top_n = 5;
+    cfg->cgroup_depth = 2;
+    cfg->acquire_uring = 1;
+    cfg->acquire_timeout_ms = 200;
+    snprintf(cfg->log_path, sizeof(cfg->log_path), "%s",
+             "/home/henry/CLionProjects/cpu_daemon/logs/cpu_temp_log.txt");
+    snprintf(cfg->snapshot_path, sizeof(cfg->snapshot_path), "%s",
+             "/home/henry/CLionProjects/cpu_daemon/logs/cpu_daemon.snap");
+    snprintf(cfg->sysfs_root, sizeof(cfg->sysfs_root), "%s", "/sys");
+    snprintf(cfg->status_path, sizeof(cfg->status_path), "%s",
+             "/home/henry/CLionProjects/cpu_daemon/logs/cpu_daemon.status");
+}
+
+/**
+ * @brief Elimina espacios en blanco al inicio y al final de una cadena
+ * @return char* Puntero al primer carácter no blanco (la cadena se modifica)
+ */
+static char *trim(char *s) {
+    while (isspace((unsigned char)*s)) {
+        s++;
+    }
+    size_t len = strlen(s);
+    while (len > 0 && isspace((unsigned char)s[len - 1])) {
+        s[--len] = '\0';
+    }
+    return s;
+}
+
+/**
+ * @brief Aplica un par clave/valor a la configuración
+ * @return int 0 si la clave existe y el valor es válido, -1 en caso contrario
+ */
+static int apply_key(daemon_config *cfg, const char *key, const char *value) {
+    for (size_t i = 0; i < sizeof(config_keys) / sizeof(config_keys[0]); i++) {
+        const config_key *k = &config_keys[i];
+        if (strcmp(k->key, key) != 0) {
+            continue;
+        }
+
+        char *field = (char *)cfg + k->offset;
+        char *end = NULL;
+        errno = 0;
+
+        switch (k->type) {
+            case CFG_UINT: {
+                unsigned long v = strtoul(value, &end, 10);
+                if (errno || end == value || *end != '\0' || v > 0xFFFFFFFFUL) {
+                    return -1;
+                }
+                *(unsigned *)field = (unsigned)v;
+                return 0;
+            }
+            case CFG_FLOAT: {
+                float v = strtof(value, &end);
+                if (errno || end == value || *end != '\0') {
+                    return -1;
+                }
+                *(float *)field = v;
+                return 0;
+            }
+            case CFG_PATH:
+                // Solo se aceptan rutas absolutas (el daemon hace chdir("/"))
+                // o vacías, que desactivan la función asociada
+                if ((value[0] != '/' && value[0] != '\0') || strlen(value) >= PATH_MAX) {
+                    return -1;
+                }
+                memcpy(field, value, strlen(value) + 1);
+                return 0;
+        }
+    }
+
+    // Clave desconocida: se rechaza para detectar errores tipográficos
+    return -1;
+}
+
+/**
+ * @brief Carga la configuración desde un archivo "clave = valor"
+ * @description Trabaja sobre una copia local inicializada con los valores
+ *              por defecto y solo la copia a cfg si todo el archivo es
+ *              válido. Un archivo inexistente no es un error.
+ */
+int config_load(const char *path, daemon_config *cfg) {
+    daemon_config tmp;
+    config_defaults(&tmp);
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        if (errno == ENOENT) {
+            // Sin archivo de configuración: valores por defecto
+            *cfg = tmp;
+            return 0;
+        }
+        return -1;
+    }
+
+    char line[PATH_MAX + 64];
+    int rc = 0;
+
+    while (fgets(line, sizeof(line), fp)) {
+        char *s = trim(line);
+
+        // Ignorar líneas vacías y comentarios
+        if (*s == '\0' || *s == '#') {
+            continue;
+        }
+
+        char *eq = strchr(s, '=');
+        if (!eq) {
+            rc = -1;
+            break;
+        }
+        *eq = '\0';
+
+        if (apply_key(&tmp, trim(s), trim(eq + 1)) < 0) {
+            rc = -1;
+            break;
+        }
+    }
+
+    if (ferror(fp)) {
+        rc = -1;
+    }
+    fclose(fp);
+
+    // Validaciones que involucran más de una clave o rangos mínimos. Un
+    // plazo de apagado de 0 sería alarm(0): apagado sin plazo
+    if (rc == 0 && (tmp.interval_ms == 0 || tmp.shutdown_deadline_s == 0 || tmp.top_n > 16 || tmp.perf_counters > 1 || tmp.acquire_uring > 1 || tmp.log_path[0] == '\0' || tmp.sysfs_root[0] == '\0')) {
+        rc = -1;
+    }
+
+    if (rc == 0) {
+        *cfg = tmp;
+    }
+    return rc;
+}
@@ -0,0 +1,69 @@
+/**
+ * @brief Header del módulo de configuración del daemon
+ * @description Define la estructura de configuración en tiempo de ejecución
+ *              del daemon de monitoreo y las funciones para inicializarla con
+ *              valores por defecto y cargarla desde un archivo de texto.
+ *              La configuración puede recargarse en caliente con SIGHUP.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef CONFIG_H  // Si CONFIG_H no está definido
+#define CONFIG_H  // Definir CONFIG_H como macro de protección
+
+#include <limits.h>  // Para PATH_MAX
+
+// Ruta por defecto del archivo de configuración (se puede cambiar con -c)
+#define CONFIG_DEFAULT_PATH "/etc/cpu_daemon.conf"
+
+/**
+ * @brief Configuración en tiempo de ejecución del daemon
+ * @description Todos los parámetros que antes eran constantes de compilación
+ *              en main.c. Es una estructura plana (sin punteros) para que se
+ *              pueda copiar por valor al recargar la configuración.
+ */
+typedef struct {
+    unsigned interval_ms;         // Intervalo de muestreo en milisegundos
+    float temp_threshold;         // Umbral de temperatura crítica en °C
+    unsigned shutdown_deadline_s; // Tiempo máximo para el apagado ordenado (>= 1)
+    unsigned snapshot_interval_s; // Periodo de guardado de la instantánea
+    unsigned top_n;               // Procesos a atribuir en cada alerta (0 = desactivado)
+    unsigned cgroup_depth;        // Profundidad del recorrido bajo cgroup_root
+    unsigned perf_counters;       // 1 = grupos perf_event por CPU (IPC y frecuencia efectiva)
+    unsigned acquire_uring;       // 1 = lote de lecturas con io_uring, 0 = bucle de preadv()
+    unsigned acquire_timeout_ms;  // Plazo del lote de lecturas (0 = sin plazo)
+    char log_path[PATH_MAX];      // Ruta absoluta del archivo de log
+    char snapshot_path[PATH_MAX]; // Instantánea de reinicio en caliente ("" = desactivada)
+    char sysfs_root[PATH_MAX];    // Raíz de sysfs (un árbol falso para pruebas)
+    char status_path[PATH_MAX];   // Informe de estado escrito con SIGUSR1 ("" = desactivado)
+    char binlog_path[PATH_MAX];   // Log binario para cpu_trace_export ("" = desactivado)
+    char cgroup_root[PATH_MAX];   // Subárbol de cgroup v2 a muestrear ("" = desactivado)
+    char stress_shm[PATH_MAX];    // Contadores de cpu_stressor -s ("" = desactivado)
+} daemon_config;
+
+/**
+ * @brief Inicializa la configuración con los valores por defecto
+ * @description Los valores por defecto reproducen el comportamiento original
+ *              del daemon: muestreo cada 5 s y umbral de 65 °C.
+ *
+ * @param cfg Estructura a inicializar
+ */
+void config_defaults(daemon_config *cfg);
+
+/**
+ * @brief Carga la configuración desde un archivo "clave = valor"
+ * @description Parte de los valores por defecto y aplica cada línea del
+ *              archivo. Las líneas vacías y las que empiezan con '#' se
+ *              ignoran. Si el archivo no existe se usan los valores por
+ *              defecto. Si hay cualquier error, cfg NO se modifica, de modo
+ *              que una recarga fallida deja intacta la configuración activa.
+ *
+ * @param path Ruta del archivo de configuración
+ * @param cfg  Estructura destino
+ *
+ * @return int 0 si la configuración se cargó, -1 si hubo un error de
+ *             lectura, una clave desconocida o un valor inválido
+ */
+int config_load(const char *path, daemon_config *cfg);
+
+#endif // CONFIG_H - Fin de las guardas de inclusión
@@ -0,0 +1,252 @@
+/**
+ * @brief Módulo de contadores de rendimiento por CPU
+ * @description Implementa la apertura de los archivos de /proc y sysfs de
+ *              cada CPU, su lectura con pread() y parsers manuales de las
+ *              líneas "cpuN" de /proc/stat y de los valores enteros de sysfs.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdio.h>         // Para snprintf()
+#include <stdlib.h>        // Para malloc(), calloc(), free()
+#include <string.h>        // Para memset(), memchr()
+#include <unistd.h>        // Para pread(), close(), sysconf()
+#include <fcntl.h>         // Para open() y constantes O_*
+#include <limits.h>        // Para PATH_MAX
+#include "cpu_counters.h"  // Header con declaraciones del módulo
+
+/**
+ * @brief Abre un atributo de sysfs de una CPU
+ * @return int Descriptor, o -1 si el atributo no existe
+ */
+static int open_cpu_attr(const char *sysfs_root, int cpu, const char *attr) {
+    char path[PATH_MAX];
+
+    snprintf(path, sizeof(path), "%s/devices/system/cpu/cpu%d/%s", sysfs_root, cpu, attr);
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+/**
+ * @brief Lee un entero decimal de un atributo de sysfs abierto
+ * @param v Destino del valor (sin cambios si falla)
+ * @return int 0 si éxito, -1 si el descriptor no es válido, la lectura
+ *             falla o no hay dígitos
+ */
+static int read_u64(const acquire *a, int fd, uint64_t *v) {
+    char buf[CPU_ATTR_READ_LEN];
+    uint64_t x = 0;
+    ssize_t i = 0;
+
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = acquire_pread(a, fd, buf, sizeof(buf));
+    for (; i < n && buf[i] >= '0' && buf[i] <= '9'; i++) {
+        x = x * 10 + (uint64_t)(buf[i] - '0');
+    }
+    if (i == 0) {
+        return -1;
+    }
+    *v = x;
+    return 0;
+}
+
+/**
+ * @brief Reserva los arreglos y abre los descriptores de todas las CPUs
+ */
+int cpu_counters_open(cpu_counters *c, const char *sysfs_root, const char *proc_root) {
+    char path[PATH_MAX];
+
+    memset(c, 0, sizeof(*c));
+    c->stat_fd = -1;
+
+    long ncpu = sysconf(_SC_NPROCESSORS_CONF);
+    if (ncpu <= 0) {
+        return -1;
+    }
+
+    size_t n = (size_t)ncpu;
+    c->stat_len = (n + 1) * CPU_STAT_LINE_LEN;
+    c->stat_buf = malloc(c->stat_len);
+    c->freq_fd = calloc(n, sizeof(int));
+    c->core_thr_fd = calloc(n, sizeof(int));
+    c->pkg_thr_fd = calloc(n, sizeof(int));
+    c->prev_busy = calloc(n, sizeof(uint64_t));
+    c->prev_total = calloc(n, sizeof(uint64_t));
+    c->prev_core_thr = calloc(n, sizeof(uint64_t));
+    c->prev_pkg_thr = calloc(n, sizeof(uint64_t));
+    c->thr_valid = calloc(n, sizeof(uint8_t));
+    c->util_pm = calloc(n, sizeof(uint16_t));
+    c->freq_mhz = calloc(n, sizeof(uint16_t));
+    c->d_core_thr = calloc(n, sizeof(uint32_t));
+    c->d_pkg_thr = calloc(n, sizeof(uint32_t));
+
+    if (!c->stat_buf || !c->freq_fd || !c->core_thr_fd || !c->pkg_thr_fd ||
+        !c->prev_busy || !c->prev_total || !c->prev_core_thr || !c->prev_pkg_thr ||
+        !c->thr_valid || !c->util_pm || !c->freq_mhz || !c->d_core_thr || !c->d_pkg_thr) {
+        cpu_counters_close(c);
+        return -1;
+    }
+
+    // Asignar ncpu solo ahora: cpu_counters_close() no debe cerrar los
+    // descriptores a cero de los arreglos recién reservados
+    c->ncpu = (int)ncpu;
+    for (int i = 0; i < c->ncpu; i++) {
+        c->freq_fd[i] = open_cpu_attr(sysfs_root, i, "cpufreq/scaling_cur_freq");
+        c->core_thr_fd[i] = open_cpu_attr(sysfs_root, i, "thermal_throttle/core_throttle_count");
+        c->pkg_thr_fd[i] = open_cpu_attr(sysfs_root, i, "thermal_throttle/package_throttle_count");
+    }
+
+    snprintf(path, sizeof(path), "%s/stat", proc_root);
+    c->stat_fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (c->stat_fd < 0) {
+        cpu_counters_close(c);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Actualiza la utilización a partir de las líneas "cpuN" de /proc/stat
+ * @description Formato: "cpuN user nice system idle iowait irq softirq
+ *              steal ...". Se consideran ociosos idle e iowait; el resto es
+ *              tiempo ocupado. Solo se procesan líneas completas: la lectura
+ *              se limita a las primeras líneas del archivo, antes de "intr".
+ */
+static void parse_proc_stat(cpu_counters *c, const char *buf, size_t len) {
+    const char *p = buf;
+    const char *end = buf + len;
+
+    while (p + 3 < end && p[0] == 'c' && p[1] == 'p' && p[2] == 'u') {
+        const char *eol = memchr(p, '\n', (size_t)(end - p));
+        if (!eol) {
+            break;
+        }
+        p += 3;
+
+        // La línea agregada "cpu " no lleva número
+        if (*p < '0' || *p > '9') {
+            p = eol + 1;
+            continue;
+        }
+        int cpu = 0;
+        while (*p >= '0' && *p <= '9') {
+            cpu = cpu * 10 + (*p++ - '0');
+        }
+
+        uint64_t total = 0, idle = 0;
+        for (int field = 0; p < eol; field++) {
+            while (p < eol && *p == ' ') {
+                p++;
+            }
+            uint64_t v = 0;
+            while (p < eol && *p >= '0' && *p <= '9') {
+                v = v * 10 + (uint64_t)(*p++ - '0');
+            }
+            // guest y guest_nice (campos 8 y 9) ya están incluidos en user y nice
+            if (field < 8) {
+                total += v;
+            }
+            if (field == 3 || field == 4) {
+                idle += v;
+            }
+        }
+        p = eol + 1;
+
+        if (cpu >= c->ncpu) {
+            continue;
+        }
+        uint64_t busy = total - idle;
+        uint64_t d_total = total - c->prev_total[cpu];
+        uint64_t d_busy = busy - c->prev_busy[cpu];
+        c->util_pm[cpu] = c->primed && d_total > 0 && d_busy <= d_total
+                          ? (uint16_t)(d_busy * 1000 / d_total) : 0;
+        c->prev_total[cpu] = total;
+        c->prev_busy[cpu] = busy;
+    }
+}
+
+/**
+ * @brief Lee un contador de throttling y calcula su delta del intervalo
+ * @description Una lectura fallida no sustituye el valor anterior por 0 (el
+ *              siguiente delta sería el contador entero): el intervalo no
+ *              aporta eventos y el siguiente delta se mide desde la última
+ *              lectura válida, que debe existir.
+ *
+ * @param valid Bits de valores anteriores válidos de la CPU
+ * @param bit   Bit de este contador en valid
+ */
+static void sample_thr(const acquire *a, int fd, uint64_t *prev, uint32_t *delta,
+                       uint8_t *valid, uint8_t bit) {
+    uint64_t v;
+
+    if (read_u64(a, fd, &v) < 0) {
+        *delta = 0;
+        return;
+    }
+    *delta = (*valid & bit) && v >= *prev ? (uint32_t)(v - *prev) : 0;
+    *prev = v;
+    *valid |= bit;
+}
+
+/**
+ * @brief Lee todos los contadores y calcula los valores del intervalo
+ */
+int cpu_counters_sample(cpu_counters *c, const acquire *a) {
+    if (c->ncpu == 0 || c->stat_fd < 0) {
+        return -1;
+    }
+
+    ssize_t n = acquire_pread(a, c->stat_fd, c->stat_buf, c->stat_len);
+    if (n > 0) {
+        parse_proc_stat(c, c->stat_buf, (size_t)n);
+    }
+
+    for (int i = 0; i < c->ncpu; i++) {
+        uint64_t khz = 0;
+        read_u64(a, c->freq_fd[i], &khz);
+        c->freq_mhz[i] = (uint16_t)(khz / 1000);
+
+        sample_thr(a, c->core_thr_fd[i], &c->prev_core_thr[i], &c->d_core_thr[i],
+                   &c->thr_valid[i], 1);
+        sample_thr(a, c->pkg_thr_fd[i], &c->prev_pkg_thr[i], &c->d_pkg_thr[i],
+                   &c->thr_valid[i], 2);
+    }
+    c->primed = 1;
+    return 0;
+}
+
+/**
+ * @brief Cierra un arreglo de descriptores
+ */
+static void close_fds(int *fds, int n) {
+    for (int i = 0; fds && i < n; i++) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+    free(fds);
+}
+
+/**
+ * @brief Cierra los descriptores y libera los arreglos
+ */
+void cpu_counters_close(cpu_counters *c) {
+    if (c->stat_fd >= 0) {
+        close(c->stat_fd);
+    }
+    close_fds(c->freq_fd, c->ncpu);
+    close_fds(c->core_thr_fd, c->ncpu);
+    close_fds(c->pkg_thr_fd, c->ncpu);
+    free(c->stat_buf);
+    free(c->prev_busy);
+    free(c->prev_total);
+    free(c->prev_core_thr);
+    free(c->prev_pkg_thr);
+    free(c->thr_valid);
+    free(c->util_pm);
+    free(c->freq_mhz);
+    free(c->d_core_thr);
+    free(c->d_pkg_thr);
+    memset(c, 0, sizeof(*c));
+    c->stat_fd = -1;
+}
@@ -0,0 +1,81 @@
+/**
+ * @brief Header del módulo de contadores de rendimiento por CPU
+ * @description Define la interfaz para muestrear, en cada ciclo del daemon,
+ *              la utilización de cada CPU (/proc/stat), su frecuencia actual
+ *              (cpufreq/scaling_cur_freq) y los contadores de throttling
+ *              térmico del núcleo y del paquete (thermal_throttle/). Todos
+ *              los archivos se abren una vez y se leen con pread(), así una
+ *              muestra cuesta una syscall por archivo y ninguna apertura.
+ *              Correlacionar estos valores con la temperatura permite medir
+ *              cuánto rendimiento cuesta el throttling.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef CPU_COUNTERS_H  // Si CPU_COUNTERS_H no está definido
+#define CPU_COUNTERS_H  // Definir CPU_COUNTERS_H como macro de protección
+
+#include <stdint.h>  // Para tipos de ancho fijo
+#include <stddef.h>  // Para size_t
+#include "acquire.h" // Para acquire (lecturas servidas por el lote del ciclo)
+
+// Bytes de /proc/stat reservados por CPU (una línea "cpuN" cabe de sobra)
+#define CPU_STAT_LINE_LEN 256
+
+// Bytes leídos de cada atributo numérico de sysfs (frecuencia, throttling)
+#define CPU_ATTR_READ_LEN 32
+
+/**
+ * @brief Contadores de todas las CPUs configuradas
+ * @description Los arreglos tienen ncpu elementos indexados por número de
+ *              CPU. Un descriptor -1 indica que el archivo no existe (CPU
+ *              fuera de línea, sin cpufreq o sin thermal_throttle); su valor
+ *              queda en 0.
+ */
+typedef struct {
+    int ncpu;                 // CPUs configuradas (0 = desactivado)
+    int stat_fd;              // Descriptor de /proc/stat
+    char *stat_buf;           // Buffer de lectura de /proc/stat
+    size_t stat_len;          // Tamaño de stat_buf
+    int *freq_fd;             // cpuN/cpufreq/scaling_cur_freq
+    int *core_thr_fd;         // cpuN/thermal_throttle/core_throttle_count
+    int *pkg_thr_fd;          // cpuN/thermal_throttle/package_throttle_count
+    uint64_t *prev_busy;      // Jiffies ocupados de la muestra anterior
+    uint64_t *prev_total;     // Jiffies totales de la muestra anterior
+    uint64_t *prev_core_thr;  // Contadores acumulados de la muestra anterior
+    uint64_t *prev_pkg_thr;
+    uint8_t *thr_valid;       // Bit 0/1: prev_core_thr/prev_pkg_thr leído con éxito
+    uint16_t *util_pm;        // Utilización del último intervalo (por mil)
+    uint16_t *freq_mhz;       // Frecuencia actual en MHz
+    uint32_t *d_core_thr;     // Eventos de throttling del núcleo en el intervalo
+    uint32_t *d_pkg_thr;      // Eventos de throttling del paquete en el intervalo
+    int primed;               // 1 si ya hay una muestra previa para deltas
+} cpu_counters;
+
+/**
+ * @brief Reserva los arreglos y abre los descriptores de todas las CPUs
+ *
+ * @param c          Contadores a inicializar
+ * @param sysfs_root Raíz de sysfs (devices/system/cpu/cpuN/...)
+ * @param proc_root  Raíz de procfs (stat)
+ *
+ * @return int 0 si éxito, -1 si no hay memoria o /proc/stat no es legible
+ */
+int cpu_counters_open(cpu_counters *c, const char *sysfs_root, const char *proc_root);
+
+/**
+ * @brief Lee todos los contadores y calcula los valores del intervalo
+ *
+ * @param c Contadores
+ * @param a Lote del ciclo (NULL = pread() directa)
+ *
+ * @return int 0 si éxito, -1 si los contadores están desactivados
+ */
+int cpu_counters_sample(cpu_counters *c, const acquire *a);
+
+/**
+ * @brief Cierra los descriptores y libera los arreglos
+ */
+void cpu_counters_close(cpu_counters *c);
+
+#endif // CPU_COUNTERS_H - Fin de las guardas de inclusión
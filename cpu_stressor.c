@@ -2,145 +2,964 @@
  * @brief Programa de prueba de estrés para CPU
  * @description Este programa está diseñado para generar carga intensiva en el CPU
  *              mediante cálculos matemáticos continuos. Su propósito principal es
- *              probar sistemas de monitoreo de temperatura, benchmarking, o 
+ *              probar sistemas de monitoreo de temperatura, benchmarking, o
  *              verificar la estabilidad del sistema bajo carga sostenida.
+ *              Lanza un hilo de trabajo por CPU del conjunto pedido, cada uno
+ *              fijado a su CPU y ejecutando el núcleo de carga elegido
+ *              (stress_kernels.h), y termina de forma ordenada al vencer la
+ *              duración o al recibir SIGINT, SIGTERM o SIGHUP. Cada hilo
+ *              cuenta el trabajo completado; el hilo principal informa del
+ *              rendimiento por intervalo en stdout y, con -s, lo publica en
+ *              memoria compartida para que el daemon lo registre junto a la
+ *              temperatura. La carga sigue un perfil de utilización
+ *              (stress_profile.h) o, con -T, un lazo cerrado que mantiene
+ *              una temperatura de consigna (stress_control.h).
  * @author Sistema de pruebas CPU
  * @warning Este programa causará uso intensivo del CPU y aumento de temperatura
  */
 
-#include <stdio.h>  // Para funciones de entrada/salida estándar
+#define _GNU_SOURCE     // Para sched_setaffinity(), CPU_SET() y sigtimedwait()
+
+#include <stdio.h>      // Para funciones de entrada/salida estándar
+#include <stdlib.h>     // Para strtol(), strtoul()
+#include <string.h>     // Para memset(), strsignal()
+#include <errno.h>      // Para errno, EAGAIN, EINTR
+#include <signal.h>     // Para sigset_t, sigtimedwait()
+#include <time.h>       // Para struct timespec, clock_gettime()
+#include <unistd.h>     // Para getopt(), ftruncate(), getpid()
+#include <fcntl.h>      // Para constantes O_*
+#include <sys/mman.h>   // Para shm_open(), mmap()
+#include "cpu_stressor.h" // Opciones y estado de los hilos
+#include "binlog.h"       // Para binlog_writer (log de latencias)
+
+// Bandera de parada compartida por todos los hilos (acceso atómico)
+static int stop_requested;
+
+// Salida del lazo cerrado: hilos activos (32 bits altos) y ciclo de
+// trabajo en partes por millón (32 bits bajos), en una sola palabra atómica
+static uint64_t control_word;
+
+/**
+ * @brief Indica si el hilo principal pidió la parada
+ */
+static int should_stop(void) {
+    return __atomic_load_n(&stop_requested, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Publica la salida del lazo cerrado para los hilos
+ */
+static void set_control(int active, double duty) {
+    uint64_t word = (uint64_t)active << 32 | (uint32_t)(duty * 1e6 + 0.5);
+    __atomic_store_n(&control_word, word, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Utilización que el lazo cerrado asigna a un hilo
+ */
+static double controlled_level(int index) {
+    uint64_t word = __atomic_load_n(&control_word, __ATOMIC_RELAXED);
+    return index < (int)(word >> 32) ? (uint32_t)word / 1e6 : 0.0;
+}
+
+/**
+ * @brief Interpreta una lista de CPUs al estilo de taskset ("0-3,8,10-11")
+ */
+int stress_parse_cpus(const char *s, cpu_set_t *set) {
+    CPU_ZERO(set);
+
+    while (*s) {
+        char *end;
+        long first = strtol(s, &end, 10);
+        long last = first;
+        if (end == s || first < 0) {
+            return -1;
+        }
+        if (*end == '-') {
+            s = end + 1;
+            last = strtol(s, &end, 10);
+            if (end == s || last < first) {
+                return -1;
+            }
+        }
+        if (last >= CPU_SETSIZE) {
+            return -1;
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            CPU_SET((int)cpu, set);
+        }
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return -1;
+        }
+        s = end;
+    }
+    return CPU_COUNT(set) > 0 ? CPU_COUNT(set) : -1;
+}
+
+/**
+ * @brief Instante actual de CLOCK_MONOTONIC en nanosegundos
+ */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Ejecuta un bloque, mide su duración y publica el trabajo acumulado
+ * @description El bloque tiene un tamaño fijo, así que su duración es
+ *              inversamente proporcional a la frecuencia efectiva de la CPU.
+ *
+ * @param w   Hilo
+ * @param ops Trabajo acumulado del hilo (se actualiza)
+ * @param t   Inicio del bloque; al volver, su final
+ */
+static void run_chunk(stress_worker *w, uint64_t *ops, uint64_t *t) {
+    *ops += kernel_run(&w->k);
+    __atomic_store_n(w->ops, *ops, __ATOMIC_RELAXED);
+    uint64_t end = now_ns();
+    latency_record(&w->lat, end, end - *t);
+    *t = end;
+}
+
+/**
+ * @brief Sigue el perfil de carga con ciclos de trabajo y reposo
+ * @description Los periodos empiezan en instantes absolutos comunes a todos
+ *              los hilos (epoch + k * periodo), así que todas las CPUs
+ *              suben y bajan a la vez. Dentro de cada periodo el hilo
+ *              ejecuta bloques durante util * periodo y duerme hasta el
+ *              final con clock_nanosleep() absoluto. Un bloque no se
+ *              interrumpe: el exceso de trabajo (o el defecto) se arrastra
+ *              al periodo siguiente, y la utilización media es la pedida
+ *              aunque un bloque dure una fracción apreciable del periodo.
+ *
+ * @return uint64_t Trabajo acumulado del hilo
+ */
+static uint64_t run_profile(stress_worker *w) {
+    const stress_options *o = w->opts;
+    uint64_t period = (uint64_t)o->period_ms * 1000000ull;
+    int64_t carry = 0;      // Trabajo hecho de más (+) o de menos (-), en ns
+    uint64_t ops = 0;
+
+    while (!should_stop()) {
+        uint64_t now = now_ns();
+        uint64_t begin = w->epoch_ns + (now - w->epoch_ns) / period * period;
+        uint64_t end = begin + period;
+        double util = o->closed_loop ? controlled_level(w->index)
+                                     : profile_level(&o->profile, (double)(begin - w->epoch_ns) / 1e9);
+
+        // Tiempo de trabajo del resto del periodo, corregido por el arrastre
+        int64_t target = (int64_t)(util * (double)(end - now));
+        uint64_t busy_until = now + (uint64_t)(target > carry ? target - carry : 0);
+        uint64_t t = now;
+        while (t < busy_until && !should_stop()) {
+            run_chunk(w, &ops, &t);
+        }
+
+        // El arrastre se limita a un periodo: tras un cambio brusco de nivel
+        // no se compensan deudas antiguas
+        carry += (int64_t)(t - now) - target;
+        if (carry > (int64_t)period) {
+            carry = (int64_t)period;
+        } else if (carry < -(int64_t)period) {
+            carry = -(int64_t)period;
+        }
+
+        if (t < end) {
+            struct timespec ts = {
+                .tv_sec = (time_t)(end / 1000000000ull),
+                .tv_nsec = (long)(end % 1000000000ull),
+            };
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        }
+    }
+    return ops;
+}
+
+/**
+ * @brief Cuerpo de un hilo de trabajo
+ * @description Se fija a su CPU, prepara su núcleo de carga y repite
+ *              bloques hasta que el hilo principal pide la parada. La
+ *              bandera se consulta una vez por bloque y tras cada reposo,
+ *              así que la parada tarda como mucho un periodo.
+ */
+static void *worker_main(void *arg) {
+    stress_worker *w = arg;
+    cpu_set_t one;
+
+    // FIJAR EL HILO A SU CPU
+    // ======================
+    // sched_setaffinity(0, ...) afecta solo al hilo que la llama
+    CPU_ZERO(&one);
+    CPU_SET(w->cpu, &one);
+    w->pinned = sched_setaffinity(0, sizeof(one), &one) == 0;
+
+    // PREPARAR EL NÚCLEO DE CARGA
+    // ===========================
+    // Después de fijar el hilo: la memoria se toca desde su nodo NUMA
+    if (kernel_init(&w->k, w->opts->kernel, w->opts->mem_bytes, 0x9E3779B97F4A7C15ull * (w->index + 1)) < 0) {
+        w->failed = 1;
+        return NULL;
+    }
+
+    // BUCLE PRINCIPAL - Genera carga en la CPU del hilo
+    // =================================================
+    // El contador y la sonda se actualizan tras cada bloque; solo los
+    // escribe este hilo. A plena carga no hay ciclos de reposo.
+    const stress_profile *p = &w->opts->profile;
+    if (!w->opts->closed_loop && p->shape == PROFILE_CONSTANT && p->high >= 1.0) {
+        uint64_t ops = 0, t = now_ns();
+        while (!should_stop()) {
+            run_chunk(w, &ops, &t);
+        }
+    } else {
+        run_profile(w);
+    }
+    latency_flush(&w->lat);
+    kernel_free(&w->k);
+    return NULL;
+}
+
+/**
+ * @brief Muestra la ayuda de línea de comandos
+ */
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [-t hilos] [-c lista_cpus] [-d segundos] [-k núcleo] [-m MiB]\n"
+            "       [-i ms] [-s /nombre_shm] [-u pct | -w onda | -r traza] [-p ms]\n"
+            "       [-T °C [-g kp,ki] [-S raíz_sysfs]] [-l log_latencias [-L ms]]\n"
+            "  -t hilos       Hilos de trabajo (por defecto, uno por CPU de la lista)\n"
+            "  -c lista_cpus  CPUs en las que fijar los hilos, p. ej. 0-7,16-23\n"
+            "                 (por defecto, la afinidad actual del proceso)\n"
+            "  -d segundos    Duración de la prueba (por defecto, hasta Ctrl+C)\n"
+            "  -k núcleo      scalar, fma, int, membw, chase o mixed (por defecto, fma)\n"
+            "  -m MiB         Memoria por hilo de membw y chase (por defecto, %d)\n"
+            "  -i ms          Intervalo del informe de rendimiento en stdout\n"
+            "                 (por defecto, %d; 0 = sin informe)\n"
+            "  -s /nombre     Publicar los contadores en memoria compartida\n"
+            "                 (/dev/shm/nombre, clave stress_shm del daemon)\n"
+            "  -u pct         Utilización objetivo constante (por defecto, 100)\n"
+            "  -w onda        forma:periodo_s:low_pct:high_pct, con forma square,\n"
+            "                 sawtooth o ramp; p. ej. square:20:10:100\n"
+            "  -r traza       Reproducir una traza \"segundos porcentaje\" por línea;\n"
+            "                 sin -d, la prueba dura lo que la traza\n"
+            "  -p ms          Periodo del ciclo de trabajo y reposo (por defecto, %d)\n"
+            "  -T °C          Mantener esta temperatura ajustando hilos activos y\n"
+            "                 ciclo de trabajo (excluyente con -u, -w y -r)\n"
+            "  -g kp,ki       Ganancias del controlador PI (por defecto, %g,%g)\n"
+            "  -S raíz        Raíz de sysfs de los sensores (por defecto, /sys)\n"
+            "  -l archivo     Log binario de la latencia de los bloques por ventana,\n"
+            "                 combinable con el del daemon en cpu_trace_export\n"
+            "  -L ms          Ventana de los resúmenes de latencia (por defecto, %d)\n",
+            prog, STRESS_DEFAULT_MEM_MB, STRESS_DEFAULT_REPORT_MS, STRESS_DEFAULT_PERIOD_MS,
+            STRESS_DEFAULT_KP, STRESS_DEFAULT_KI, LATENCY_DEFAULT_WINDOW_MS);
+}
+
+/**
+ * @brief Interpreta los argumentos de línea de comandos
+ * @return int 0 si éxito, -1 si algún argumento no es válido
+ */
+static int parse_options(int argc, char *argv[], stress_options *o) {
+    int opt;
+    char *end;
+    int profiles = 0;
+
+    memset(o, 0, sizeof(*o));
+    o->kernel = KERNEL_FMA;
+    o->mem_bytes = (size_t)STRESS_DEFAULT_MEM_MB << 20;
+    o->report_ms = STRESS_DEFAULT_REPORT_MS;
+    o->period_ms = STRESS_DEFAULT_PERIOD_MS;
+    profile_constant(&o->profile, 1.0);
+    o->kp = STRESS_DEFAULT_KP;
+    o->ki = STRESS_DEFAULT_KI;
+    snprintf(o->sysfs_root, sizeof(o->sysfs_root), "%s", "/sys");
+    o->window_ms = LATENCY_DEFAULT_WINDOW_MS;
+    if (sched_getaffinity(0, sizeof(o->cpus), &o->cpus) < 0) {
+        return -1;
+    }
+
+    while ((opt = getopt(argc, argv, "t:c:d:k:m:i:s:u:w:r:p:T:g:S:l:L:h")) != -1) {
+        switch (opt) {
+            case 't':
+                o->threads = (int)strtol(optarg, &end, 10);
+                if (*end != '\0' || o->threads <= 0 || o->threads > STRESS_MAX_THREADS) {
+                    return -1;
+                }
+                break;
+            case 'c':
+                if (stress_parse_cpus(optarg, &o->cpus) < 0) {
+                    return -1;
+                }
+                break;
+            case 'd':
+                o->duration_s = (unsigned)strtoul(optarg, &end, 10);
+                if (*end != '\0') {
+                    return -1;
+                }
+                break;
+            case 'k': {
+                int id = kernel_parse(optarg);
+                if (id < 0) {
+                    return -1;
+                }
+                o->kernel = (kernel_id)id;
+                break;
+            }
+            case 'm': {
+                unsigned long mb = strtoul(optarg, &end, 10);
+                if (*end != '\0' || mb == 0) {
+                    return -1;
+                }
+                o->mem_bytes = (size_t)mb << 20;
+                break;
+            }
+            case 'i':
+                o->report_ms = (unsigned)strtoul(optarg, &end, 10);
+                if (*end != '\0') {
+                    return -1;
+                }
+                break;
+            case 's':
+                // Nombre POSIX: una sola '/' inicial
+                if (optarg[0] != '/' || strchr(optarg + 1, '/') ||
+                    snprintf(o->shm_name, sizeof(o->shm_name), "%s", optarg) >= (int)sizeof(o->shm_name)) {
+                    return -1;
+                }
+                break;
+            case 'u': {
+                double pct = strtod(optarg, &end);
+                if (*end != '\0' || end == optarg || pct < 0.0 || pct > 100.0) {
+                    return -1;
+                }
+                profile_free(&o->profile);
+                profile_constant(&o->profile, pct / 100.0);
+                profiles++;
+                break;
+            }
+            case 'w':
+                profile_free(&o->profile);
+                if (profile_parse_wave(&o->profile, optarg) < 0) {
+                    return -1;
+                }
+                profiles++;
+                break;
+            case 'r':
+                profile_free(&o->profile);
+                if (profile_load_trace(&o->profile, optarg) < 0) {
+                    fprintf(stderr, "cpu_stressor: %s: invalid or unreadable trace\n", optarg);
+                    return -1;
+                }
+                profiles++;
+                break;
+            case 'p':
+                o->period_ms = (unsigned)strtoul(optarg, &end, 10);
+                if (*end != '\0' || o->period_ms == 0 || o->period_ms > 10000) {
+                    return -1;
+                }
+                break;
+            case 'T':
+                o->setpoint_c = strtod(optarg, &end);
+                if (*end != '\0' || end == optarg || o->setpoint_c <= 0.0 || o->setpoint_c > 150.0) {
+                    return -1;
+                }
+                o->closed_loop = 1;
+                profiles++;
+                break;
+            case 'g':
+                o->kp = strtod(optarg, &end);
+                if (*end != ',' || o->kp < 0.0) {
+                    return -1;
+                }
+                o->ki = strtod(end + 1, &end);
+                if (*end != '\0' || o->ki < 0.0) {
+                    return -1;
+                }
+                break;
+            case 'S':
+                if (optarg[0] != '/' ||
+                    snprintf(o->sysfs_root, sizeof(o->sysfs_root), "%s", optarg) >= (int)sizeof(o->sysfs_root)) {
+                    return -1;
+                }
+                break;
+            case 'l':
+                if (snprintf(o->latency_path, sizeof(o->latency_path), "%s", optarg) >= (int)sizeof(o->latency_path)) {
+                    return -1;
+                }
+                break;
+            case 'L':
+                o->window_ms = (unsigned)strtoul(optarg, &end, 10);
+                if (*end != '\0' || o->window_ms == 0 || o->window_ms > 10000) {
+                    return -1;
+                }
+                break;
+            default:
+                return -1;
+        }
+    }
+
+    // -u, -w, -r y -T son excluyentes
+    if (profiles > 1) {
+        return -1;
+    }
+
+    // Una traza sin -d se reproduce una vez: su último punto marca el final
+    double length = profile_length(&o->profile);
+    if (o->duration_s == 0 && length > 0.0) {
+        o->duration_s = (unsigned)length + ((double)(unsigned)length < length);
+    }
+
+    if (o->threads == 0) {
+        o->threads = CPU_COUNT(&o->cpus);
+    }
+    return 0;
+}
 
 /**
- * @brief Función principal que ejecuta prueba de estrés continua del CPU
- * @description Implementa un bucle infinito que realiza operaciones matemáticas
- *              intensivas para generar carga máxima en el procesador. Utiliza
- *              multiplicaciones en punto flotante repetitivas para mantener
- *              el CPU ocupado al 100% de su capacidad.
- * 
- * @return int Código de retorno (nunca se alcanza debido al bucle infinito)
- *             - 0: Terminación exitosa (teóricamente)
- * 
+ * @brief Espera una señal de parada hasta un instante dado
+ *
+ * @param mask  Señales de parada
+ * @param until Instante límite (CLOCK_MONOTONIC, ns); 0 = sin límite
+ *
+ * @return int Número de señal, o 0 si se alcanzó el instante límite
+ */
+static int wait_signal(const sigset_t *mask, uint64_t until) {
+    for (;;) {
+        int signo;
+        if (until == 0) {
+            signo = sigwaitinfo(mask, NULL);
+        } else {
+            uint64_t now = now_ns();
+            if (now >= until) {
+                return 0;
+            }
+            struct timespec left = {
+                .tv_sec = (time_t)((until - now) / 1000000000ull),
+                .tv_nsec = (long)((until - now) % 1000000000ull),
+            };
+            signo = sigtimedwait(mask, NULL, &left);
+        }
+        if (signo > 0) {
+            return signo;
+        }
+        if (errno == EAGAIN) {
+            return 0;
+        }
+        // EINTR: volver a esperar el tiempo restante
+    }
+}
+
+/**
+ * @brief Crea los contadores de los hilos
+ * @description Con -s, en un objeto de memoria compartida que el daemon
+ *              puede mapear; si no, en memoria anónima con el mismo
+ *              formato. magic se publica al final, con semántica release.
+ *
+ * @return stress_shm* Contadores, o NULL si hubo un error
+ */
+static stress_shm *open_counters(const stress_options *o) {
+    size_t size = STRESS_SHM_SIZE(o->threads);
+    void *p;
+
+    if (o->shm_name[0] != '\0') {
+        int fd = shm_open(o->shm_name, O_CREAT | O_RDWR | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return NULL;
+        }
+        if (ftruncate(fd, (off_t)size) < 0) {
+            close(fd);
+            shm_unlink(o->shm_name);
+            return NULL;
+        }
+        p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+    } else {
+        p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (p == MAP_FAILED) {
+        if (o->shm_name[0] != '\0') {
+            shm_unlink(o->shm_name);
+        }
+        return NULL;
+    }
+
+    stress_shm *s = p;
+    s->version = STRESS_SHM_VERSION;
+    s->threads = (uint32_t)o->threads;
+    s->pid = (int32_t)getpid();
+    snprintf(s->kernel, sizeof(s->kernel), "%s", kernel_name(o->kernel));
+    snprintf(s->unit, sizeof(s->unit), "%s", kernel_unit(o->kernel));
+    s->start_ns = now_ns();
+    __atomic_store_n(&s->magic, STRESS_SHM_MAGIC, __ATOMIC_RELEASE);
+    return s;
+}
+
+/**
+ * @brief Libera los contadores y retira el objeto compartido
+ * @description Al desaparecer /dev/shm/<nombre> el daemon deja de
+ *              registrar el rendimiento.
+ */
+static void close_counters(stress_shm *s, const stress_options *o) {
+    munmap(s, STRESS_SHM_SIZE(o->threads));
+    if (o->shm_name[0] != '\0') {
+        shm_unlink(o->shm_name);
+    }
+}
+
+/**
+ * @brief Prepara el lazo cerrado: sensores, controlador y primera salida
+ * @return int 0 si éxito, -1 si no hay un sensor de temperatura legible
+ */
+static int loop_open(temp_loop *l, const stress_options *o, uint64_t now) {
+    memset(l, 0, sizeof(*l));
+    if (sensors_discover(&l->sensors, o->sysfs_root) <= 0 || l->sensors.primary < 0) {
+        return -1;
+    }
+    sensors_open(&l->sensors);
+    l->temp_c = sensors_read(&l->sensors, l->sensors.primary, NULL);
+    if (l->temp_c < 0.0) {
+        sensors_close(&l->sensors);
+        return -1;
+    }
+
+    // Primera salida solo con el término proporcional
+    double duty;
+    pi_init(&l->pi, o->setpoint_c, o->kp, o->ki);
+    int active = stress_control_split(pi_update(&l->pi, l->temp_c, 0.0), o->threads, &duty);
+    set_control(active, duty);
+    l->last_ns = now;
+    return 0;
+}
+
+/**
+ * @brief Un paso del lazo cerrado: mide, actualiza el PI y publica
+ * @description Si el sensor no es legible se mantiene la salida anterior.
+ */
+static void loop_step(temp_loop *l, const stress_options *o, uint64_t now) {
+    double dt = (double)(now - l->last_ns) / 1e9;
+    l->out_sum += l->pi.output * dt;
+    l->out_time += dt;
+    l->last_ns = now;
+
+    float temp = sensors_read(&l->sensors, l->sensors.primary, NULL);
+    if (temp < 0.0f) {
+        return;
+    }
+    l->temp_c = temp;
+
+    double duty;
+    int active = stress_control_split(pi_update(&l->pi, temp, dt), o->threads, &duty);
+    set_control(active, duty);
+}
+
+/**
+ * @brief Salida media del lazo cerrado desde el último informe
+ */
+static double loop_mean(temp_loop *l) {
+    double mean = l->out_time > 0.0 ? l->out_sum / l->out_time : l->pi.output;
+    l->out_sum = 0.0;
+    l->out_time = 0.0;
+    return mean;
+}
+
+/**
+ * @brief Pasa al log binario las ventanas de latencia pendientes
+ */
+static void drain_latency(binlog_writer *log, stress_worker *workers, int n) {
+    latency_window win;
+
+    for (int i = 0; i < n; i++) {
+        while (latency_pop(&workers[i].lat, &win)) {
+            binlog_chunk r = {
+                .thread = (uint16_t)i,
+                .cpu = (uint16_t)workers[i].cpu,
+                .count = win.count,
+                .min_ns = win.min_ns,
+                .mean_ns = win.mean_ns,
+                .max_ns = win.max_ns,
+            };
+            binlog_append(log, BINLOG_CHUNK, win.end_ns, &r, sizeof(r));
+        }
+    }
+    binlog_flush(log);
+}
+
+/**
+ * @brief Resume la latencia de los bloques al terminar
+ * @description Registra los percentiles de cada hilo en el log binario y
+ *              escribe en stderr los del conjunto y el hilo con la mediana
+ *              más lenta, que suele ser el de la CPU más caliente.
+ */
+static void latency_summary(binlog_writer *log, stress_worker *workers, int n) {
+    static latency_hist all;
+    uint64_t dropped = 0, worst_p50 = 0;
+    int worst = -1;
+
+    for (int i = 0; i < n; i++) {
+        const latency_hist *h = &workers[i].lat.hist;
+        if (h->count == 0) {
+            continue;
+        }
+        binlog_chunk_summary r = {
+            .thread = (uint16_t)i,
+            .cpu = (uint16_t)workers[i].cpu,
+            .count = h->count,
+            .p50_ns = latency_percentile(h, 50.0),
+            .p99_ns = latency_percentile(h, 99.0),
+            .p999_ns = latency_percentile(h, 99.9),
+            .max_ns = h->max_ns,
+        };
+        binlog_append(log, BINLOG_CHUNK_SUMMARY, now_ns(), &r, sizeof(r));
+        latency_merge(&all, h);
+        dropped += workers[i].lat.dropped;
+        if (r.p50_ns > worst_p50) {
+            worst_p50 = r.p50_ns;
+            worst = i;
+        }
+    }
+    binlog_flush(log);
+    if (all.count == 0) {
+        return;
+    }
+
+    fprintf(stderr, "cpu_stressor: chunk latency over %llu chunks: p50 %.1f us, p99 %.1f us, "
+            "p99.9 %.1f us, max %.1f us; slowest p50 %.1f us on cpu%d\n",
+            (unsigned long long)all.count, latency_percentile(&all, 50.0) / 1e3,
+            latency_percentile(&all, 99.0) / 1e3, latency_percentile(&all, 99.9) / 1e3,
+            all.max_ns / 1e3, worst_p50 / 1e3, workers[worst].cpu);
+    if (dropped > 0) {
+        fprintf(stderr, "cpu_stressor: %llu latency windows dropped (log drain too slow)\n",
+                (unsigned long long)dropped);
+    }
+}
+
+/**
+ * @brief Utilización objetivo media entre dos instantes
+ * @description Los hilos evalúan el perfil al inicio de cada periodo, así
+ *              que se promedian esos valores ponderados por la parte de
+ *              cada periodo que cae en el intervalo.
+ *
+ * @param from_ns Inicio del intervalo, relativo al arranque
+ * @param to_ns   Final del intervalo, relativo al arranque
+ */
+static double target_mean(const stress_options *o, uint64_t from_ns, uint64_t to_ns) {
+    uint64_t period = (uint64_t)o->period_ms * 1000000ull;
+    double sum = 0.0;
+
+    if (to_ns <= from_ns) {
+        return profile_level(&o->profile, from_ns / 1e9);
+    }
+    for (uint64_t begin = from_ns / period * period; begin < to_ns; begin += period) {
+        uint64_t lo = begin > from_ns ? begin : from_ns;
+        uint64_t hi = begin + period < to_ns ? begin + period : to_ns;
+        sum += profile_level(&o->profile, begin / 1e9) * (double)(hi - lo);
+    }
+    return sum / (double)(to_ns - from_ns);
+}
+
+/**
+ * @brief Escribe una fila del informe de rendimiento
+ * @description Columnas: segundos desde el arranque, utilización objetivo
+ *              media y trabajo por segundo en el último intervalo, del
+ *              total y de cada hilo. Una caída del total a utilización y
+ *              temperatura constantes es el coste del throttling. En lazo
+ *              cerrado se añade la temperatura medida tras el objetivo.
+ *
+ * @param s          Contadores de los hilos
+ * @param prev       Contadores del informe anterior (se actualizan)
+ * @param delta      Espacio para el trabajo de cada hilo en el intervalo
+ * @param threads    Hilos
+ * @param elapsed_s  Segundos desde el arranque
+ * @param interval_s Duración real del intervalo
+ * @param target     Utilización objetivo media del intervalo (0 a 1)
+ * @param temp_c     Temperatura medida, o NULL fuera del lazo cerrado
+ */
+static void report(const stress_shm *s, uint64_t *prev, uint64_t *delta, int threads,
+                   double elapsed_s, double interval_s, double target, const double *temp_c) {
+    uint64_t total = 0;
+    for (int i = 0; i < threads; i++) {
+        uint64_t ops = __atomic_load_n(&s->slot[i].ops, __ATOMIC_RELAXED);
+        delta[i] = ops - prev[i];
+        prev[i] = ops;
+        total += delta[i];
+    }
+
+    printf("%.3f %.1f", elapsed_s, target * 100.0);
+    if (temp_c != NULL) {
+        printf(" %.1f", *temp_c);
+    }
+    printf(" %.4e", (double)total / interval_s);
+    for (int i = 0; i < threads; i++) {
+        printf(" %.4e", (double)delta[i] / interval_s);
+    }
+    putchar('\n');
+    fflush(stdout);
+}
+
+/**
+ * @brief Función principal que ejecuta la prueba de estrés del CPU
+ * @description Lanza los hilos de trabajo, cada uno fijado a una CPU del
+ *              conjunto (en orden, repartiendo cíclicamente si hay más hilos
+ *              que CPUs), y espera la señal o el fin de la duración.
+ *
+ * @return int Código de retorno
+ *             - 0: Terminación ordenada (duración cumplida o señal)
+ *             - 1: Argumentos inválidos o error al crear los hilos
+ *
  * @details Algoritmo de estrés implementado:
- * 
- *          **🔥 Bucle Principal Infinito:**
- *          - while(1): Ejecuta indefinidamente hasta terminación forzada
- *          - No tiene condición de salida natural
- *          - Requiere Ctrl+C o kill para terminar
- * 
- *          **🧮 Cálculo Intensivo por Iteración:**
- *          - Variable x inicializada en 1.0 (punto flotante doble precisión)
- *          - 1,000,000 de multiplicaciones por x *= 1.000001
- *          - Cada multiplicación consume ciclos de CPU
- * 
- *          **📊 Características del Cálculo:**
- *          - Operación: Multiplicación acumulativa
- *          - Factor: 1.000001 (incremento mínimo para evitar overflow rápido)
- *          - Iteraciones: 1,000,000 por ciclo
- *          - Resultado: x ≈ e^(1000000 * ln(1.000001)) ≈ e^1000 por ciclo
- * 
+ *
+ *          **🔥 Hilos de Trabajo:**
+ *          - Un hilo por CPU de la lista (-c) o el número pedido (-t)
+ *          - Cada hilo se fija a su CPU con sched_setaffinity()
+ *          - Bucle de cálculo hasta la petición de parada
+ *
+ *          **🧮 Núcleos de Carga (-k):**
+ *          - fma: FMA vectorial AVX-512/AVX2 (máximo calor y potencia)
+ *          - int: aritmética entera con saltos impredecibles
+ *          - membw: streaming de memoria (triad), limitado por DRAM
+ *          - chase: fallos de caché dependientes, núcleo casi ocioso
+ *          - mixed: alterna los cuatro por bloque
+ *          - scalar: la cadena original x *= 1.000001
+ *
+ *          **🛑 Parada Ordenada:**
+ *          - SIGINT, SIGTERM y SIGHUP se bloquean en todos los hilos
+ *          - El hilo principal las espera con sigtimedwait() junto con la
+ *            duración, activa la bandera de parada y une los hilos
+ *
  * @performance Impacto en el Sistema:
- *              - **Uso de CPU**: 100% en un núcleo (single-threaded)
- *              - **Temperatura**: Incremento significativo del CPU
- *              - **Consumo energético**: Máximo para el núcleo utilizado
- *              - **Duración**: Indefinida hasta terminación manual
- * 
- * @use_cases Casos de Uso Típicos:
- *            - **Pruebas de temperatura**: Verificar sistemas de cooling
- *            - **Benchmarking**: Medir rendimiento sostenido
- *            - **Pruebas de estabilidad**: Detectar fallos bajo carga
- *            - **Validación de monitoring**: Probar daemons de monitoreo
- *            - **Pruebas de throttling**: Verificar limitación térmica
- * 
+ *              - **Uso de CPU**: 100% en cada CPU del conjunto
+ *              - **Temperatura**: Carga térmica de paquete completo
+ *              - **Consumo energético**: Máximo para las CPUs utilizadas
+ *              - **Duración**: -d segundos o hasta terminación manual
+ *
  * @warnings ⚠️ Advertencias de Seguridad:
  *           - **Sobrecalentamiento**: Puede causar temperaturas peligrosas
  *           - **Throttling térmico**: El CPU puede reducir frecuencia
  *           - **Consumo energético**: Incremento significativo del consumo
  *           - **Ruido del ventilador**: Los ventiladores trabajarán al máximo
  *           - **Duración**: Solo ejecutar por períodos controlados
- * 
- * @termination Métodos de Terminación:
- *              - **Ctrl+C**: Señal SIGINT desde terminal
- *              - **kill PID**: Comando kill desde otra terminal
- *              - **killall programa**: Terminar por nombre del proceso
- *              - **Timeout**: Usar timeout command para límite temporal
- * 
+ *
  * @example Ejemplos de Ejecución:
  *          ```bash
- *          # Ejecución básica (cuidado - bucle infinito)
- *          ./cpu_stress_test
- *          
- *          # Ejecución con límite de tiempo (30 segundos)
- *          timeout 30s ./cpu_stress_test
- *          
- *          # Ejecución en segundo plano
- *          ./cpu_stress_test &
- *          
- *          # Terminar por PID
- *          kill $(pgrep cpu_stress_test)
- *          
- *          # Monitorear temperatura mientras ejecuta
- *          ./cpu_stress_test & sensors -f
+ *          # Todas las CPUs permitidas hasta Ctrl+C
+ *          ./cpu_stressor
+ *
+ *          # Primer socket de un host de 64 núcleos durante 5 minutos
+ *          ./cpu_stressor -c 0-31 -d 300
+ *
+ *          # Cuatro hilos en las CPUs 8-11
+ *          ./cpu_stressor -t 4 -c 8-11
+ *
+ *          # Ancho de banda de memoria con 256 MiB por hilo
+ *          ./cpu_stressor -k membw -m 256
+ *
+ *          # Terminar por PID (parada ordenada)
+ *          kill $(pgrep cpu_stressor)
  *          ```
- * 
- * @monitoring Monitoreo Recomendado:
- *             - **htop/top**: Verificar uso de CPU
- *             - **sensors**: Monitorear temperatura
- *             - **powertop**: Verificar consumo energético
- *             - **iostat**: Monitorear rendimiento general del sistema
- * 
- * @mathematical_analysis Análisis Matemático:
- *                        - Operación: x = x * 1.000001 (1M veces por ciclo)
- *                        - Resultado por ciclo: x ≈ e^1000 ≈ 1.97 × 10^434
- *                        - Overflow: Ocurrirá después de varios ciclos
- *                        - Comportamiento post-overflow: x = inf, luego NaN
- * 
+ *
  * @see htop para monitoreo de procesos
  * @see sensors para monitoreo de temperatura
- * @see timeout para ejecución con límite temporal
- */
-int main() {
-    // BUCLE PRINCIPAL INFINITO - Genera carga continua en el CPU
-    // ========================================================
-    // while(1): Bucle sin condición de terminación
-    // Solo se puede interrumpir externamente (Ctrl+C, kill, etc.)
-    while (1) {
-        // INICIALIZACIÓN DE VARIABLE DE CÁLCULO
-        // ====================================
-        // double x: Variable de punto flotante de doble precisión
-        // Inicializada en 1.0 para comenzar cada ciclo de cálculo
-        // Uso de double (64-bit) en lugar de float para mayor precisión
-        double x = 1.0;
-        
-        // BUCLE DE CÁLCULO INTENSIVO - 1,000,000 iteraciones
-        // =================================================
-        // for loop: Ejecuta exactamente 1,000,000 multiplicaciones
-        // Cada iteración consume ciclos de CPU con operación aritmética
-        for (int i = 0; i < 1000000; ++i) {
-            // OPERACIÓN MATEMÁTICA INTENSIVA
-            // =============================
-            // x *= 1.000001: Multiplicación acumulativa
-            // Factor 1.000001: Incremento muy pequeño para evitar overflow rápido
-            // Esta operación mantiene al CPU ocupado realizando cálculos FPU
-            // 
-            // Progresión matemática:
-            // Iteración 1: x = 1.0 * 1.000001 = 1.000001
-            // Iteración 2: x = 1.000001 * 1.000001 = 1.000002000001
-            // ...
-            // Iteración 1M: x ≈ (1.000001)^1000000 ≈ e^1000 ≈ 1.97×10^434
-            x *= 1.000001;
-        }
-        
-        // FIN DEL CICLO DE CÁLCULO
-        // =======================
-        // Al completar 1M multiplicaciones, el bucle while(1) reinicia
-        // Nueva iteración: x se reinicializa a 1.0 y el proceso se repite
-        // Este patrón continúa indefinidamente, manteniendo el CPU ocupado
-    }
-    
-    // CÓDIGO INALCANZABLE
-    // ==================
-    // Esta línea nunca se ejecuta debido al bucle infinito anterior
-    // Solo se incluye para cumplir con la sintaxis de función main()
-    // En un escenario real, el programa termina por señal externa
-    return 0;
-}
\ No newline at end of file
+ */
+int main(int argc, char *argv[]) {
+    stress_options opts;
+    static stress_worker workers[STRESS_MAX_THREADS];
+    sigset_t mask;
+
+    if (parse_options(argc, argv, &opts) < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Bloquear las señales de parada antes de crear los hilos: la máscara
+    // se hereda y solo el hilo principal las recibe con sigtimedwait()
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    sigaddset(&mask, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    // CPUs del conjunto en orden; los hilos se reparten cíclicamente
+    int cpu_list[CPU_SETSIZE];
+    int ncpus = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &opts.cpus)) {
+            cpu_list[ncpus++] = cpu;
+        }
+    }
+
+    stress_shm *counters = open_counters(&opts);
+    if (counters == NULL) {
+        fprintf(stderr, "cpu_stressor: %s: %s\n",
+                opts.shm_name[0] != '\0' ? opts.shm_name : "mmap", strerror(errno));
+        return 1;
+    }
+
+    // El lazo cerrado publica su primera salida antes de arrancar los hilos
+    static temp_loop loop;
+    if (opts.closed_loop && loop_open(&loop, &opts, counters->start_ns) < 0) {
+        fprintf(stderr, "cpu_stressor: no readable temperature sensor under %s\n", opts.sysfs_root);
+        close_counters(counters, &opts);
+        return 1;
+    }
+
+    // Log de latencias: mismo formato y reloj que el log binario del daemon
+    static binlog_writer latlog = {.fd = -1};
+    if (opts.latency_path[0] != '\0') {
+        if (binlog_open(&latlog, opts.latency_path) < 0) {
+            fprintf(stderr, "cpu_stressor: %s: %s\n", opts.latency_path, strerror(errno));
+            close_counters(counters, &opts);
+            return 1;
+        }
+        binlog_chunk_info info = {
+            .threads = (uint32_t)opts.threads,
+            .window_us = opts.window_ms * 1000,
+        };
+        snprintf(info.kernel, sizeof(info.kernel), "%s", kernel_name(opts.kernel));
+        binlog_append(&latlog, BINLOG_CHUNK_INFO, counters->start_ns, &info, sizeof(info));
+        binlog_flush(&latlog);
+    }
+    uint64_t window_ns = latlog.fd >= 0 ? (uint64_t)opts.window_ms * 1000000ull : 0;
+
+    int started = 0;
+    for (int i = 0; i < opts.threads; i++) {
+        stress_worker *w = &workers[i];
+        w->index = i;
+        w->cpu = cpu_list[i % ncpus];
+        w->opts = &opts;
+        w->ops = &counters->slot[i].ops;
+        w->epoch_ns = counters->start_ns;
+        latency_init(&w->lat, counters->start_ns, window_ns);
+        int rc = pthread_create(&w->thread, NULL, worker_main, w);
+        if (rc != 0) {
+            fprintf(stderr, "cpu_stressor: pthread_create: %s\n", strerror(rc));
+            break;
+        }
+        started++;
+    }
+
+    fprintf(stderr, "cpu_stressor: %d threads on %d cpus, kernel %s", started, ncpus,
+            kernel_name(opts.kernel));
+    if (opts.kernel == KERNEL_FMA || opts.kernel == KERNEL_MIXED) {
+        fprintf(stderr, " (%s)", kernel_fma_isa());
+    }
+    const stress_profile *prof = &opts.profile;
+    if (opts.closed_loop) {
+        const sensor_channel *c = &loop.sensors.ch[loop.sensors.primary];
+        fprintf(stderr, ", holding %.1f C on %s %s (now %.1f C, kp %g ki %g) every %u ms",
+                opts.setpoint_c, c->driver, c->label, loop.temp_c, opts.kp, opts.ki, opts.period_ms);
+    } else if (prof->shape == PROFILE_CONSTANT && prof->high < 1.0) {
+        fprintf(stderr, ", %.1f%% duty cycle every %u ms", prof->high * 100.0, opts.period_ms);
+    } else if (prof->shape == PROFILE_TRACE) {
+        fprintf(stderr, ", trace of %zu points every %u ms", prof->npoints, opts.period_ms);
+    } else if (prof->shape != PROFILE_CONSTANT) {
+        fprintf(stderr, ", %s %.1f-%.1f%% over %g s every %u ms", profile_name(prof->shape),
+                prof->low * 100.0, prof->high * 100.0, prof->period_s, opts.period_ms);
+    }
+    if (opts.duration_s > 0) {
+        fprintf(stderr, " for %u s", opts.duration_s);
+    }
+    fputc('\n', stderr);
+
+    // ESPERA E INFORME
+    // ================
+    // Plazos absolutos: el informe no deriva aunque una escritura se retrase
+    static uint64_t prev[STRESS_MAX_THREADS], delta[STRESS_MAX_THREADS];
+    uint64_t start = counters->start_ns;
+    uint64_t report_ns = (uint64_t)opts.report_ms * 1000000ull;
+    uint64_t deadline = opts.duration_s > 0 ? start + (uint64_t)opts.duration_s * 1000000000ull : 0;
+    uint64_t next_report = report_ns > 0 ? start + report_ns : 0;
+    uint64_t last_report = start;
+    uint64_t control_ns = (uint64_t)STRESS_CONTROL_MS * 1000000ull;
+    uint64_t next_control = opts.closed_loop ? start + control_ns : 0;
+    uint64_t drain_ns = (uint64_t)STRESS_DRAIN_MS * 1000000ull;
+    uint64_t next_drain = latlog.fd >= 0 ? start + drain_ns : 0;
+    int signo = 0;
+
+    if (report_ns > 0 && started == opts.threads) {
+        printf("# t_s target_pct%s total_%s_per_s", opts.closed_loop ? " temp_c" : "", counters->unit);
+        for (int i = 0; i < started; i++) {
+            printf(" cpu%d", workers[i].cpu);
+        }
+        putchar('\n');
+        fflush(stdout);
+    }
+
+    while (started == opts.threads) {
+        uint64_t until = deadline;
+        if (next_report != 0 && (until == 0 || next_report < until)) {
+            until = next_report;
+        }
+        if (next_control != 0 && (until == 0 || next_control < until)) {
+            until = next_control;
+        }
+        if (next_drain != 0 && (until == 0 || next_drain < until)) {
+            until = next_drain;
+        }
+        signo = wait_signal(&mask, until);
+        if (signo > 0) {
+            break;
+        }
+        uint64_t now = now_ns();
+        if (next_control != 0 && now >= next_control) {
+            loop_step(&loop, &opts, now);
+            while (next_control <= now) {
+                next_control += control_ns;
+            }
+        }
+        if (next_drain != 0 && now >= next_drain) {
+            drain_latency(&latlog, workers, started);
+            while (next_drain <= now) {
+                next_drain += drain_ns;
+            }
+        }
+        if (next_report != 0 && now >= next_report) {
+            if (opts.closed_loop) {
+                report(counters, prev, delta, started, (now - start) / 1e9, (now - last_report) / 1e9,
+                       loop_mean(&loop), &loop.temp_c);
+            } else {
+                report(counters, prev, delta, started, (now - start) / 1e9, (now - last_report) / 1e9,
+                       target_mean(&opts, last_report - start, now - start), NULL);
+            }
+            last_report = now;
+            while (next_report <= now) {
+                next_report += report_ns;
+            }
+        }
+        if (deadline != 0 && now >= deadline) {
+            break;
+        }
+    }
+
+    // PARADA ORDENADA
+    // ===============
+    // Cada hilo termina al acabar su bloque de cálculo actual
+    __atomic_store_n(&stop_requested, 1, __ATOMIC_RELAXED);
+    int unpinned = 0, failed = 0;
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        unpinned += !workers[i].pinned;
+        failed += workers[i].failed;
+    }
+
+    if (unpinned > 0) {
+        fprintf(stderr, "cpu_stressor: %d threads could not be pinned\n", unpinned);
+    }
+    if (failed > 0) {
+        fprintf(stderr, "cpu_stressor: %d threads could not allocate %zu MiB\n",
+                failed, opts.mem_bytes >> 20);
+    }
+    if (signo > 0) {
+        fprintf(stderr, "cpu_stressor: stopped by %s\n", strsignal(signo));
+    }
+    // Los hilos ya cerraron su última ventana
+    drain_latency(&latlog, workers, started);
+    latency_summary(&latlog, workers, started);
+    binlog_close(&latlog);
+    close_counters(counters, &opts);
+    profile_free(&opts.profile);
+    if (opts.closed_loop) {
+        sensors_close(&loop.sensors);
+    }
+    return started == opts.threads && failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/**
+ * @brief Header del programa de prueba de estrés para CPU
+ * @description Define las opciones de línea de comandos y el estado de cada
+ *              hilo de trabajo de cpu_stressor. Cada hilo se fija a una CPU
+ *              del conjunto pedido con sched_setaffinity(), de modo que la
+ *              carga reproduce el calor de un socket completo y no solo el
+ *              de un núcleo.
+ * @author Sistema de pruebas CPU
+ *
+ * @note Requiere _GNU_SOURCE antes de la primera inclusión (cpu_set_t).
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef CPU_STRESSOR_H  // Si CPU_STRESSOR_H no está definido
+#define CPU_STRESSOR_H  // Definir CPU_STRESSOR_H como macro de protección
+
+#include <sched.h>    // Para cpu_set_t
+#include <pthread.h>  // Para pthread_t
+#include <stddef.h>   // Para size_t
+#include <stdint.h>   // Para uint64_t
+#include "stress_kernels.h" // Para kernel_id, kernel_ctx
+#include "stress_shm.h"     // Para stress_shm
+#include "stress_profile.h" // Para stress_profile
+#include "stress_control.h" // Para pi_controller
+#include "temp_monitor.h"   // Para sensor_table
+#include "stress_latency.h" // Para latency_probe
+
+// Máximo de hilos de trabajo
+#define STRESS_MAX_THREADS 1024
+
+// Memoria por hilo de membw y chase, en MiB (mayor que la LLC de un CCD)
+#define STRESS_DEFAULT_MEM_MB 64
+
+// Intervalo del informe de rendimiento por defecto, en milisegundos
+#define STRESS_DEFAULT_REPORT_MS 1000
+
+// Periodo de vaciado de las ventanas de latencia al log binario
+#define STRESS_DRAIN_MS 100
+
+// Periodo del ciclo de trabajo y reposo por defecto, en milisegundos
+// (unas cien veces un bloque de kernel_run())
+#define STRESS_DEFAULT_PERIOD_MS 100
+
+/**
+ * @brief Opciones de línea de comandos
+ */
+typedef struct {
+    int threads;            // Hilos de trabajo (0 = uno por CPU del conjunto)
+    cpu_set_t cpus;         // CPUs en las que se fijan los hilos
+    unsigned duration_s;    // Duración de la prueba (0 = hasta recibir una señal)
+    kernel_id kernel;       // Núcleo de carga
+    size_t mem_bytes;       // Memoria por hilo de membw y chase
+    unsigned report_ms;     // Intervalo del informe por stdout (0 = sin informe)
+    char shm_name[64];      // Objeto de memoria compartida ("" = contadores privados)
+    stress_profile profile; // Utilización objetivo en función del tiempo
+    unsigned period_ms;     // Periodo del ciclo de trabajo y reposo
+    int closed_loop;        // 1 = mantener setpoint_c en lugar de seguir el perfil
+    double setpoint_c;      // Temperatura de consigna en °C (-T)
+    double kp, ki;          // Ganancias del controlador PI (-g)
+    char sysfs_root[SENSOR_PATH_LEN]; // Raíz de sysfs de los sensores (-S)
+    char latency_path[256]; // Log binario de latencias por bloque ("" = desactivado)
+    unsigned window_ms;     // Ventana de los resúmenes de latencia (-L)
+} stress_options;
+
+/**
+ * @brief Estado de un hilo de trabajo
+ */
+typedef struct {
+    pthread_t thread;       // Hilo POSIX
+    int index;              // Número de hilo
+    int cpu;                // CPU a la que se fija
+    int pinned;             // 1 si sched_setaffinity() tuvo éxito
+    int failed;             // 1 si no se pudo reservar la memoria del núcleo
+    const stress_options *opts; // Opciones compartidas
+    uint64_t *ops;          // Contador de trabajo del hilo (en stress_shm)
+    uint64_t epoch_ns;      // Origen común de los periodos (CLOCK_MONOTONIC)
+    kernel_ctx k;           // Estado del núcleo de carga
+    latency_probe lat;      // Duración de cada bloque
+} stress_worker;
+
+/**
+ * @brief Estado del lazo cerrado de temperatura
+ * @description La temperatura se lee con el mismo backend de sysfs que el
+ *              daemon (canal primario de temp_monitor), con pread() sobre
+ *              un descriptor persistente.
+ */
+typedef struct {
+    sensor_table sensors;   // Canales de temperatura descubiertos
+    pi_controller pi;       // Controlador
+    double temp_c;          // Última temperatura leída (-1 = ninguna)
+    uint64_t last_ns;       // Instante de la última medida
+    double out_sum;         // Salida integrada desde el último informe (s)
+    double out_time;        // Segundos integrados desde el último informe
+} temp_loop;
+
+/**
+ * @brief Interpreta una lista de CPUs al estilo de taskset ("0-3,8,10-11")
+ *
+ * @param s   Lista de CPUs
+ * @param set Conjunto resultado
+ *
+ * @return int Número de CPUs del conjunto, -1 si la lista no es válida
+ */
+int stress_parse_cpus(const char *s, cpu_set_t *set);
+
+#endif // CPU_STRESSOR_H - Fin de las guardas de inclusión
@@ -0,0 +1,611 @@
+/**
+ * @brief Banco de pruebas de la latencia de detección del daemon
+ * @description Mide cuánto tarda cpu_daemon en ver un escalón de carga y en
+ *              despachar la alerta. Para cada combinación de backend de
+ *              sensores e intervalo de muestreo:
+ *              1. Prepara un directorio de trabajo con la configuración y,
+ *                 para los backends falsos, un sensor controlado por el
+ *                 banco
+ *              2. Lanza cpu_daemon -f (primer plano) con su log binario
+ *              3. En cada prueba espera un desfase aleatorio respecto al
+ *                 muestreo, lanza cpu_stressor (escalón de carga) y, con un
+ *                 sensor falso, sube la temperatura en el mismo instante
+ *              4. Lee el log binario del daemon hasta encontrar la primera
+ *                 muestra sobre el umbral y el fin del despacho de la
+ *                 alerta (span de la etapa notify)
+ *              5. Para la carga, enfría el sensor y espera una muestra bajo
+ *                 el umbral antes de la prueba siguiente
+ *              Todas las marcas son CLOCK_MONOTONIC, el reloj del log
+ *              binario, así que las latencias no dependen de leer el log
+ *              a tiempo. Backends:
+ *              - sysfs:   archivo hwmon falso (canal primario por pread())
+ *              - sensors: comando 'sensors' falso en el PATH del daemon
+ *                         (sin hwmon, el daemon usa get_cpu_temp())
+ *              - real:    /sys y calor real; el umbral es la temperatura
+ *                         inicial más -D grados
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage cpu_detect_bench [-n pruebas] [-i ms,ms...] [-b backend,...]
+ *                         [-d cpu_daemon] [-s cpu_stressor] [-D grados]
+ *                         [-w directorio]
+ */
+
+#define _GNU_SOURCE     // Para mkdtemp(), setenv() con PATH ampliado
+
+#include <stdio.h>      // Para FILE, fprintf(), snprintf()
+#include <stdlib.h>     // Para strtoul(), qsort(), mkdtemp(), rand_r()
+#include <string.h>     // Para strcmp(), strtok_r(), strerror()
+#include <errno.h>      // Para errno
+#include <time.h>       // Para nanosleep()
+#include <unistd.h>     // Para fork(), execv(), getopt()
+#include <fcntl.h>      // Para open() y constantes O_*
+#include <signal.h>     // Para kill()
+#include <limits.h>     // Para PATH_MAX
+#include <libgen.h>     // Para dirname()
+#include <sys/stat.h>   // Para mkdir(), chmod()
+#include <sys/wait.h>   // Para waitpid()
+#include "binlog.h"       // Para binlog_read() y los tipos de registro
+#include "selfstat.h"     // Para selfstat_now() y STAGE_NOTIFY
+#include "temp_monitor.h" // Para leer la temperatura inicial del backend real
+
+// Pruebas máximas por combinación
+#define BENCH_MAX_TRIALS 1000
+
+// Temperaturas del sensor falso en °C
+#define BENCH_COOL_C 40.0
+#define BENCH_HOT_C 80.0
+#define BENCH_THRESHOLD_C 60.0
+
+// Espera máxima del arranque del daemon y de cada detección o enfriamiento
+#define BENCH_START_TIMEOUT_S 10
+#define BENCH_FAKE_TIMEOUT_S 10
+#define BENCH_REAL_TIMEOUT_S 120
+
+/**
+ * @brief Backends de sensores
+ */
+typedef enum {
+    BACKEND_SYSFS,
+    BACKEND_SENSORS,
+    BACKEND_REAL,
+    BACKEND_COUNT
+} bench_backend;
+
+// Nombres de los backends (mismo orden que bench_backend)
+static const char *const backend_names[BACKEND_COUNT] = {"sysfs", "sensors", "real"};
+
+/**
+ * @brief Una combinación de backend e intervalo con su daemon
+ */
+typedef struct {
+    bench_backend backend;
+    unsigned interval_ms;
+    double threshold;          // Umbral configurado en °C
+    char dir[PATH_MAX];        // Directorio de trabajo de la combinación
+    char temp_path[PATH_MAX + 64]; // Valor del sensor falso ("" = backend real)
+    pid_t daemon;              // cpu_daemon -f
+    FILE *binlog;              // Lector incremental del log binario
+} bench_run;
+
+/**
+ * @brief Marcas de una prueba (CLOCK_MONOTONIC, ns)
+ */
+typedef struct {
+    uint64_t load_ns;          // Arranque de la carga
+    uint64_t sample_ns;        // Primera muestra sobre el umbral
+    uint64_t dispatch_ns;      // Fin del despacho de la alerta
+} bench_trial;
+
+/**
+ * @brief Duerme unos milisegundos
+ */
+static void sleep_ms(unsigned ms) {
+    struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief Crea un archivo con el contenido dado
+ * @return int 0 si éxito, -1 si error
+ */
+static int write_file(const char *path, const char *text) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        return -1;
+    }
+    fputs(text, f);
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/**
+ * @brief Fija la temperatura del sensor falso
+ * @description El archivo se reescribe en su sitio (mismo inodo): el daemon
+ *              lee el canal hwmon con pread() sobre un descriptor abierto.
+ */
+static void set_fake_temp(const bench_run *r, double celsius) {
+    char text[32];
+    int len = r->backend == BACKEND_SYSFS
+              ? snprintf(text, sizeof(text), "%d\n", (int)(celsius * 1000.0))
+              : snprintf(text, sizeof(text), "%.1f\n", celsius);
+    int fd = open(r->temp_path, O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return;
+    }
+    if (pwrite(fd, text, (size_t)len, 0) == len) {
+        ftruncate(fd, len);
+    }
+    close(fd);
+}
+
+/**
+ * @brief Prepara el directorio, el sensor falso y la configuración
+ * @return int 0 si éxito, -1 si error
+ */
+static int setup_run(bench_run *r, const char *base) {
+    char path[PATH_MAX + 64], text[PATH_MAX * 4];
+    const char *sysfs_root = "/sys";
+
+    snprintf(r->dir, sizeof(r->dir), "%s/%s-%u", base, backend_names[r->backend], r->interval_ms);
+    if (mkdir(r->dir, 0755) < 0 && errno != EEXIST) {
+        return -1;
+    }
+    r->temp_path[0] = '\0';
+
+    if (r->backend == BACKEND_SYSFS) {
+        // Un dispositivo coretemp con "Package id 0" como canal primario
+        static const char *const dirs[] = {"sys", "sys/class", "sys/class/hwmon", "sys/class/hwmon/hwmon0"};
+        for (size_t i = 0; i < sizeof(dirs) / sizeof(dirs[0]); i++) {
+            snprintf(path, sizeof(path), "%s/%s", r->dir, dirs[i]);
+            mkdir(path, 0755);
+        }
+        snprintf(path, sizeof(path), "%s/sys/class/hwmon/hwmon0/name", r->dir);
+        write_file(path, "coretemp\n");
+        snprintf(path, sizeof(path), "%s/sys/class/hwmon/hwmon0/temp1_label", r->dir);
+        write_file(path, "Package id 0\n");
+        snprintf(r->temp_path, sizeof(r->temp_path), "%s/sys/class/hwmon/hwmon0/temp1_input", r->dir);
+    } else if (r->backend == BACKEND_SENSORS) {
+        // Sin hwmon: el daemon recurre al comando 'sensors' del PATH
+        snprintf(path, sizeof(path), "%s/sys", r->dir);
+        mkdir(path, 0755);
+        snprintf(path, sizeof(path), "%s/bin", r->dir);
+        mkdir(path, 0755);
+        snprintf(r->temp_path, sizeof(r->temp_path), "%s/temp", r->dir);
+        snprintf(text, sizeof(text),
+                 "#!/bin/sh\n"
+                 "printf 'coretemp-isa-0000\\nAdapter: ISA adapter\\n"
+                 "Package id 0:  +%%s°C  (high = +80.0°C, crit = +100.0°C)\\n' \"$(cat '%s')\"\n",
+                 r->temp_path);
+        snprintf(path, sizeof(path), "%s/bin/sensors", r->dir);
+        if (write_file(path, text) < 0 || chmod(path, 0755) < 0) {
+            return -1;
+        }
+    }
+    if (r->temp_path[0] != '\0') {
+        static char fake_root[PATH_MAX + 8];
+        snprintf(fake_root, sizeof(fake_root), "%s/sys", r->dir);
+        sysfs_root = fake_root;
+        r->threshold = BENCH_THRESHOLD_C;
+        set_fake_temp(r, BENCH_COOL_C);
+    }
+
+    // Registro de estado e instantánea desactivados: solo el log binario
+    snprintf(text, sizeof(text),
+             "interval_ms = %u\n"
+             "temp_threshold = %.1f\n"
+             "log_path = %s/daemon.log\n"
+             "binlog_path = %s/daemon.bin\n"
+             "snapshot_path =\n"
+             "status_path =\n"
+             "sysfs_root = %s\n",
+             r->interval_ms, r->threshold, r->dir, r->dir, sysfs_root);
+    snprintf(path, sizeof(path), "%s/daemon.conf", r->dir);
+    return write_file(path, text);
+}
+
+/**
+ * @brief Lanza un programa con stdout y stderr redirigidos a un archivo
+ * @param path_prefix Directorio a anteponer al PATH (NULL = ninguno)
+ * @return pid_t PID del hijo, -1 si error
+ */
+static pid_t spawn(char *const argv[], const char *out_path, const char *path_prefix) {
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+
+    int fd = open(out_path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd >= 0) {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+    if (path_prefix != NULL) {
+        char path[PATH_MAX * 2];
+        const char *old = getenv("PATH");
+        snprintf(path, sizeof(path), "%s:%s", path_prefix, old ? old : "/usr/bin:/bin");
+        setenv("PATH", path, 1);
+    }
+    execv(argv[0], argv);
+    _exit(127);
+}
+
+/**
+ * @brief Lee el siguiente registro completo del log binario del daemon
+ * @description Al final del archivo (o ante un registro a medio escribir)
+ *              vuelve a la posición anterior para reintentar más tarde.
+ *
+ * @return int 1 si se leyó un registro, 0 si aún no hay más
+ */
+static int next_record(bench_run *r, binlog_record *rec) {
+    if (r->binlog == NULL) {
+        char path[PATH_MAX + 16];
+        snprintf(path, sizeof(path), "%s/daemon.bin", r->dir);
+        r->binlog = fopen(path, "rb");
+        if (r->binlog == NULL) {
+            return 0;
+        }
+    }
+    long pos = ftell(r->binlog);
+    if (binlog_read(r->binlog, rec) > 0) {
+        return 1;
+    }
+    clearerr(r->binlog);
+    fseek(r->binlog, pos, SEEK_SET);
+    return 0;
+}
+
+/**
+ * @brief Espera una muestra posterior a un instante que cumpla una condición
+ *
+ * @param after_ns Solo cuentan las muestras posteriores
+ * @param hot      1 = sobre el umbral, 0 = bajo el umbral
+ * @param timeout_s Espera máxima
+ *
+ * @return uint64_t Marca de la muestra, 0 si venció la espera
+ */
+static uint64_t wait_sample(bench_run *r, uint64_t after_ns, int hot, unsigned timeout_s) {
+    uint64_t deadline = selfstat_now() + (uint64_t)timeout_s * 1000000000ull;
+    int32_t threshold_milli = (int32_t)(r->threshold * 1000.0);
+    binlog_record rec;
+
+    while (selfstat_now() < deadline) {
+        if (!next_record(r, &rec)) {
+            sleep_ms(1);
+            continue;
+        }
+        if (rec.hdr.type != BINLOG_SAMPLE || rec.hdr.ts_ns < after_ns) {
+            continue;
+        }
+        binlog_sample s;
+        memcpy(&s, rec.payload, sizeof(s));
+        if ((s.milli >= threshold_milli) == hot) {
+            return rec.hdr.ts_ns;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Espera el fin del despacho de la primera alerta posterior a un instante
+ * @description El registro BINLOG_ALERT se escribe antes de llamar a
+ *              send_notification(); el span de la etapa notify que le sigue
+ *              marca cuándo terminó el despacho.
+ *
+ * @return uint64_t Fin del despacho, 0 si venció la espera
+ */
+static uint64_t wait_dispatch(bench_run *r, uint64_t after_ns, unsigned timeout_s) {
+    uint64_t deadline = selfstat_now() + (uint64_t)timeout_s * 1000000000ull;
+    binlog_record rec;
+
+    while (selfstat_now() < deadline) {
+        if (!next_record(r, &rec)) {
+            sleep_ms(1);
+            continue;
+        }
+        if (rec.hdr.type != BINLOG_SPAN || rec.hdr.ts_ns < after_ns) {
+            continue;
+        }
+        binlog_span s;
+        memcpy(&s, rec.payload, sizeof(s));
+        if (s.stage == STAGE_NOTIFY) {
+            return rec.hdr.ts_ns + s.dur_ns;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Arranca el daemon de una combinación y espera su primera muestra
+ * @return int 0 si éxito, -1 si no arrancó
+ */
+static int start_daemon(bench_run *r, const char *daemon_path) {
+    char conf[PATH_MAX + 16], out[PATH_MAX + 16], bin[PATH_MAX + 8];
+    snprintf(conf, sizeof(conf), "%s/daemon.conf", r->dir);
+    snprintf(out, sizeof(out), "%s/daemon.out", r->dir);
+    snprintf(bin, sizeof(bin), "%s/bin", r->dir);
+
+    char *argv[] = {(char *)daemon_path, "-f", "-c", conf, NULL};
+    r->daemon = spawn(argv, out, r->backend == BACKEND_SENSORS ? bin : NULL);
+    if (r->daemon < 0) {
+        return -1;
+    }
+    r->binlog = NULL;
+    return wait_sample(r, 0, 0, BENCH_START_TIMEOUT_S) != 0 ? 0 : -1;
+}
+
+/**
+ * @brief Para el daemon de una combinación
+ */
+static void stop_daemon(bench_run *r) {
+    if (r->daemon > 0) {
+        kill(r->daemon, SIGTERM);
+        waitpid(r->daemon, NULL, 0);
+        r->daemon = -1;
+    }
+    if (r->binlog != NULL) {
+        fclose(r->binlog);
+        r->binlog = NULL;
+    }
+}
+
+/**
+ * @brief Ejecuta una prueba: escalón de carga, detección y enfriamiento
+ * @return int 0 si se midieron ambas latencias, -1 si alguna venció
+ */
+static int run_trial(bench_run *r, const char *stressor_path, unsigned *seed, bench_trial *t) {
+    unsigned timeout = r->temp_path[0] != '\0' ? BENCH_FAKE_TIMEOUT_S : BENCH_REAL_TIMEOUT_S;
+    char out[PATH_MAX + 16];
+    snprintf(out, sizeof(out), "%s/stressor.out", r->dir);
+
+    // Desfase aleatorio respecto al timer del daemon
+    sleep_ms((unsigned)(rand_r(seed) % r->interval_ms));
+
+    char *argv[] = {(char *)stressor_path, "-i", "0", NULL};
+    pid_t stressor = spawn(argv, out, NULL);
+    t->load_ns = selfstat_now();
+    if (r->temp_path[0] != '\0') {
+        set_fake_temp(r, BENCH_HOT_C);
+    }
+
+    t->sample_ns = wait_sample(r, t->load_ns, 1, timeout);
+    t->dispatch_ns = t->sample_ns ? wait_dispatch(r, t->sample_ns, timeout) : 0;
+
+    // Fin de la carga y enfriamiento: la alerta se rearma con una muestra fría
+    if (stressor > 0) {
+        kill(stressor, SIGTERM);
+        waitpid(stressor, NULL, 0);
+    }
+    uint64_t cool_ns = selfstat_now();
+    if (r->temp_path[0] != '\0') {
+        set_fake_temp(r, BENCH_COOL_C);
+    }
+    wait_sample(r, cool_ns, 0, timeout);
+
+    return t->sample_ns && t->dispatch_ns ? 0 : -1;
+}
+
+/**
+ * @brief Comparador de latencias para qsort()
+ */
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * @brief Percentil de un arreglo ordenado, en milisegundos
+ */
+static double percentile_ms(const uint64_t *v, int n, double pct) {
+    int i = (int)(pct / 100.0 * (n - 1) + 0.5);
+    return v[i] / 1e6;
+}
+
+/**
+ * @brief Escribe la distribución de una latencia
+ */
+static void print_dist(uint64_t *v, int n) {
+    qsort(v, (size_t)n, sizeof(v[0]), cmp_u64);
+    printf(" %8.1f %8.1f %8.1f %8.1f", v[0] / 1e6, percentile_ms(v, n, 50.0),
+           percentile_ms(v, n, 90.0), v[n - 1] / 1e6);
+}
+
+/**
+ * @brief Ejecuta todas las pruebas de una combinación y escribe su fila
+ */
+static void bench_combination(bench_run *r, const char *daemon_path, const char *stressor_path,
+                              int trials, unsigned *seed) {
+    static uint64_t sample[BENCH_MAX_TRIALS], alert[BENCH_MAX_TRIALS];
+    int ok = 0, failed = 0;
+
+    if (start_daemon(r, daemon_path) < 0) {
+        fprintf(stderr, "cpu_detect_bench: %s %u ms: daemon did not start (see %s/daemon.out)\n",
+                backend_names[r->backend], r->interval_ms, r->dir);
+        stop_daemon(r);
+        return;
+    }
+    for (int i = 0; i < trials; i++) {
+        bench_trial t;
+        if (run_trial(r, stressor_path, seed, &t) < 0) {
+            failed++;
+            continue;
+        }
+        sample[ok] = t.sample_ns - t.load_ns;
+        alert[ok] = t.dispatch_ns - t.load_ns;
+        ok++;
+    }
+    stop_daemon(r);
+
+    printf("%-8s %6u %4d %4d", backend_names[r->backend], r->interval_ms, ok, failed);
+    if (ok > 0) {
+        print_dist(sample, ok);
+        print_dist(alert, ok);
+    }
+    putchar('\n');
+    fflush(stdout);
+}
+
+/**
+ * @brief Temperatura actual del canal primario de /sys
+ * @return double °C, o -1 si no hay un sensor legible
+ */
+static double real_temp(void) {
+    static sensor_table t;
+    if (sensors_discover(&t, "/sys") <= 0 || t.primary < 0) {
+        return -1.0;
+    }
+    sensors_open(&t);
+    double temp = sensors_read(&t, t.primary, NULL);
+    sensors_close(&t);
+    return temp;
+}
+
+/**
+ * @brief Muestra la ayuda de línea de comandos
+ */
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [-n pruebas] [-i ms,ms...] [-b backend,...] [-d cpu_daemon]\n"
+            "       [-s cpu_stressor] [-D grados] [-w directorio]\n"
+            "  -n pruebas     Pruebas por combinación (por defecto, 10)\n"
+            "  -i ms,...      Intervalos de muestreo (por defecto, 100,500,1000)\n"
+            "  -b backend,... sysfs, sensors y/o real (por defecto, sysfs,sensors)\n"
+            "  -d, -s         Ejecutables (por defecto, junto a este programa)\n"
+            "  -D grados      Umbral del backend real sobre la temperatura inicial\n"
+            "                 (por defecto, 5)\n"
+            "  -w directorio  Directorio de trabajo (por defecto, uno nuevo en /tmp)\n",
+            prog);
+}
+
+/**
+ * @brief Función principal del banco de pruebas
+ * @description Escribe una fila por combinación con las latencias desde el
+ *              escalón de carga hasta la primera muestra sobre el umbral y
+ *              hasta el fin del despacho de la alerta, en milisegundos.
+ *
+ * @return int 0 si éxito, 1 si los argumentos no son válidos
+ */
+int main(int argc, char *argv[]) {
+    char daemon_path[PATH_MAX], stressor_path[PATH_MAX], base[PATH_MAX];
+    char intervals[256] = "100,500,1000", backends[64] = "sysfs,sensors";
+    int trials = 10;
+    double delta = 5.0;
+    char *end;
+    int opt;
+
+    // Por defecto, los ejecutables del mismo directorio de compilación
+    char self[PATH_MAX];
+    snprintf(self, sizeof(self), "%s", argv[0]);
+    const char *bindir = dirname(self);
+    snprintf(daemon_path, sizeof(daemon_path), "%s/cpu_daemon", bindir);
+    snprintf(stressor_path, sizeof(stressor_path), "%s/cpu_stressor", bindir);
+    base[0] = '\0';
+
+    while ((opt = getopt(argc, argv, "n:i:b:d:s:D:w:h")) != -1) {
+        switch (opt) {
+            case 'n':
+                trials = (int)strtol(optarg, &end, 10);
+                if (*end != '\0' || trials <= 0 || trials > BENCH_MAX_TRIALS) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'i':
+                snprintf(intervals, sizeof(intervals), "%s", optarg);
+                break;
+            case 'b':
+                snprintf(backends, sizeof(backends), "%s", optarg);
+                break;
+            case 'd':
+                snprintf(daemon_path, sizeof(daemon_path), "%s", optarg);
+                break;
+            case 's':
+                snprintf(stressor_path, sizeof(stressor_path), "%s", optarg);
+                break;
+            case 'D':
+                delta = strtod(optarg, &end);
+                if (*end != '\0' || delta <= 0.0) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'w':
+                snprintf(base, sizeof(base), "%s", optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    // Las rutas se pasan a procesos hijos: convertirlas en absolutas
+    char resolved[PATH_MAX];
+    if (realpath(daemon_path, resolved) == NULL || access(resolved, X_OK) < 0) {
+        fprintf(stderr, "cpu_detect_bench: %s: not executable\n", daemon_path);
+        return 1;
+    }
+    snprintf(daemon_path, sizeof(daemon_path), "%s", resolved);
+    if (realpath(stressor_path, resolved) == NULL || access(resolved, X_OK) < 0) {
+        fprintf(stderr, "cpu_detect_bench: %s: not executable\n", stressor_path);
+        return 1;
+    }
+    snprintf(stressor_path, sizeof(stressor_path), "%s", resolved);
+    if (base[0] == '\0') {
+        snprintf(base, sizeof(base), "%s", "/tmp/cpu_detect_bench.XXXXXX");
+        if (mkdtemp(base) == NULL) {
+            perror("mkdtemp");
+            return 1;
+        }
+    } else if (mkdir(base, 0755) < 0 && errno != EEXIST) {
+        perror(base);
+        return 1;
+    }
+    fprintf(stderr, "cpu_detect_bench: %d trials per combination, logs in %s\n", trials, base);
+
+    unsigned seed = (unsigned)selfstat_now();
+    printf("# backend interval_ms ok failed"
+           " sample_min_ms sample_p50_ms sample_p90_ms sample_max_ms"
+           " alert_min_ms alert_p50_ms alert_p90_ms alert_max_ms\n");
+
+    char *save_b;
+    for (char *b = strtok_r(backends, ",", &save_b); b; b = strtok_r(NULL, ",", &save_b)) {
+        int backend = -1;
+        for (int i = 0; i < BACKEND_COUNT; i++) {
+            if (strcmp(b, backend_names[i]) == 0) {
+                backend = i;
+            }
+        }
+        if (backend < 0) {
+            fprintf(stderr, "cpu_detect_bench: unknown backend %s\n", b);
+            continue;
+        }
+
+        double threshold = 0.0;
+        if (backend == BACKEND_REAL) {
+            double temp = real_temp();
+            if (temp < 0.0) {
+                fprintf(stderr, "cpu_detect_bench: real: no readable hwmon sensor, skipped\n");
+                continue;
+            }
+            threshold = temp + delta;
+        }
+
+        char list[sizeof(intervals)];
+        char *save_i;
+        snprintf(list, sizeof(list), "%s", intervals);
+        for (char *s = strtok_r(list, ",", &save_i); s; s = strtok_r(NULL, ",", &save_i)) {
+            unsigned long ms = strtoul(s, &end, 10);
+            if (*end != '\0' || ms == 0) {
+                fprintf(stderr, "cpu_detect_bench: invalid interval %s\n", s);
+                continue;
+            }
+            bench_run r = {.backend = (bench_backend)backend, .interval_ms = (unsigned)ms,
+                           .threshold = threshold, .daemon = -1};
+            if (setup_run(&r, base) < 0) {
+                fprintf(stderr, "cpu_detect_bench: %s: %s\n", r.dir, strerror(errno));
+                continue;
+            }
+            bench_combination(&r, daemon_path, stressor_path, trials, &seed);
+        }
+    }
+    return 0;
+}
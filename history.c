@@ -0,0 +1,109 @@
+/**
+ * @brief Módulo de historial de temperaturas en memoria
+ * @description Implementa las ventanas deslizantes por segundo, el histograma
+ *              acumulado y el seguimiento del estado de alerta. No reserva
+ *              memoria dinámica: todo vive dentro de temp_history.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <string.h>    // Para memset()
+#include "history.h"   // Header con declaraciones del módulo de historial
+
+/**
+ * @brief Inicializa un historial vacío
+ */
+void history_init(temp_history *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+/**
+ * @brief Registra una muestra de temperatura en el historial
+ * @description Si la ranura del segundo actual contiene datos de una vuelta
+ *              anterior del anillo, se reinicia antes de acumular.
+ */
+void history_add(temp_history *h, time_t now, float temp) {
+    if (temp < 0) {
+        // Lectura fallida: no contamina los agregados
+        return;
+    }
+
+    history_slot *s = &h->slots[(uint64_t)now % HISTORY_WINDOW_S];
+    if (s->sec != (int64_t)now) {
+        s->sec = now;
+        s->sum = 0;
+        s->max = temp;
+        s->count = 0;
+    }
+    s->sum += temp;
+    if (temp > s->max) {
+        s->max = temp;
+    }
+    s->count++;
+
+    int bucket = (int)temp;
+    if (bucket >= HISTORY_HIST_BUCKETS) {
+        bucket = HISTORY_HIST_BUCKETS - 1;
+    }
+    h->hist[bucket]++;
+    h->samples++;
+}
+
+/**
+ * @brief Actualiza el estado de alerta tras evaluar el umbral
+ * @description Un episodio de alerta empieza con la primera muestra sobre el
+ *              umbral y termina con la primera muestra por debajo.
+ */
+void history_alert(temp_history *h, time_t now, int over) {
+    if (over) {
+        if (h->alert_since == 0) {
+            h->alert_since = now;
+            h->alert_count++;
+        }
+        h->last_alert = now;
+    } else {
+        h->alert_since = 0;
+    }
+}
+
+/**
+ * @brief Recorre las ranuras vigentes de la ventana y devuelve media o máximo
+ */
+static float window_scan(const temp_history *h, time_t now, unsigned seconds, int want_max) {
+    float sum = 0, max = -1;
+    uint32_t count = 0;
+
+    if (seconds > HISTORY_WINDOW_S) {
+        seconds = HISTORY_WINDOW_S;
+    }
+
+    for (unsigned i = 0; i < HISTORY_WINDOW_S; i++) {
+        const history_slot *s = &h->slots[i];
+        if (s->count == 0 || s->sec > (int64_t)now || s->sec <= (int64_t)now - (int64_t)seconds) {
+            continue;
+        }
+        sum += s->sum;
+        count += s->count;
+        if (s->max > max) {
+            max = s->max;
+        }
+    }
+
+    if (count == 0) {
+        return -1;
+    }
+    return want_max ? max : sum / (float)count;
+}
+
+/**
+ * @brief Temperatura media de los últimos @p seconds segundos
+ */
+float history_window_avg(const temp_history *h, time_t now, unsigned seconds) {
+    return window_scan(h, now, seconds, 0);
+}
+
+/**
+ * @brief Temperatura máxima de los últimos @p seconds segundos
+ */
+float history_window_max(const temp_history *h, time_t now, unsigned seconds) {
+    return window_scan(h, now, seconds, 1);
+}
@@ -0,0 +1,87 @@
+/**
+ * @brief Header del módulo de historial de temperaturas en memoria
+ * @description Define los agregados que el daemon mantiene entre muestras:
+ *              ventanas deslizantes de hasta 15 minutos, histograma de
+ *              temperaturas y estado de alerta. La estructura es de tamaño
+ *              fijo y sin punteros para poder guardarla y restaurarla
+ *              directamente en la instantánea de reinicio en caliente.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef HISTORY_H  // Si HISTORY_H no está definido
+#define HISTORY_H  // Definir HISTORY_H como macro de protección
+
+#include <stdint.h>  // Para uint32_t, int64_t
+#include <time.h>    // Para time_t
+
+// Ventana máxima del historial: 15 minutos con resolución de 1 segundo
+#define HISTORY_WINDOW_S 900
+
+// Histograma de temperaturas: cubetas de 1 °C entre 0 y 127 °C
+#define HISTORY_HIST_BUCKETS 128
+
+/**
+ * @brief Resumen de las muestras recibidas durante un segundo
+ */
+typedef struct {
+    int64_t sec;     // Segundo (tiempo Unix) al que pertenece la ranura
+    float sum;       // Suma de temperaturas de ese segundo
+    float max;       // Temperatura máxima de ese segundo
+    uint32_t count;  // Número de muestras de ese segundo
+} history_slot;
+
+/**
+ * @brief Agregados en memoria del daemon
+ * @description Las ranuras forman un anillo indexado por segundo Unix módulo
+ *              HISTORY_WINDOW_S; una ranura con un segundo antiguo se
+ *              considera vacía. Así las ventanas son independientes del
+ *              intervalo de muestreo y sobreviven a un reinicio.
+ */
+typedef struct {
+    history_slot slots[HISTORY_WINDOW_S];      // Anillo de 15 minutos
+    uint32_t hist[HISTORY_HIST_BUCKETS];       // Histograma acumulado de temperaturas
+    uint64_t samples;                          // Total de muestras registradas
+    int64_t alert_since;                       // Inicio de la alerta activa (0 = sin alerta)
+    int64_t last_alert;                        // Última notificación enviada
+    uint32_t alert_count;                      // Número de episodios de alerta
+} temp_history;
+
+/**
+ * @brief Inicializa un historial vacío
+ */
+void history_init(temp_history *h);
+
+/**
+ * @brief Registra una muestra de temperatura en el historial
+ *
+ * @param h    Historial
+ * @param now  Tiempo Unix de la muestra
+ * @param temp Temperatura en °C (las lecturas negativas se ignoran)
+ */
+void history_add(temp_history *h, time_t now, float temp);
+
+/**
+ * @brief Actualiza el estado de alerta tras evaluar el umbral
+ *
+ * @param h    Historial
+ * @param now  Tiempo Unix de la evaluación
+ * @param over 1 si la muestra supera el umbral, 0 si no
+ */
+void history_alert(temp_history *h, time_t now, int over);
+
+/**
+ * @brief Temperatura media de los últimos @p seconds segundos
+ *
+ * @return float Media en °C, o -1.0 si no hay muestras en la ventana
+ */
+float history_window_avg(const temp_history *h, time_t now, unsigned seconds);
+
+/**
+ * @brief Temperatura máxima de los últimos @p seconds segundos
+ *
+ * @return float Máximo en °C, o -1.0 si no hay muestras en la ventana
+ */
+float history_window_max(const temp_history *h, time_t now, unsigned seconds);
+
+#endif // HISTORY_H - Fin de las guardas de inclusión
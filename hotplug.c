@@ -0,0 +1,96 @@
+/**
+ * @brief Módulo de eventos de hotplug basado en netlink
+ * @description Recibe los uevents del kernel por NETLINK_KOBJECT_UEVENT y
+ *              extrae las altas y bajas de dispositivos hwmon. Un uevent es
+ *              una cabecera "acción@devpath" seguida de pares CLAVE=valor
+ *              separados por '\0'.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdio.h>             // Para snprintf()
+#include <string.h>            // Para memset(), strcmp(), strncmp(), strrchr()
+#include <unistd.h>            // Para close()
+#include <errno.h>             // Para errno, EAGAIN, ENOBUFS
+#include <sys/socket.h>        // Para socket(), bind(), recvmsg(), setsockopt()
+#include <linux/netlink.h>     // Para sockaddr_nl, NETLINK_KOBJECT_UEVENT
+#include "hotplug.h"           // Header con declaraciones del módulo
+
+// Grupo multicast de los uevents emitidos directamente por el kernel
+#define UEVENT_GROUP_KERNEL 1
+
+/**
+ * @brief Abre el socket de uevents del kernel
+ */
+int hotplug_open(void) {
+    int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (fd < 0) {
+        return -1;
+    }
+
+    // Una ráfaga de uevents (carga de un módulo, reanudación) desborda el
+    // búfer por defecto. SO_RCVBUFFORCE ignora rmem_max pero exige
+    // CAP_NET_ADMIN; sin ella queda SO_RCVBUF, limitado por rmem_max
+    int size = HOTPLUG_RCVBUF;
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) < 0) {
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    }
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = UEVENT_GROUP_KERNEL;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Lee el siguiente evento hwmon pendiente
+ */
+int hotplug_next(int fd, hotplug_event *ev) {
+    char buf[4096];
+
+    for (;;) {
+        struct sockaddr_nl src;
+        struct iovec iov = {.iov_base = buf, .iov_len = sizeof(buf) - 1};
+        struct msghdr msg = {.msg_name = &src, .msg_namelen = sizeof(src), .msg_iov = &iov, .msg_iovlen = 1};
+
+        ssize_t n = recvmsg(fd, &msg, MSG_DONTWAIT);
+        if (n < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+        }
+        // Solo mensajes del kernel (nl_pid 0), no de otros procesos
+        if (src.nl_pid != 0 || (msg.msg_flags & MSG_TRUNC)) {
+            continue;
+        }
+        buf[n] = '\0';
+
+        const char *action = NULL, *devpath = NULL, *subsystem = NULL;
+        for (const char *p = buf; p < buf + n; p += strlen(p) + 1) {
+            if (strncmp(p, "ACTION=", 7) == 0) {
+                action = p + 7;
+            } else if (strncmp(p, "DEVPATH=", 8) == 0) {
+                devpath = p + 8;
+            } else if (strncmp(p, "SUBSYSTEM=", 10) == 0) {
+                subsystem = p + 10;
+            }
+        }
+        if (!action || !devpath || !subsystem || strcmp(subsystem, "hwmon") != 0) {
+            continue;
+        }
+
+        if (strcmp(action, "add") == 0) {
+            ev->action = HOTPLUG_ADD;
+        } else if (strcmp(action, "remove") == 0) {
+            ev->action = HOTPLUG_REMOVE;
+        } else {
+            continue;
+        }
+
+        const char *name = strrchr(devpath, '/');
+        snprintf(ev->name, sizeof(ev->name), "%s", name ? name + 1 : devpath);
+        return 1;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @brief Header del módulo de eventos de hotplug (uevents del kernel)
+ * @description Define la interfaz para escuchar en un socket netlink
+ *              NETLINK_KOBJECT_UEVENT los eventos de alta y baja de
+ *              dispositivos hwmon. Tras recargar un driver o volver de una
+ *              suspensión, un dispositivo puede reaparecer con otro número
+ *              hwmonN; con estos eventos el daemon actualiza solo la parte
+ *              afectada de la tabla de sensores, sin recorrer sysfs en cada
+ *              ciclo. El descriptor se atiende desde el mismo poll() que el
+ *              temporizador y las señales.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef HOTPLUG_H  // Si HOTPLUG_H no está definido
+#define HOTPLUG_H  // Definir HOTPLUG_H como macro de protección
+
+// Longitud máxima del nombre del dispositivo ("hwmon12")
+#define HOTPLUG_NAME_LEN 32
+
+// Búfer de recepción pedido para el socket (bytes)
+#define HOTPLUG_RCVBUF (1024 * 1024)
+
+/**
+ * @brief Acción de un evento de hotplug
+ */
+typedef enum {
+    HOTPLUG_ADD,     // Dispositivo registrado
+    HOTPLUG_REMOVE   // Dispositivo retirado
+} hotplug_action;
+
+/**
+ * @brief Evento de alta o baja de un dispositivo hwmon
+ */
+typedef struct {
+    hotplug_action action;
+    char name[HOTPLUG_NAME_LEN];   // Último componente de DEVPATH ("hwmon3")
+} hotplug_event;
+
+/**
+ * @brief Abre el socket de uevents del kernel
+ * @description Socket netlink no bloqueante suscrito al grupo de uevents
+ *              del kernel (no al de udev, que puede no existir), con un
+ *              búfer de recepción de HOTPLUG_RCVBUF bytes.
+ *
+ * @return int Descriptor (>= 0) o -1 si hubo un error
+ */
+int hotplug_open(void);
+
+/**
+ * @brief Lee el siguiente evento hwmon pendiente
+ * @description Descarta los mensajes que no vienen del kernel y los de
+ *              otros subsistemas o acciones (change, bind...).
+ *
+ * @param fd Descriptor devuelto por hotplug_open()
+ * @param ev Evento leído
+ *
+ * @return int 1 si se leyó un evento, 0 si no hay más pendientes, -1 si error.
+ *             Con errno == ENOBUFS el búfer se desbordó y se perdieron
+ *             eventos: el socket sigue siendo válido, pero la tabla de
+ *             sensores debe reconstruirse con un recorrido completo.
+ */
+int hotplug_next(int fd, hotplug_event *ev);
+
+#endif // HOTPLUG_H - Fin de las guardas de inclusión
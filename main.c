@@ -1,76 +1,1225 @@
 /**
  * @brief Daemon de monitoreo de temperatura de CPU
- * @description Este programa implementa un daemon que monitorea continuamente 
- *              la temperatura del CPU, registra las lecturas en un archivo de 
- *              log y envía notificaciones cuando la temperatura excede el umbral
+ * @description Este programa implementa un daemon que monitorea continuamente
+ *              la temperatura del CPU, registra las lecturas en un archivo de
+ *              log y envía notificaciones cuando la temperatura excede el umbral.
+ *              El bucle principal es un bucle de eventos (poll) sobre un timerfd
+ *              de muestreo y un signalfd de control: SIGTERM/SIGINT provocan un
+ *              apagado ordenado con plazo máximo y SIGHUP recarga la
+ *              configuración y reabre el log sin interrumpir el muestreo.
  * @author Sistema de monitoreo CPU
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
 #include <unistd.h>
 #include <time.h>
+#include <poll.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <sys/timerfd.h>
 #include "daemon.h"
+#include "config.h"
+#include "signals.h"
 #include "temp_monitor.h"
 #include "notifier.h"
+#include "history.h"
+#include "snapshot.h"
+#include "selfstat.h"
+#include "probes.h"
+#include "binlog.h"
+#include "proc_top.h"
+#include "cgroup_stat.h"
+#include "cpu_counters.h"
+#include "series.h"
+#include "throttle.h"
+#include "power.h"
+#include "psi.h"
+#include "pmu.h"
+#include "topology.h"
+#include "hotplug.h"
+#include "stress_link.h"
+#include "acquire.h"
 
-// Configuración del daemon
-#define INTERVAL 5          // Intervalo de monitoreo en segundos
-#define TEMP_THRESHOLD 65.0 // Umbral de temperatura crítica en grados Celsius
+/**
+ * @brief Estado en ejecución del daemon
+ * @description Agrupa todo lo que el bucle de eventos necesita entre
+ *              muestras. history y sensors son estructuras planas que se
+ *              guardan en la instantánea de reinicio en caliente.
+ */
+typedef struct {
+    daemon_config cfg;      // Configuración activa
+    FILE *log;              // Archivo de log abierto
+    int tfd;                // timerfd de muestreo
+    int ufd;                // Socket de uevents de hwmon (-1 = sin hotplug)
+    sensor_table sensors;   // Canales de temperatura descubiertos
+    temp_history history;   // Ventanas, histograma y estado de alerta
+    time_t last_snapshot;   // Último guardado periódico de la instantánea
+    self_stats stats;       // Latencias por etapa y contadores internos
+    binlog_writer binlog;   // Log binario de muestras, alertas y etapas
+    proc_table procs;       // Tiempo de CPU por proceso (atribución de alertas)
+    int procs_ready;        // 1 si procs está inicializada
+    cgroup_set cgroups;     // Consumo de CPU y throttling por cgroup
+    cpu_counters counters;  // Utilización, frecuencia y throttling por CPU
+    sample_series series;   // Registros de temperatura y contadores por ciclo
+    throttle_detector throttle; // Episodios de throttling y resúmenes por hora
+    power_set power;        // Zonas de energía RAPL / powercap
+    psi_set psi;            // Presión de cpu, memory e io
+    pmu_set pmu;            // Grupos perf_event por CPU (perf_counters = 1)
+    topology topo;          // Núcleos, CCDs, paquetes y nodos NUMA
+    stress_link stress;     // Contadores de trabajo de cpu_stressor
+    acquire acq;            // Lote de lecturas de sysfs y /proc de cada ciclo
+    int acq_dirty;          // 1 = volver a registrar los descriptores antes del lote
+    uint8_t stale[SENSOR_MAX_CHANNELS]; // 1 = canal atascado ya anunciado en el log
+} monitor_state;
+
+/**
+ * @brief Escribe un evento del ciclo de vida del daemon en el log
+ * @description Usa el mismo formato de marca de tiempo que las lecturas de
+ *              temperatura para que ambos tipos de línea se puedan intercalar.
+ */
+static void log_event(FILE *log, const char *fmt, ...) {
+    time_t now = time(NULL);
+    va_list ap;
+
+    fprintf(log, "[%s] Daemon: ", ctime(&now));
+    va_start(ap, fmt);
+    vfprintf(log, fmt, ap);
+    va_end(ap);
+    fputc('\n', log);
+    fflush(log);
+}
+
+/**
+ * @brief Programa el timerfd de muestreo con el intervalo indicado
+ * @description La primera expiración ocurre tras @p first_ms milisegundos y
+ *              luego de forma periódica cada @p interval_ms. El reloj es
+ *              CLOCK_MONOTONIC, inmune a cambios de la hora del sistema.
+ *
+ * @return int 0 si éxito, -1 si error
+ */
+static int arm_timer(int tfd, unsigned first_ms, unsigned interval_ms) {
+    struct itimerspec its;
+
+    its.it_interval.tv_sec = interval_ms / 1000;
+    its.it_interval.tv_nsec = (long)(interval_ms % 1000) * 1000000L;
+    its.it_value.tv_sec = first_ms / 1000;
+    its.it_value.tv_nsec = (long)(first_ms % 1000) * 1000000L;
+
+    // Un it_value de cero desarmaría el temporizador: usar 1 ns
+    if (first_ms == 0) {
+        its.it_value.tv_nsec = 1;
+    }
+    return timerfd_settime(tfd, 0, &its, NULL);
+}
+
+/**
+ * @brief Guarda la instantánea del estado si está configurada
+ */
+static void save_snapshot(monitor_state *st, time_t now) {
+    if (st->cfg.snapshot_path[0] == '\0') {
+        return;
+    }
+    if (snapshot_save(st->cfg.snapshot_path, &st->history, &st->sensors) < 0) {
+        log_event(st->log, "snapshot save failed: %s (%s)",
+                  st->cfg.snapshot_path, strerror(errno));
+    }
+    st->last_snapshot = now;
+}
+
+/**
+ * @brief Registra la duración de una etapa en las estadísticas y el log binario
+ */
+static void record_stage(monitor_state *st, selfstat_stage stage, uint64_t start_ns, uint64_t dur_ns) {
+    binlog_span span = {.stage = (uint32_t)stage, .dur_ns = dur_ns};
+
+    selfstat_record(&st->stats, stage, dur_ns);
+    binlog_append(&st->binlog, BINLOG_SPAN, start_ns, &span, sizeof(span));
+}
+
+/**
+ * @brief Describe los canales de la tabla de sensores en el log binario
+ * @description Se llama tras cada (re)descubrimiento para que el exportador
+ *              pueda nombrar las pistas de temperatura.
+ */
+static void binlog_channels(monitor_state *st) {
+    uint64_t now = selfstat_now();
+
+    for (int i = 0; i < st->sensors.count; i++) {
+        binlog_channel c = {.channel = i};
+        memcpy(c.driver, st->sensors.ch[i].driver, sizeof(c.driver));
+        memcpy(c.label, st->sensors.ch[i].label, sizeof(c.label));
+        binlog_append(&st->binlog, BINLOG_CHANNEL, now, &c, sizeof(c));
+    }
+    binlog_flush(&st->binlog);
+}
+
+/**
+ * @brief Describe los cgroups muestreados en el log binario
+ */
+static void binlog_cgroup_names(monitor_state *st) {
+    uint64_t now = selfstat_now();
+
+    for (int i = 0; i < st->cgroups.count; i++) {
+        binlog_cgroup_name c = {.id = i};
+        snprintf(c.name, sizeof(c.name), "%s", st->cgroups.cg[i].name);
+        binlog_append(&st->binlog, BINLOG_CGROUP_NAME, now, &c, sizeof(c));
+    }
+}
+
+/**
+ * @brief Describe las zonas de energía en el log binario
+ */
+static void binlog_power_zones(monitor_state *st) {
+    uint64_t now = selfstat_now();
+
+    for (int i = 0; i < st->power.count; i++) {
+        binlog_power_zone z = {.id = i, .kind = (uint32_t)st->power.z[i].kind};
+        snprintf(z.name, sizeof(z.name), "%s", st->power.z[i].name);
+        binlog_append(&st->binlog, BINLOG_POWER_ZONE, now, &z, sizeof(z));
+    }
+}
+
+/**
+ * @brief Abre el log binario configurado (o lo deja desactivado)
+ */
+static void open_binlog(monitor_state *st) {
+    st->binlog.fd = -1;
+    if (st->cfg.binlog_path[0] == '\0') {
+        return;
+    }
+    if (binlog_open(&st->binlog, st->cfg.binlog_path) < 0) {
+        log_event(st->log, "binlog open failed: %s (%s)", st->cfg.binlog_path, strerror(errno));
+        return;
+    }
+    binlog_channels(st);
+    binlog_cgroup_names(st);
+    binlog_power_zones(st);
+    binlog_flush(&st->binlog);
+}
+
+/**
+ * @brief Prepara la tabla de sensores y el historial al arrancar
+ * @description Arranque en caliente: si existe una instantánea compatible y
+ *              la tabla de sensores cacheada sigue siendo válida, se
+ *              restauran el historial (ventanas de 15 minutos completas) y los
+ *              sensores sin recorrer sysfs. En cualquier otro caso se hace un
+ *              arranque en frío con historial vacío y descubrimiento completo.
+ */
+static void restore_or_discover(monitor_state *st) {
+    if (st->cfg.snapshot_path[0] != '\0' &&
+        snapshot_load(st->cfg.snapshot_path, &st->history, &st->sensors) == 0) {
+        if (sensors_validate(&st->sensors, st->cfg.sysfs_root) == 0) {
+            log_event(st->log, "warm start from %s (%llu samples, %d sensors)",
+                      st->cfg.snapshot_path,
+                      (unsigned long long)st->history.samples, st->sensors.count);
+            sensors_open(&st->sensors);
+            return;
+        }
+        log_event(st->log, "snapshot discarded: sensor hardware changed");
+    }
+
+    // Arranque en frío
+    history_init(&st->history);
+    sensors_discover(&st->sensors, st->cfg.sysfs_root);
+    sensors_open(&st->sensors);
+    log_event(st->log, "cold start (%d sensors, primary %d %s %s)",
+              st->sensors.count, st->sensors.primary,
+              st->sensors.primary >= 0 ? st->sensors.ch[st->sensors.primary].driver : "-",
+              st->sensors.primary >= 0 ? st->sensors.ch[st->sensors.primary].label : "-");
+}
+
+/**
+ * @brief Registra en el motor de adquisición los descriptores de cada módulo
+ * @description Se llama antes del primer lote y después de cualquier
+ *              reapertura de descriptores (recarga, hotplug, re-recorrido
+ *              de cgroups). Los procesos de proc_top cambian en cada ciclo y
+ *              los grupos perf_event se leen con read(): no entran en el lote.
+ */
+static void setup_acquire(monitor_state *st) {
+    acquire *a = &st->acq;
+    const cpu_counters *c = &st->counters;
+    const char *was = acquire_backend(a);
+    int before = a->count;
+
+    acquire_clear(a);
+    for (int i = 0; i < st->sensors.count; i++) {
+        acquire_add(a, st->sensors.ch[i].fd, SENSOR_READ_LEN);
+    }
+    acquire_add(a, c->stat_fd, c->stat_len);
+    for (int i = 0; i < c->ncpu; i++) {
+        acquire_add(a, c->freq_fd[i], CPU_ATTR_READ_LEN);
+        acquire_add(a, c->core_thr_fd[i], CPU_ATTR_READ_LEN);
+        acquire_add(a, c->pkg_thr_fd[i], CPU_ATTR_READ_LEN);
+    }
+    for (int i = 0; i < st->power.count; i++) {
+        acquire_add(a, st->power.z[i].fd, POWER_READ_LEN);
+    }
+    for (int i = 0; i < PSI_RESOURCES; i++) {
+        acquire_add(a, st->psi.r[i].fd, PSI_READ_LEN);
+    }
+    for (int i = 0; i < st->cgroups.count; i++) {
+        acquire_add(a, st->cgroups.cg[i].stat_fd, CGROUP_STAT_READ_LEN);
+    }
+    if (acquire_commit(a) < 0) {
+        // Sin memoria: cada módulo vuelve a su pread() directa
+        acquire_clear(a);
+        log_event(st->log, "acquire: out of memory, batched reads disabled");
+    }
+    st->acq_dirty = 0;
+
+    if (a->count != before || strcmp(was, acquire_backend(a)) != 0) {
+        log_event(st->log, "acquire: %d files per sample via %s", a->count, acquire_backend(a));
+    }
+}
+
+/**
+ * @brief Plazo efectivo del lote de lecturas
+ * @description acquire_timeout_ms, pero como mucho medio intervalo: un
+ *              sensor atascado nunca hace perder una muestra.
+ */
+static unsigned acquire_timeout(const daemon_config *cfg) {
+    unsigned half = cfg->interval_ms / 2 > 0 ? cfg->interval_ms / 2 : 1;
+    return cfg->acquire_timeout_ms < half ? cfg->acquire_timeout_ms : half;
+}
+
+/**
+ * @brief Anuncia los canales que se atascan o vuelven tras el lote
+ */
+static void log_stale_channels(monitor_state *st) {
+    for (int i = 0; i < st->sensors.count; i++) {
+        const sensor_channel *c = &st->sensors.ch[i];
+        int stuck = acquire_stuck(&st->acq, c->fd);
+        if (stuck != st->stale[i]) {
+            st->stale[i] = (uint8_t)stuck;
+            log_event(st->log, "sensor: channel %d (%s %s) %s", i, c->driver, c->label,
+                      stuck ? "stale, skipped until its read completes" : "recovered");
+        }
+    }
+}
+
+/**
+ * @brief Temperatura para el umbral: el canal primario o, si está atascado
+ *        o no se puede leer, el canal con perfil más caliente
+ * @description Así un sensor primario colgado no silencia las alertas
+ *              mientras los demás canales del CPU siguen respondiendo.
+ *
+ * @param channel Canal usado (-1 si ninguno)
+ *
+ * @return float Temperatura en °C, -1 si ningún canal se pudo leer
+ */
+static float read_alert_temp(monitor_state *st, int *channel) {
+    const sensor_table *t = &st->sensors;
+    float temp = sensors_read(t, t->primary, &st->acq);
+
+    *channel = t->primary;
+    if (temp >= 0.0f) {
+        return temp;
+    }
+    for (int i = 0; i < t->count; i++) {
+        if (i == t->primary || t->ch[i].rank == 0) {
+            continue;
+        }
+        float v = sensors_read(t, i, &st->acq);
+        if (v >= 0.0f && v > temp) {
+            temp = v;
+            *channel = i;
+        }
+    }
+    return temp;
+}
+
+/**
+ * @brief Muestrea la presión (PSI) y completa el registro del ciclo
+ */
+static void sample_psi(monitor_state *st, uint64_t sample_ns, unsigned rec) {
+    if (psi_sample(&st->psi, &st->acq) < 0) {
+        return;
+    }
+    series_set_psi(&st->series, rec, &st->psi);
+
+    for (int i = 0; i < PSI_RESOURCES; i++) {
+        const psi_state *p = &st->psi.r[i];
+        if (p->fd < 0) {
+            continue;
+        }
+        binlog_psi r = {
+            .resource = (uint32_t)i,
+            .some_avg10 = p->some_avg10,
+            .full_avg10 = p->full_avg10,
+            .some_us = p->d_some_us,
+            .full_us = p->d_full_us,
+        };
+        binlog_append(&st->binlog, BINLOG_PSI, sample_ns, &r, sizeof(r));
+    }
+}
+
+/**
+ * @brief Lee los grupos perf_event y completa el registro del ciclo
+ */
+static void sample_pmu(monitor_state *st, uint64_t sample_ns, unsigned rec) {
+    if (pmu_sample(&st->pmu, sample_ns, st->counters.util_pm) < 0) {
+        return;
+    }
+    series_set_pmu(&st->series, rec, &st->pmu);
+
+    for (int i = 0; i < st->pmu.ncpu; i++) {
+        const pmu_cpu *c = &st->pmu.cpu[i];
+        if (c->nr == 0) {
+            continue;
+        }
+        binlog_pmu r = {
+            .cpu = (uint16_t)i,
+            .hardware = 1,
+            .ipc_milli = c->ipc_milli,
+            .eff_mhz = c->eff_mhz,
+            .busy_pm = c->busy_pm,
+        };
+        binlog_append(&st->binlog, BINLOG_PMU, sample_ns, &r, sizeof(r));
+    }
+}
+
+/**
+ * @brief Abre o cierra los grupos perf_event según la configuración
+ */
+static void setup_pmu(monitor_state *st) {
+    if (!st->cfg.perf_counters) {
+        pmu_close(&st->pmu);
+        return;
+    }
+    if (st->pmu.ncpu > 0) {
+        return;
+    }
+    if (pmu_open(&st->pmu, st->counters.ncpu) < 0) {
+        log_event(st->log, "perf counters unavailable (%s)", strerror(errno));
+        return;
+    }
+    log_event(st->log, "perf counters open (cycles, instructions)");
+}
+
+/**
+ * @brief Construye el mapa de topología y asigna los canales a las CPUs
+ */
+static void setup_topology(monitor_state *st) {
+    topology_free(&st->topo);
+    if (st->counters.ncpu == 0 ||
+        topology_build(&st->topo, st->cfg.sysfs_root, st->counters.ncpu, &st->sensors) < 0) {
+        return;
+    }
+    log_event(st->log, "topology: %d packages, %d ccds, %d cores, %d nodes (%s)",
+              st->topo.level[TOPO_PACKAGE].count, st->topo.level[TOPO_CCD].count,
+              st->topo.level[TOPO_CORE].count, st->topo.level[TOPO_NODE].count,
+              st->topo.mapped ? "per-unit sensors" : "primary sensor only");
+}
+
+/**
+ * @brief Calcula los agregados por nivel y los registra en el log binario
+ */
+static void sample_topology(monitor_state *st, uint64_t sample_ns, float temp) {
+    if (st->topo.mapped) {
+        topology_read_sensors(&st->topo, &st->sensors, &st->acq);
+    }
+    topology_update(&st->topo, temp, &st->counters);
+
+    for (int l = 0; l < TOPO_LEVELS; l++) {
+        const topo_agg *a = &st->topo.level[l];
+        for (int u = 0; u < a->count; u++) {
+            binlog_topo r = {
+                .level = (uint16_t)l,
+                .id = (uint16_t)a->id[u],
+                .temp_milli = (int32_t)(a->temp_max[u] * 1000.0f),
+                .util_pm = a->util_pm[u],
+                .freq_mhz = a->freq_mhz[u],
+                .throttle = a->throttle[u],
+            };
+            binlog_append(&st->binlog, BINLOG_TOPO, sample_ns, &r, sizeof(r));
+        }
+    }
+}
+
+/**
+ * @brief Lee el rendimiento de cpu_stressor y lo registra en el log binario
+ * @description Registra en el log de texto cuándo aparece y desaparece un
+ *              cpu_stressor en la ruta configurada.
+ */
+static void sample_stress(monitor_state *st, uint64_t sample_ns) {
+    int attached = st->stress.map != NULL;
+    int32_t pid = attached ? st->stress.map->pid : 0;
+    int rc = stress_link_sample(&st->stress, st->cfg.stress_shm, sample_ns);
+
+    if (attached && (st->stress.map == NULL || st->stress.map->pid != pid)) {
+        log_event(st->log, "stress: pid %d detached", (int)pid);
+    }
+    if (st->stress.map != NULL && (!attached || st->stress.map->pid != pid)) {
+        log_event(st->log, "stress: pid %d attached (%u threads, kernel %.16s)",
+                  (int)st->stress.map->pid, st->stress.map->threads, st->stress.map->kernel);
+    }
+    if (rc != 1) {
+        return;
+    }
+
+    binlog_stress r = {
+        .threads = st->stress.map->threads,
+        .pid = st->stress.map->pid,
+        .ops_per_s = (uint64_t)st->stress.ops_per_s,
+    };
+    memcpy(r.kernel, st->stress.map->kernel, sizeof(r.kernel));
+    memcpy(r.unit, st->stress.map->unit, sizeof(r.unit));
+    r.kernel[sizeof(r.kernel) - 1] = '\0';
+    r.unit[sizeof(r.unit) - 1] = '\0';
+    binlog_append(&st->binlog, BINLOG_STRESS, sample_ns, &r, sizeof(r));
+}
+
+/**
+ * @brief Muestrea los cgroups y registra sus deltas en el log binario
+ * @description Los registros llevan la misma marca de tiempo que la muestra
+ *              de temperatura del ciclo, para poder alinearlos directamente.
+ */
+static void sample_cgroups(monitor_state *st, uint64_t sample_ns) {
+    int changed = cgroup_set_sample(&st->cgroups, &st->acq);
+    if (changed < 0) {
+        return;
+    }
+    if (changed) {
+        binlog_cgroup_names(st);
+        st->acq_dirty = 1;
+    }
+
+    for (int i = 0; i < st->cgroups.count; i++) {
+        const cgroup_entry *e = &st->cgroups.cg[i];
+        binlog_cgroup r = {
+            .id = i,
+            .nr_throttled = (uint32_t)e->d_nr_throttled,
+            .usage_usec = e->d_usage_usec,
+            .throttled_usec = e->d_throttled_usec,
+            .host_share_ppm = (uint32_t)(cgroup_host_share(&st->cgroups, i) * 10000.0),
+        };
+        binlog_append(&st->binlog, BINLOG_CGROUP, sample_ns, &r, sizeof(r));
+    }
+}
+
+/**
+ * @brief Alimenta el detector de episodios de throttling
+ * @description Los episodios cerrados van al log binario; cada hora con
+ *              throttling deja una línea de resumen en el log de texto.
+ */
+static void detect_throttle(monitor_state *st, uint64_t sample_ns, float temp) {
+    time_t now = time(NULL);
+    const throttle_hour *h = throttle_roll(&st->throttle, now);
+    if (h) {
+        time_t hour = (time_t)h->hour;
+        fprintf(st->log, "[%s] Throttle hour: episodes=%u core_s=%.1f lost_gcycles=%.2f peak=%.2f°C worst_cpu=%d\n",
+                ctime(&hour), h->episodes, h->core_s, h->lost_gcycles,
+                h->peak_milli / 1000.0, h->worst_cpu);
+    }
+
+    int n = throttle_update(&st->throttle, sample_ns, temp, st->cfg.temp_threshold, &st->counters);
+    for (int i = 0; i < n; i++) {
+        const throttle_episode *ep = &st->throttle.closed[i];
+        binlog_throttle r = {
+            .cpu = (uint16_t)ep->cpu,
+            .peak_milli = ep->peak_milli,
+            .dur_ns = ep->end_ns - ep->start_ns,
+            .lost_cycles = ep->lost_cycles,
+        };
+        binlog_append(&st->binlog, BINLOG_THROTTLE, ep->start_ns, &r, sizeof(r));
+    }
+}
+
+/**
+ * @brief Muestrea los contadores por CPU y guarda el registro del ciclo
+ * @description La temperatura y los contadores de todas las CPUs se guardan
+ *              en el mismo registro de la serie y con la misma marca de
+ *              tiempo en el log binario.
+ *
+ * @return unsigned Índice del registro de la serie
+ */
+static unsigned sample_counters(monitor_state *st, uint64_t sample_ns, float temp) {
+    int ok = cpu_counters_sample(&st->counters, &st->acq) == 0;
+    unsigned rec = series_append(&st->series, sample_ns, temp, &st->counters);
+    if (!ok) {
+        return rec;
+    }
+    detect_throttle(st, sample_ns, temp);
+
+    for (int i = 0; i < st->counters.ncpu; i++) {
+        binlog_cpu r = {
+            .cpu = (uint16_t)i,
+            .util_pm = st->counters.util_pm[i],
+            .freq_mhz = st->counters.freq_mhz[i],
+            .core_throttle = st->counters.d_core_thr[i],
+            .pkg_throttle = st->counters.d_pkg_thr[i],
+        };
+        binlog_append(&st->binlog, BINLOG_CPU, sample_ns, &r, sizeof(r));
+    }
+    return rec;
+}
+
+/**
+ * @brief Muestrea la energía RAPL y completa el registro del ciclo
+ */
+static void sample_power(monitor_state *st, uint64_t sample_ns, unsigned rec) {
+    if (power_sample(&st->power, sample_ns, &st->acq) < 0) {
+        return;
+    }
+    series_set_power(&st->series, rec, st->power.package_w, st->power.core_w);
+
+    for (int i = 0; i < st->power.count; i++) {
+        binlog_power r = {.id = i, .milliwatts = (uint32_t)(st->power.z[i].watts * 1000.0)};
+        binlog_append(&st->binlog, BINLOG_POWER, sample_ns, &r, sizeof(r));
+    }
+}
+
+/**
+ * @brief Registra en el log los cgroups que más CPU consumieron
+ * @description Se llama al disparar una alerta: indica qué servicio mover
+ *              cuando el host se calienta. El porcentaje es el consumo
+ *              propio del grupo, sin el de sus subgrupos muestreados.
+ */
+static void log_cgroup_offenders(monitor_state *st) {
+    int top[3];
+    char line[512];
+    size_t len = 0;
+
+    int n = cgroup_set_top(&st->cgroups, top, 3);
+    for (int i = 0; i < n && len < sizeof(line); i++) {
+        const cgroup_entry *e = &st->cgroups.cg[top[i]];
+        len += (size_t)snprintf(line + len, sizeof(line) - len, "%s%s %.1f%% (throttled %llu, %.1f ms)",
+                                i ? ", " : "", e->name, cgroup_self_share(&st->cgroups, top[i]),
+                                (unsigned long long)e->d_nr_throttled, e->d_throttled_usec / 1000.0);
+    }
+    if (n > 0) {
+        time_t now = time(NULL);
+        fprintf(st->log, "[%s] Cgroups: %s\n", ctime(&now), line);
+    }
+}
+
+/**
+ * @brief Formatea los procesos que más CPU consumen para una alerta
+ * @description Escribe "comm(pid) NN.N%, ..." en @p out y registra la misma
+ *              lista en el log. Devuelve "" si la atribución está desactivada
+ *              o todavía no hay dos escaneos para calcular deltas.
+ */
+static const char *format_offenders(monitor_state *st, char *out, size_t size) {
+    proc_usage top[PROC_TOP_MAX];
+    size_t len = 0;
+
+    out[0] = '\0';
+    if (!st->procs_ready || st->cfg.top_n == 0) {
+        return out;
+    }
+
+    int n = proc_table_top(&st->procs, top, (int)st->cfg.top_n);
+    for (int i = 0; i < n && len < size; i++) {
+        len += (size_t)snprintf(out + len, size - len, "%s%s(%d) %.1f%%",
+                                i ? ", " : "", top[i].comm, top[i].pid, top[i].cpu_pct);
+    }
+    if (n > 0) {
+        time_t now = time(NULL);
+        fprintf(st->log, "[%s] Top: %s\n", ctime(&now), out);
+    }
+    return out;
+}
+
+/**
+ * @brief Ejecuta un ciclo de muestreo: lectura, registro y alerta
+ * @description Corresponde al cuerpo del bucle original:
+ *              1. Lee en un solo lote todos los archivos del ciclo y
+ *                 obtiene la temperatura actual del CPU
+ *              2. La registra en el archivo de log y en el historial, y en
+ *                 la serie junto a la utilización, frecuencia y throttling
+ *                 de cada CPU
+ *              3. En una alerta, o si la referencia tiene más de
+ *                 PROC_BASELINE_S segundos, escanea los procesos
+ *              4. Envía una notificación si excede el umbral crítico, con
+ *                 los procesos que más CPU consumieron desde la referencia
+ *              5. Guarda la instantánea si venció su periodo
+ */
+static void sample_once(monitor_state *st) {
+    uint64_t t_start = selfstat_now();
+
+    // Un lote de lecturas para sensores, contadores, RAPL, PSI y cgroups;
+    // los módulos solo analizan el resultado
+    if (st->acq_dirty) {
+        setup_acquire(st);
+    }
+    acquire_run(&st->acq);
+
+    // Obtener la temperatura actual del CPU: canal sysfs descubierto o,
+    // si no se encontró Tctl en hwmon, el comando 'sensors'. Ambos con el
+    // plazo del lote
+    int channel = -1;
+    float temp = st->sensors.primary >= 0
+                 ? read_alert_temp(st, &channel)
+                 : get_cpu_temp_timeout(st->acq.timeout_ms);
+    uint64_t t_acquired = selfstat_now();
+    record_stage(st, STAGE_ACQUIRE, t_start, t_acquired - t_start);
+    log_stale_channels(st);
+
+    // Argumentos comunes de los probes y del log binario: canal y
+    // temperatura en miligrados
+    long milli = (long)(temp * 1000.0f);
+    long threshold_milli = (long)(st->cfg.temp_threshold * 1000.0f);
+    PROBE_SAMPLE_ACQUIRED(channel, milli, t_acquired - t_start);
+
+    binlog_sample sample = {.channel = channel, .milli = (int32_t)milli};
+    binlog_append(&st->binlog, BINLOG_SAMPLE, t_acquired, &sample, sizeof(sample));
+
+    // Utilización, frecuencia y throttling por CPU en el mismo registro
+    uint64_t t_counters = selfstat_now();
+    unsigned rec = sample_counters(st, t_acquired, temp);
+    record_stage(st, STAGE_COUNTERS, t_counters, selfstat_now() - t_counters);
+
+    // Potencia de paquetes y núcleos en el mismo registro
+    if (st->power.count > 0) {
+        uint64_t t_power = selfstat_now();
+        sample_power(st, t_acquired, rec);
+        record_stage(st, STAGE_POWER, t_power, selfstat_now() - t_power);
+    }
+
+    // Tiempo de espera visible por las aplicaciones en el mismo registro
+    uint64_t t_psi = selfstat_now();
+    sample_psi(st, t_acquired, rec);
+    record_stage(st, STAGE_PSI, t_psi, selfstat_now() - t_psi);
+
+    // IPC y frecuencia efectiva: rendimiento frente a temperatura
+    if (st->pmu.ncpu > 0) {
+        uint64_t t_pmu = selfstat_now();
+        sample_pmu(st, t_acquired, rec);
+        record_stage(st, STAGE_PMU, t_pmu, selfstat_now() - t_pmu);
+    }
+
+    // Máximos y medias por núcleo, CCD, paquete y nodo NUMA
+    if (st->topo.ncpu > 0) {
+        uint64_t t_topo = selfstat_now();
+        sample_topology(st, t_acquired, temp);
+        record_stage(st, STAGE_TOPOLOGY, t_topo, selfstat_now() - t_topo);
+    }
+
+    // Trabajo del stressor en el mismo intervalo que la temperatura
+    if (st->cfg.stress_shm[0] != '\0') {
+        uint64_t t_stress = selfstat_now();
+        sample_stress(st, t_acquired);
+        record_stage(st, STAGE_STRESS, t_stress, selfstat_now() - t_stress);
+    }
+
+    // Consumo por cgroup alineado con la muestra de temperatura
+    if (st->cgroups.root[0] != '\0') {
+        uint64_t t_cgroup = selfstat_now();
+        sample_cgroups(st, t_acquired);
+        record_stage(st, STAGE_CGROUP, t_cgroup, selfstat_now() - t_cgroup);
+    }
+
+    // Obtener timestamp actual para el registro
+    time_t now = time(NULL);
+
+    // Registrar la temperatura actual en el archivo de log
+    // Formato: [timestamp] Temp: XX.XX°C
+    fprintf(st->log, "[%s] Temp: %.2f°C\n", ctime(&now), temp);
+    uint64_t t_formatted = selfstat_now();
+    record_stage(st, STAGE_FORMAT, t_acquired, t_formatted - t_acquired);
+
+    // Forzar la escritura inmediata al archivo (flush del buffer)
+    fflush(st->log);
+    uint64_t t_flushed = selfstat_now();
+    record_stage(st, STAGE_FLUSH, t_formatted, t_flushed - t_formatted);
+    PROBE_RECORD_WRITTEN(channel, milli, t_flushed - t_acquired);
+
+    // Actualizar ventanas e histograma
+    history_add(&st->history, now, temp);
+
+    // Verificar si la temperatura excede el umbral crítico
+    int over = temp >= st->cfg.temp_threshold;
+
+    // Escanear procesos solo en una alerta (los deltas se calculan contra el
+    // escaneo de referencia) o para renovar una referencia demasiado vieja
+    if (st->procs_ready && st->cfg.top_n > 0) {
+        uint64_t t_scan = selfstat_now();
+        if (over || t_scan - st->procs.last_ns >= PROC_BASELINE_S * 1000000000ull) {
+            proc_table_scan(&st->procs);
+            record_stage(st, STAGE_ATTRIBUTE, t_scan, selfstat_now() - t_scan);
+        }
+    }
+    history_alert(&st->history, now, over);
+    if (over) {
+        // Enviar notificación de alerta por temperatura alta
+        PROBE_ALERT_RAISED(channel, milli, threshold_milli);
+        uint64_t t_notify = selfstat_now();
+        binlog_alert alert = {.channel = channel, .milli = (int32_t)milli,
+                              .threshold_milli = (int32_t)threshold_milli};
+        binlog_append(&st->binlog, BINLOG_ALERT, t_notify, &alert, sizeof(alert));
+
+        char offenders[512];
+        log_cgroup_offenders(st);
+        send_notification(temp, format_offenders(st, offenders, sizeof(offenders)));
+        uint64_t notify_ns = selfstat_now() - t_notify;
+        record_stage(st, STAGE_NOTIFY, t_notify, notify_ns);
+        PROBE_ALERT_DISPATCHED(channel, milli, notify_ns);
+    }
+
+    if (now - st->last_snapshot >= (time_t)st->cfg.snapshot_interval_s) {
+        uint64_t t_snapshot = selfstat_now();
+        save_snapshot(st, now);
+        record_stage(st, STAGE_SNAPSHOT, t_snapshot, selfstat_now() - t_snapshot);
+    }
+
+    // Duración total del ciclo y detección de ciclos más largos que el intervalo
+    uint64_t cycle_ns = selfstat_now() - t_start;
+    record_stage(st, STAGE_CYCLE, t_start, cycle_ns);
+    st->stats.cycles++;
+    if (cycle_ns > (uint64_t)st->cfg.interval_ms * 1000000ull) {
+        st->stats.overruns++;
+    }
+
+    // Todos los registros binarios del ciclo en una sola write()
+    binlog_flush(&st->binlog);
+}
+
+/**
+ * @brief Escribe el informe de estado del daemon (SIGUSR1)
+ * @description Es la superficie de consulta del daemon: ventanas de 1, 5 y
+ *              15 minutos, estado de alerta y estadísticas internas. Se
+ *              escribe en "<status_path>.tmp" y se renombra, así un lector
+ *              nunca ve un informe a medias.
+ */
+static void write_status(monitor_state *st) {
+    char tmp[PATH_MAX + 8];
+    time_t now = time(NULL);
+
+    if (st->cfg.status_path[0] == '\0') {
+        return;
+    }
+    snprintf(tmp, sizeof(tmp), "%s.tmp", st->cfg.status_path);
+
+    FILE *out = fopen(tmp, "w");
+    if (!out) {
+        log_event(st->log, "status write failed: %s (%s)", tmp, strerror(errno));
+        return;
+    }
+
+    fprintf(out, "pid: %d\n", (int)getpid());
+    fprintf(out, "samples: %llu\n", (unsigned long long)st->history.samples);
+    fprintf(out, "avg_1m: %.2f\n", history_window_avg(&st->history, now, 60));
+    fprintf(out, "avg_5m: %.2f\n", history_window_avg(&st->history, now, 300));
+    fprintf(out, "avg_15m: %.2f\n", history_window_avg(&st->history, now, 900));
+    fprintf(out, "max_15m: %.2f\n", history_window_max(&st->history, now, 900));
+    fprintf(out, "alert_active: %d\n", st->history.alert_since != 0);
+    fprintf(out, "alert_count: %u\n", st->history.alert_count);
+    fprintf(out, "acquire: backend=%s files=%d timeout_ms=%u stale=%d timeouts=%lu\n",
+            acquire_backend(&st->acq), st->acq.count, st->acq.timeout_ms, st->acq.stuck,
+            st->acq.timeouts);
+    if (st->power.count > 0) {
+        fprintf(out, "power_package_w: %.2f\n", st->power.package_w);
+        fprintf(out, "power_core_w: %.2f\n", st->power.core_w);
+    }
+    for (int i = 0; i < st->power.count; i++) {
+        fprintf(out, "power: %s watts=%.2f\n", st->power.z[i].name, st->power.z[i].watts);
+    }
+    for (int i = 0; i < PSI_RESOURCES; i++) {
+        const psi_state *p = &st->psi.r[i];
+        if (p->fd >= 0) {
+            fprintf(out, "psi: %s some_avg10=%.2f full_avg10=%.2f some_stall_ms=%.1f full_stall_ms=%.1f\n",
+                    psi_resource_name((psi_resource)i), p->some_avg10 / 100.0, p->full_avg10 / 100.0,
+                    p->d_some_us / 1000.0, p->d_full_us / 1000.0);
+        }
+    }
+    for (int i = 0; i < st->pmu.ncpu; i++) {
+        const pmu_cpu *c = &st->pmu.cpu[i];
+        if (c->nr > 0) {
+            fprintf(out, "pmu: cpu %d util_pct=%.1f ipc=%.3f ghz=%.3f\n",
+                    i, c->busy_pm / 10.0, c->ipc_milli / 1000.0, c->eff_mhz / 1000.0);
+        }
+    }
+    series_cost cost;
+    series_throttle_cost(&st->series, &cost);
+    fprintf(out, "throttle_samples: %u/%u\n", cost.throttled, cost.busy);
+    fprintf(out, "throttled_mhz: %.0f\n", cost.throttled_mhz);
+    fprintf(out, "unthrottled_mhz: %.0f\n", cost.free_mhz);
+    fprintf(out, "throttle_cost_pct: %.2f\n", cost.cost_pct);
+    fprintf(out, "throttle_episodes: %llu\n", (unsigned long long)st->throttle.episodes);
+    fprintf(out, "throttle_open: %d\n", throttle_open_count(&st->throttle));
+    for (int i = 0; i < THROTTLE_HOURS; i++) {
+        // De la hora más antigua a la actual
+        const throttle_hour *h = &st->throttle.hours[(st->throttle.cur + 1 + i) % THROTTLE_HOURS];
+        if (h->hour != 0) {
+            fprintf(out, "throttle_hour: %lld episodes=%u core_s=%.1f lost_gcycles=%.3f peak_c=%.2f worst_cpu=%d\n",
+                    (long long)h->hour, h->episodes, h->core_s, h->lost_gcycles,
+                    h->peak_milli / 1000.0, h->worst_cpu);
+        }
+    }
+    for (int i = 0; i < st->counters.ncpu; i++) {
+        fprintf(out, "cpu: %d util_pct=%.1f freq_mhz=%u core_throttle=%u pkg_throttle=%u\n",
+                i, st->counters.util_pm[i] / 10.0, st->counters.freq_mhz[i],
+                st->counters.d_core_thr[i], st->counters.d_pkg_thr[i]);
+    }
+    for (int l = 0; l < TOPO_LEVELS; l++) {
+        const topo_agg *a = &st->topo.level[l];
+        for (int u = 0; u < a->count; u++) {
+            fprintf(out, "topo: %s %d package=%d cpus=%d temp_max=%.2f util_pct=%.1f freq_mhz=%u throttle=%u\n",
+                    topology_level_name((topo_level)l), a->id[u], a->package[u], a->ncpus[u],
+                    a->temp_max[u], a->util_pm[u] / 10.0, a->freq_mhz[u], a->throttle[u]);
+        }
+    }
+    if (st->stress.map != NULL && st->stress.primed) {
+        fprintf(out, "stress: pid=%d kernel=%.16s threads=%u %.16s_per_s=%.4e\n",
+                (int)st->stress.map->pid, st->stress.map->kernel, st->stress.map->threads,
+                st->stress.map->unit, st->stress.ops_per_s);
+    }
+    for (int i = 0; i < st->cgroups.count; i++) {
+        const cgroup_entry *e = &st->cgroups.cg[i];
+        fprintf(out, "cgroup: %s cpu_host_pct=%.2f nr_throttled=%llu throttled_ms=%.1f\n",
+                e->name, cgroup_host_share(&st->cgroups, i),
+                (unsigned long long)e->d_nr_throttled, e->d_throttled_usec / 1000.0);
+    }
+    selfstat_report(out, &st->stats);
+
+    if (fclose(out) != 0 || rename(tmp, st->cfg.status_path) < 0) {
+        log_event(st->log, "status write failed: %s (%s)", st->cfg.status_path, strerror(errno));
+        unlink(tmp);
+    }
+}
+
+/**
+ * @brief Recarga la configuración y reabre el log (SIGHUP)
+ * @description La operación es atómica desde el punto de vista del daemon:
+ *              primero se carga la configuración nueva y se abre el nuevo
+ *              log; solo si ambos pasos tienen éxito se reemplazan los
+ *              activos. Si algo falla, se sigue con la configuración y el log
+ *              anteriores. El timerfd solo se reprograma si el intervalo
+ *              cambió, de modo que no hay huecos en el muestreo.
+ *
+ * @return int 0 si la recarga se aplicó, -1 si se mantuvo la anterior
+ */
+static int reload(const char *config_path, monitor_state *st) {
+    daemon_config next;
+
+    if (config_load(config_path, &next) < 0) {
+        log_event(st->log, "reload failed: invalid configuration %s", config_path);
+        return -1;
+    }
+
+    // Abrir el log nuevo antes de cerrar el anterior (reapertura atómica,
+    // útil también tras una rotación con logrotate)
+    FILE *next_log = fopen(next.log_path, "a");
+    if (!next_log) {
+        log_event(st->log, "reload failed: cannot open log %s (%s)",
+                  next.log_path, strerror(errno));
+        return -1;
+    }
+
+    if (next.interval_ms != st->cfg.interval_ms) {
+        // Próxima muestra un intervalo nuevo después de ahora
+        if (arm_timer(st->tfd, next.interval_ms, next.interval_ms) < 0) {
+            fclose(next_log);
+            log_event(st->log, "reload failed: cannot rearm timer (%s)", strerror(errno));
+            return -1;
+        }
+    }
+
+    fclose(st->log);
+    st->log = next_log;
+
+    // Un cambio de raíz de sysfs invalida la tabla de sensores, los
+    // descriptores de los contadores por CPU y la topología
+    int sysfs_changed = strcmp(next.sysfs_root, st->cfg.sysfs_root) != 0;
+    if (sysfs_changed) {
+        sensors_close(&st->sensors);
+        sensors_discover(&st->sensors, next.sysfs_root);
+        sensors_open(&st->sensors);
+        cpu_counters_close(&st->counters);
+        cpu_counters_open(&st->counters, next.sysfs_root, "/proc");
+        power_close(&st->power);
+        power_open(&st->power, next.sysfs_root);
+    }
+
+    // Un cambio del subárbol de cgroups exige recorrerlo de nuevo
+    int cgroups_changed = strcmp(next.cgroup_root, st->cfg.cgroup_root) != 0 ||
+                          next.cgroup_depth != st->cfg.cgroup_depth;
+    if (cgroups_changed) {
+        cgroup_set_close(&st->cgroups);
+        cgroup_set_open(&st->cgroups, next.cgroup_root, next.cgroup_depth);
+    }
+
+    // Otra ruta de contadores: el ritmo anterior no es comparable
+    if (strcmp(next.stress_shm, st->cfg.stress_shm) != 0) {
+        stress_link_close(&st->stress);
+    }
+
+    st->cfg = next;
+    setup_pmu(st);
+
+    // Descriptores reabiertos o mecanismo cambiado: registrar de nuevo
+    st->acq.use_uring = (int)next.acquire_uring;
+    st->acq.timeout_ms = acquire_timeout(&next);
+    st->acq_dirty = 1;
+    memset(st->stale, 0, sizeof(st->stale));
+    if (sysfs_changed) {
+        setup_topology(st);
+    }
+
+    // Reabrir el log binario (rotación o cambio de ruta)
+    binlog_close(&st->binlog);
+    open_binlog(st);
+
+    log_event(st->log, "configuration reloaded from %s", config_path);
+    return 0;
+}
+
+/**
+ * @brief Atiende las altas y bajas de dispositivos hwmon
+ * @description Solo se recorre el directorio del dispositivo afectado. Como
+ *              los índices de canal pueden cambiar, se reconstruye la
+ *              topología y se vuelven a describir los canales en el log
+ *              binario. Si el socket se desbordó (ENOBUFS) no se sabe qué
+ *              eventos se perdieron y se recorre sysfs completo.
+ */
+static void handle_hotplug(monitor_state *st) {
+    hotplug_event ev;
+    int changed = 0;
+    int overflow = 0;
+    int r;
+
+    // Tras un desbordamiento se vacía el socket sin aplicar los eventos:
+    // el recorrido completo posterior ya los incluye
+    while ((r = hotplug_next(st->ufd, &ev)) != 0) {
+        if (r < 0) {
+            if (errno != ENOBUFS) {
+                break;
+            }
+            overflow = 1;
+            continue;
+        }
+        if (overflow) {
+            continue;
+        }
+        int add = ev.action == HOTPLUG_ADD;
+        int n = add ? sensors_add_device(&st->sensors, ev.name)
+                    : sensors_remove_device(&st->sensors, ev.name);
+        if (n > 0) {
+            log_event(st->log, "hotplug: %s %s (%d channels, primary %d)",
+                      add ? "added" : "removed", ev.name, n, st->sensors.primary);
+            changed = 1;
+        }
+    }
+    if (overflow) {
+        sensors_close(&st->sensors);
+        sensors_discover(&st->sensors, st->cfg.sysfs_root);
+        sensors_open(&st->sensors);
+        log_event(st->log, "hotplug: uevents lost (ENOBUFS), full rescan (%d sensors, primary %d)",
+                  st->sensors.count, st->sensors.primary);
+        changed = 1;
+    }
+    if (changed) {
+        setup_topology(st);
+        binlog_channels(st);
+        st->acq_dirty = 1;
+        memset(st->stale, 0, sizeof(st->stale));
+    }
+}
+
+/**
+ * @brief Apagado ordenado del daemon (SIGTERM/SIGINT)
+ * @description Guarda la instantánea y vacía y sincroniza el log a disco
+ *              dentro de un plazo máximo. El plazo se garantiza con alarm():
+ *              SIGALRM no está bloqueada, así que si algún paso se queda
+ *              colgado (p. ej. un disco NFS que no responde) el kernel
+ *              termina el proceso igualmente.
+ */
+static void shutdown_daemon(monitor_state *st, int signo) {
+    alarm(st->cfg.shutdown_deadline_s);
+
+    save_snapshot(st, time(NULL));
+    sensors_close(&st->sensors);
+    binlog_close(&st->binlog);
+    if (st->procs_ready) {
+        proc_table_free(&st->procs);
+    }
+    cgroup_set_close(&st->cgroups);
+    cpu_counters_close(&st->counters);
+    series_free(&st->series);
+    throttle_free(&st->throttle);
+    power_close(&st->power);
+    psi_close(&st->psi);
+    pmu_close(&st->pmu);
+    topology_free(&st->topo);
+    stress_link_close(&st->stress);
+    acquire_free(&st->acq);
+
+    log_event(st->log, "shutting down (signal %d)", signo);
+    fflush(st->log);
+    fsync(fileno(st->log));
+    fclose(st->log);
+}
+
+/**
+ * @brief Convierte una ruta relativa en absoluta respecto al directorio actual
+ * @description Necesario porque create_daemon() cambia el directorio de
+ *              trabajo a "/" y la configuración se relee en cada SIGHUP.
+ */
+static void absolute_path(const char *path, char *out, size_t size) {
+    char cwd[PATH_MAX];
+
+    if (path[0] == '/' || !getcwd(cwd, sizeof(cwd))) {
+        snprintf(out, size, "%s", path);
+    } else {
+        snprintf(out, size, "%s/%s", cwd, path);
+    }
+}
 
 /**
  * @brief Función principal del daemon de monitoreo de temperatura
- * @description Inicializa el daemon, abre el archivo de log y ejecuta el bucle
- *              principal de monitoreo que:
- *              1. Lee la temperatura actual del CPU
- *              2. Registra la temperatura en el archivo de log
- *              3. Verifica si excede el umbral crítico
- *              4. Envía notificación si es necesario
- *              5. Espera el intervalo definido antes de repetir
- * 
+ * @description Carga la configuración, convierte el proceso en daemon, abre
+ *              el archivo de log y ejecuta el bucle de eventos:
+ *              - Timer de muestreo: ejecuta sample_once()
+ *              - SIGHUP: recarga la configuración y reabre el log
+ *              - SIGUSR1: escribe el informe de estado
+ *              - SIGTERM/SIGINT: apagado ordenado y salida
+ *
+ * @usage cpu_daemon [-f] [-c archivo_configuración]
+ *        Con -f el proceso no se convierte en daemon: sigue en primer plano
+ *        con su PID y su directorio de trabajo (bancos de pruebas, systemd
+ *        con Type=simple).
+ *
  * @return int Código de salida (0 = éxito, 1 = error)
  */
-int main() {
-    // Convertir el proceso en un daemon del sistema
-    create_daemon();
+int main(int argc, char *argv[]) {
+    // Estado estático: las tablas de historial y sensores ocupan decenas de KB
+    static monitor_state st;
+    const char *config_arg = CONFIG_DEFAULT_PATH;
+    char config_path[PATH_MAX];
+    int foreground = 0;
+    int opt;
+
+    // Procesar argumentos de línea de comandos
+    while ((opt = getopt(argc, argv, "c:f")) != -1) {
+        switch (opt) {
+            case 'c':
+                config_arg = optarg;
+                break;
+            case 'f':
+                foreground = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-f] [-c archivo_configuración]\n", argv[0]);
+                return 1;
+        }
+    }
+    absolute_path(config_arg, config_path, sizeof(config_path));
+
+    // Validar la configuración antes de perder la terminal
+    if (config_load(config_path, &st.cfg) < 0) {
+        fprintf(stderr, "Configuración inválida: %s\n", config_path);
+        return 1;
+    }
+
+    // Convertir el proceso en un daemon del sistema (salvo con -f)
+    if (!foreground) {
+        create_daemon();
+    }
+
+    // Recibir las señales de control como eventos en un descriptor
+    int sfd = signals_open();
+
+    // Altas y bajas de dispositivos hwmon (opcional: sin él la tabla es estática)
+    st.ufd = hotplug_open();
+
+    // Temporizador periódico de muestreo
+    st.tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
 
     // Abrir archivo de log en modo append para registrar las temperaturas
-    // Ruta: /home/henry/CLionProjects/cpu_daemon/logs/cpu_temp_log.txt
-    FILE *log = fopen("/home/henry/CLionProjects/cpu_daemon/logs/cpu_temp_log.txt", "a");
-    
-    // Verificar si el archivo se abrió correctamente
-    if (!log) {
-        // Si no se puede abrir el archivo de log, terminar con código de error
+    st.log = fopen(st.cfg.log_path, "a");
+
+    // Verificar que todos los recursos se obtuvieron correctamente
+    if (sfd < 0 || st.tfd < 0 || !st.log) {
         return 1;
     }
+    log_event(st.log, "started (pid %d, interval %u ms)", (int)getpid(), st.cfg.interval_ms);
+    if (st.ufd < 0) {
+        log_event(st.log, "hotplug events unavailable: sensor table is static");
+    }
 
-    // Bucle principal del daemon - ejecuta indefinidamente
-    while (1) {
-        // Obtener la temperatura actual del CPU
-        float temp = get_cpu_temp();
-        
-        // Obtener timestamp actual para el registro
-        time_t now = time(NULL);
+    // Reinicio en caliente desde la instantánea o descubrimiento completo
+    restore_or_discover(&st);
+    cgroup_set_open(&st.cgroups, st.cfg.cgroup_root, st.cfg.cgroup_depth);
+    if (cpu_counters_open(&st.counters, st.cfg.sysfs_root, "/proc") == 0) {
+        series_init(&st.series, st.counters.ncpu);
+        throttle_init(&st.throttle, st.counters.ncpu);
+    }
+    power_open(&st.power, st.cfg.sysfs_root);
+    psi_open(&st.psi, "/proc");
+    setup_pmu(&st);
+    setup_topology(&st);
+    stress_link_init(&st.stress);
+    acquire_init(&st.acq, (int)st.cfg.acquire_uring);
+    st.acq.timeout_ms = acquire_timeout(&st.cfg);
+    st.acq_dirty = 1;
+    open_binlog(&st);
+    st.procs_ready = proc_table_init(&st.procs, "/proc") == 0;
+    st.last_snapshot = time(NULL);
+    selfstat_init(&st.stats);
 
-        // Registrar la temperatura actual en el archivo de log
-        // Formato: [timestamp] Temp: XX.XX°C
-        fprintf(log, "[%s] Temp: %.2f°C\n", ctime(&now), temp);
-        
-        // Forzar la escritura inmediata al archivo (flush del buffer)
-        fflush(log);
+    // Primera muestra inmediata, luego cada interval_ms
+    if (arm_timer(st.tfd, 0, st.cfg.interval_ms) < 0) {
+        return 1;
+    }
 
-        // Verificar si la temperatura excede el umbral crítico
-        if (temp >= TEMP_THRESHOLD) {
-            // Enviar notificación de alerta por temperatura alta
-            send_notification(temp);
+    struct pollfd fds[3] = {
+        {.fd = st.tfd, .events = POLLIN},
+        {.fd = sfd, .events = POLLIN},
+        {.fd = st.ufd, .events = POLLIN},   // poll() ignora fd = -1
+    };
+    int stop_signal = 0;
+
+    // Bucle principal del daemon - hasta recibir SIGTERM o SIGINT
+    while (!stop_signal) {
+        if (poll(fds, 3, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        // Expiración del temporizador de muestreo
+        if (fds[0].revents & POLLIN) {
+            uint64_t expirations;
+            if (read(st.tfd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+                // Más de una expiración: el ciclo anterior se pasó de su plazo
+                st.stats.missed_deadlines += expirations - 1;
+                sample_once(&st);
+            }
+        }
+
+        // Señales de control pendientes
+        if (fds[1].revents & POLLIN) {
+            int signo;
+            while ((signo = signals_next(sfd)) > 0) {
+                if (signo == SIGHUP) {
+                    reload(config_path, &st);
+                } else if (signo == SIGUSR1) {
+                    write_status(&st);
+                } else {
+                    stop_signal = signo;
+                }
+            }
+        }
+
+        // Dispositivos hwmon registrados o retirados
+        if (fds[2].revents & POLLIN) {
+            handle_hotplug(&st);
         }
+    }
 
-        // Pausar ejecución por el intervalo definido (5 segundos)
-        sleep(INTERVAL);
+    // Apagado ordenado: instantánea, vaciar y cerrar el log dentro del plazo
+    shutdown_daemon(&st, stop_signal);
+    close(st.tfd);
+    close(sfd);
+    if (st.ufd >= 0) {
+        close(st.ufd);
     }
 
-    // Cerrar archivo de log (nota: este código nunca se ejecuta debido al bucle infinito)
-    fclose(log);
-    
     // Retornar código de éxito
     return 0;
-}
\ No newline at end of file
+}
@@ -6,47 +6,82 @@
  * @author Sistema de monitoreo CPU
  */
 
-#include <stdlib.h>  // Para system() y funciones de utilidad del sistema
+#include <stdlib.h>  // Para funciones de utilidad del sistema
 #include <stdio.h>   // Para snprintf() y funciones de E/S
+#include <spawn.h>   // Para posix_spawnp()
+#include <sys/wait.h> // Para waitpid()
 #include "notifier.h" // Header con declaraciones de funciones del notificador
+#include "signals.h"  // Para signals_spawnattr(), signals_reap_child()
+
+// Entorno del proceso, heredado por notify-send (DISPLAY, DBUS_SESSION_BUS_ADDRESS)
+extern char **environ;
+
+// notify-send que no terminó en su plazo y aún no se ha recogido
+static pid_t notify_stuck;
 
 /**
  * @brief Envía una notificación visual del sistema sobre temperatura crítica
- * @description Esta función crea y ejecuta un comando notify-send para mostrar
- *              una alerta visual en el escritorio del usuario cuando la temperatura
- *              del CPU excede el umbral seguro. La notificación incluye un icono
- *              de advertencia y la temperatura actual.
+ * @description Esta función ejecuta notify-send para mostrar una alerta
+ *              visual en el escritorio del usuario cuando la temperatura del
+ *              CPU excede el umbral seguro. La notificación incluye un icono
+ *              de advertencia, la temperatura actual y, si se proporciona,
+ *              un detalle con los procesos que más CPU consumen.
  * 
- * @param temp Temperatura actual del CPU en grados Celsius
+ * @param temp   Temperatura actual del CPU en grados Celsius
+ * @param detail Texto adicional (NULL o "" = sin detalle)
  * 
  * @details Funcionamiento interno:
- *          1. Crea un buffer para el comando del sistema
- *          2. Formatea el comando notify-send con la temperatura
- *          3. Ejecuta el comando usando system()
+ *          1. Formatea el mensaje con la temperatura y el detalle
+ *          2. Ejecuta notify-send con posix_spawnp() pasando el mensaje como
+ *             argumento, sin intérprete de comandos: los nombres de proceso
+ *             del detalle pueden contener comillas u otros caracteres que,
+ *             con system(), se interpretarían como comandos del shell
+ *          3. Espera a que notify-send termine, como mucho
+ *             NOTIFY_TIMEOUT_MS, con la máscara de señales y las
+ *             disposiciones por defecto (signals_spawnattr())
  * 
  * @note Requiere que notify-send esté instalado en el sistema
  * @note El comando se ejecuta en el contexto del usuario actual
  * 
  * @example Uso típico:
  *          float cpu_temp = 70.5;
- *          send_notification(cpu_temp);
- *          // Resultado: Notificación "⚠️ CPU ALERT - Temp: 70.5°C exceeds safe limit!"
+ *          send_notification(cpu_temp, "cpu_stressor(4242) 99.8%");
+ *          // Resultado: Notificación "⚠️ CPU ALERT - Temp: 70.5°C exceeds safe limit!
+ *          //                          Top: cpu_stressor(4242) 99.8%"
  */
-void send_notification(float temp) {
-    // Buffer para almacenar el comando completo del sistema
-    // Tamaño: 128 caracteres (suficiente para el comando notify-send)
-    char command[128];
-    
-    // Construir el comando notify-send con formato personalizado
-    // notify-send: utilidad de Linux para mostrar notificaciones de escritorio
-    // Parámetros:
+void send_notification(float temp, const char *detail) {
+    // Buffer para el cuerpo de la notificación (temperatura + detalle)
+    char message[512];
+
+    // Construir el mensaje con formato personalizado
     // - Título: '⚠️ CPU ALERT' (con emoji de advertencia)
     // - Mensaje: 'Temp: XX.X°C exceeds safe limit!' (temperatura con 1 decimal)
-    snprintf(command, sizeof(command),
-             "notify-send '⚠️ CPU ALERT' 'Temp: %.1f°C exceeds safe limit!'", temp);
-    
-    // Ejecutar el comando del sistema para mostrar la notificación
-    // system(): ejecuta el comando en el shell del sistema
-    // La notificación aparecerá como popup en el escritorio del usuario
-    system(command);
-}
\ No newline at end of file
+    if (detail && detail[0] != '\0') {
+        snprintf(message, sizeof(message), "Temp: %.1f°C exceeds safe limit!\nTop: %s", temp, detail);
+    } else {
+        snprintf(message, sizeof(message), "Temp: %.1f°C exceeds safe limit!", temp);
+    }
+
+    // Un notify-send anterior sigue bloqueado: no lanzar otro
+    if (notify_stuck > 0) {
+        if (waitpid(notify_stuck, NULL, WNOHANG) == 0) {
+            return;
+        }
+        notify_stuck = 0;
+    }
+
+    // Ejecutar notify-send directamente (sin shell) en su propio grupo y
+    // esperar su fin con plazo
+    posix_spawnattr_t attr;
+    if (signals_spawnattr(&attr, POSIX_SPAWN_SETPGROUP) != 0) {
+        return;
+    }
+    char *argv[] = {"notify-send", "⚠️ CPU ALERT", message, NULL};
+    pid_t pid;
+    long start = signals_now_ms();
+    int rc = posix_spawnp(&pid, "notify-send", NULL, &attr, argv, environ);
+    posix_spawnattr_destroy(&attr);
+    if (rc == 0 && signals_reap_child(pid, start, NOTIFY_TIMEOUT_MS, 1) < 0) {
+        notify_stuck = pid;
+    }
+}
@@ -11,6 +11,9 @@
 #ifndef NOTIFIER_H  // Si NOTIFIER_H no está definido
 #define NOTIFIER_H  // Definir NOTIFIER_H
 
+// Espera máxima a que notify-send termine (el bucle de muestreo espera)
+#define NOTIFY_TIMEOUT_MS 500
+
 /**
  * @brief Declaración de función para envío de notificaciones de temperatura crítica
  * @description Esta función envía una notificación visual del sistema cuando
@@ -20,23 +23,28 @@
  * @param temp Temperatura actual del CPU en grados Celsius (float)
  *             - Valor típico de entrada: 65.0 - 100.0°C
  *             - Se muestra con precisión de 1 decimal en la notificación
+ * @param detail Texto adicional para el cuerpo de la notificación, p. ej. los
+ *               procesos que más CPU consumen (NULL o "" = sin detalle)
  * 
  * @return void Esta función no retorna ningún valor
  * 
  * @dependencies 
  *               - Requiere notify-send instalado en el sistema
  *               - Necesita entorno gráfico activo para mostrar notificaciones
+ *
+ * @note Espera a notify-send como mucho NOTIFY_TIMEOUT_MS; si no termina se
+ *       mata y, mientras no se pueda recoger, no se lanza otro.
  * 
  * @usage Ejemplo de uso:
  *        ```c
  *        #include "notifier.h"
  *        
  *        float cpu_temperature = 72.3;
- *        send_notification(cpu_temperature);
+ *        send_notification(cpu_temperature, "cpu_stressor(4242) 99.8%");
  *        ```
  * 
  * @see notifier.c para la implementación completa de esta función
  */
-void send_notification(float temp);
+void send_notification(float temp, const char *detail);
 
 #endif // NOTIFIER_H - Fin de las guardas de inclusión
\ No newline at end of file
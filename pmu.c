@@ -0,0 +1,159 @@
+/**
+ * @brief Módulo de contadores perf_event por CPU
+ * @description Implementa la apertura de los grupos con perf_event_open()
+ *              (no hay envoltorio en glibc, se usa syscall()) y la lectura
+ *              del grupo completo con PERF_FORMAT_GROUP.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdlib.h>              // Para calloc(), free()
+#include <errno.h>               // Para errno, ENOENT
+#include <string.h>              // Para memset(), memcpy()
+#include <unistd.h>              // Para syscall(), read(), close()
+#include <sys/syscall.h>         // Para SYS_perf_event_open
+#include <linux/perf_event.h>    // Para perf_event_attr y constantes PERF_*
+#include "pmu.h"                 // Header con declaraciones del módulo
+
+/**
+ * @brief Abre un contador de todo el sistema en una CPU
+ * @return int Descriptor, o -1 si el evento no está disponible
+ */
+static int open_event(uint32_t type, uint64_t config, int cpu, int group_fd) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, -1, cpu, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+/**
+ * @brief Cierra el grupo de una CPU
+ */
+static void close_group(pmu_cpu *c) {
+    for (int i = 0; i < PMU_EVENTS; i++) {
+        if (c->fd[i] >= 0) {
+            close(c->fd[i]);
+        }
+        c->fd[i] = -1;
+    }
+    c->nr = 0;
+}
+
+/**
+ * @brief Abre un grupo de contadores en cada CPU
+ * @description El líder son los ciclos y las instrucciones se añaden como
+ *              miembro: ambos se programan y se leen juntos.
+ */
+int pmu_open(pmu_set *p, int ncpu) {
+    int opened = 0;
+
+    memset(p, 0, sizeof(*p));
+    if (ncpu <= 0) {
+        return -1;
+    }
+
+    p->cpu = calloc((size_t)ncpu, sizeof(pmu_cpu));
+    if (!p->cpu) {
+        return -1;
+    }
+
+    int err = ENOENT;
+    for (int i = 0; i < ncpu; i++) {
+        pmu_cpu *c = &p->cpu[i];
+        for (int e = 0; e < PMU_EVENTS; e++) {
+            c->fd[e] = -1;
+        }
+
+        // En una VM sin vPMU, con la CPU fuera de línea o sin permisos
+        // los ciclos no se pueden abrir
+        c->fd[PMU_CYCLES] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, i, -1);
+        if (c->fd[PMU_CYCLES] < 0) {
+            err = errno;
+            continue;
+        }
+        c->fd[PMU_INSTRUCTIONS] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,
+                                             i, c->fd[PMU_CYCLES]);
+        if (c->fd[PMU_INSTRUCTIONS] < 0) {
+            err = errno;
+            close_group(c);
+            continue;
+        }
+        c->nr = PMU_EVENTS;
+        opened++;
+    }
+
+    p->ncpu = ncpu;
+    if (opened == 0) {
+        pmu_close(p);
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Lee los grupos de todas las CPUs y calcula IPC y frecuencia
+ */
+int pmu_sample(pmu_set *p, uint64_t now_ns, const uint16_t *util_pm) {
+    // nr, time_enabled, time_running y un valor por evento
+    uint64_t buf[3 + PMU_EVENTS];
+
+    if (p->ncpu == 0) {
+        return -1;
+    }
+
+    for (int i = 0; i < p->ncpu; i++) {
+        pmu_cpu *c = &p->cpu[i];
+        if (c->nr == 0) {
+            continue;
+        }
+
+        ssize_t n = read(c->fd[PMU_CYCLES], buf, sizeof(buf));
+        if (n < (ssize_t)((3 + (size_t)c->nr) * sizeof(uint64_t)) || buf[0] != (uint64_t)c->nr) {
+            continue;
+        }
+
+        // Escalado por multiplexación: valor * enabled / running
+        uint64_t enabled = buf[1], running = buf[2];
+        uint64_t v[PMU_EVENTS] = {0};
+        for (int e = 0; e < c->nr; e++) {
+            v[e] = running > 0 && running < enabled
+                   ? (uint64_t)((double)buf[3 + e] * enabled / running) : buf[3 + e];
+        }
+
+        uint64_t d_cycles = v[PMU_CYCLES] - c->last[PMU_CYCLES];
+        uint64_t d_instr = v[PMU_INSTRUCTIONS] - c->last[PMU_INSTRUCTIONS];
+
+        if (c->primed) {
+            // Tiempo ocupado = utilización de /proc/stat por el tiempo de
+            // pared desde la última lectura válida de esta CPU: si una
+            // lectura falló, d_cycles cubre también ese intervalo
+            uint64_t wall_ns = now_ns > c->last_ns ? now_ns - c->last_ns : 0;
+            c->busy_pm = util_pm != NULL ? util_pm[i] : 0;
+            uint64_t busy_ns = wall_ns * c->busy_pm / 1000;
+            uint64_t mhz = busy_ns > 0 ? d_cycles * 1000 / busy_ns : 0;
+            c->ipc_milli = d_cycles > 0 ? (uint16_t)(d_instr * 1000 / d_cycles) : 0;
+            c->eff_mhz = mhz > UINT16_MAX ? UINT16_MAX : (uint16_t)mhz;
+        }
+        memcpy(c->last, v, sizeof(c->last));
+        c->last_ns = now_ns;
+        c->primed = 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Cierra todos los grupos y libera el estado
+ */
+void pmu_close(pmu_set *p) {
+    for (int i = 0; p->cpu && i < p->ncpu; i++) {
+        close_group(&p->cpu[i]);
+    }
+    free(p->cpu);
+    memset(p, 0, sizeof(*p));
+}
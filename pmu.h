@@ -0,0 +1,86 @@
+/**
+ * @brief Header del módulo de contadores perf_event por CPU
+ * @description Define la interfaz para abrir, en cada CPU, un grupo de
+ *              contadores perf_event de todo el sistema (ciclos e
+ *              instrucciones) y leerlo con una sola read() por CPU en cada
+ *              ciclo del daemon. Con los deltas se calculan las
+ *              instrucciones por ciclo (IPC) y la frecuencia efectiva
+ *              (ciclos por nanosegundo ocupado), que muestran directamente
+ *              cuánto rendimiento se pierde cuando la CPU se calienta.
+ *              El tiempo ocupado es la utilización de /proc/stat
+ *              (cpu_counters) por el tiempo de pared: un task-clock de todo
+ *              el sistema cuenta tiempo de pared aunque la CPU esté ociosa.
+ *              Los ciclos no avanzan con la CPU detenida en idle. Si la
+ *              máquina no expone la PMU (máquinas virtuales) el módulo queda
+ *              desactivado: sin ciclos no hay nada que medir.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef PMU_H  // Si PMU_H no está definido
+#define PMU_H  // Definir PMU_H como macro de protección
+
+#include <stdint.h>  // Para tipos de ancho fijo
+
+/**
+ * @brief Eventos del grupo (orden de los valores en la lectura del grupo)
+ */
+typedef enum {
+    PMU_CYCLES,        // Ciclos de CPU (líder del grupo)
+    PMU_INSTRUCTIONS,  // Instrucciones retiradas
+    PMU_EVENTS
+} pmu_event;
+
+/**
+ * @brief Grupo de contadores de una CPU
+ */
+typedef struct {
+    int fd[PMU_EVENTS];        // Descriptores (fd[PMU_CYCLES] es el líder)
+    int nr;                    // Eventos en el grupo
+    uint64_t last[PMU_EVENTS]; // Valores escalados de la lectura anterior
+    uint16_t ipc_milli;        // IPC del último intervalo (x1000)
+    uint16_t eff_mhz;          // Frecuencia efectiva del último intervalo
+    uint32_t busy_pm;          // Utilización usada como tiempo ocupado (por mil)
+    uint64_t last_ns;          // Instante de last (CLOCK_MONOTONIC)
+    int primed;                // 1 si ya hay una lectura previa
+} pmu_cpu;
+
+/**
+ * @brief Contadores de todas las CPUs
+ */
+typedef struct {
+    int ncpu;            // CPUs con grupo abierto (0 = desactivado)
+    pmu_cpu *cpu;        // Grupo por CPU
+} pmu_set;
+
+/**
+ * @brief Abre un grupo de contadores en cada CPU
+ * @description Requiere CAP_PERFMON (o root) o perf_event_paranoid <= 0.
+ *
+ * @param p    Conjunto a inicializar
+ * @param ncpu CPUs configuradas
+ *
+ * @return int 0 si se abrió al menos un grupo, -1 si perf_event o la PMU
+ *             no están disponibles (errno)
+ */
+int pmu_open(pmu_set *p, int ncpu);
+
+/**
+ * @brief Lee los grupos de todas las CPUs y calcula IPC y frecuencia
+ * @description Los valores se escalan con time_enabled / time_running por si
+ *              el kernel multiplexa los contadores. La frecuencia efectiva
+ *              divide los ciclos entre el tiempo ocupado del intervalo
+ *              (util_pm por el tiempo de pared); sin utilización queda en 0.
+ *
+ * @param util_pm Utilización por CPU del mismo intervalo (cpu_counters), o NULL
+ *
+ * @return int 0 si éxito, -1 si el conjunto está desactivado
+ */
+int pmu_sample(pmu_set *p, uint64_t now_ns, const uint16_t *util_pm);
+
+/**
+ * @brief Cierra todos los grupos y libera el estado
+ */
+void pmu_close(pmu_set *p);
+
+#endif // PMU_H - Fin de las guardas de inclusión
@@ -0,0 +1,261 @@
+/**
+ * @brief Módulo de energía y potencia (RAPL / powercap)
+ * @description Implementa el descubrimiento de zonas de powercap y de
+ *              canales de energía de hwmon, la lectura de sus contadores con
+ *              pread() y el cálculo de la potencia con vuelta a cero.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdio.h>     // Para snprintf(), sscanf()
+#include <stdlib.h>    // Para strtoull()
+#include <string.h>    // Para strcmp(), strncmp(), strchr(), strrchr()
+#include <unistd.h>    // Para pread(), read(), close()
+#include <fcntl.h>     // Para open() y constantes O_*
+#include <dirent.h>    // Para opendir(), readdir()
+#include <limits.h>    // Para PATH_MAX
+#include "power.h"     // Header con declaraciones del módulo
+
+/**
+ * @brief Lee un archivo pequeño de sysfs (una línea) eliminando el '\n' final
+ * @return int 0 si éxito, -1 si el archivo no existe o no se pudo leer
+ */
+static int read_attr(const char *path, char *buf, size_t size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    ssize_t n = read(fd, buf, size - 1);
+    close(fd);
+    if (n <= 0) {
+        return -1;
+    }
+
+    buf[n] = '\0';
+    if (buf[n - 1] == '\n') {
+        buf[n - 1] = '\0';
+    }
+    return 0;
+}
+
+/**
+ * @brief Dominio de una zona a partir de su nombre
+ */
+static power_kind zone_kind(const char *name) {
+    if (strncmp(name, "package", 7) == 0 || strncmp(name, "Esocket", 7) == 0) {
+        return POWER_PACKAGE;
+    }
+    if (strncmp(name, "core", 4) == 0 || strncmp(name, "Ecore", 5) == 0) {
+        return POWER_CORE;
+    }
+    return POWER_OTHER;
+}
+
+/**
+ * @brief Añade una zona abriendo su contador
+ */
+static void add_zone(power_set *p, const char *name, power_kind kind,
+                     const char *counter, uint64_t max_range_uj) {
+    if (p->count >= POWER_MAX_ZONES) {
+        return;
+    }
+
+    power_zone *z = &p->z[p->count];
+    memset(z, 0, sizeof(*z));
+    z->fd = open(counter, O_RDONLY | O_CLOEXEC);
+    if (z->fd < 0) {
+        // energy_uj suele ser legible solo por root
+        return;
+    }
+    snprintf(z->name, sizeof(z->name), "%s", name);
+    z->kind = kind;
+    z->max_range_uj = max_range_uj;
+    p->count++;
+}
+
+/**
+ * @brief Descubre las zonas de <sysfs_root>/class/powercap/intel-rapl:*
+ * @description Las subzonas ("intel-rapl:0:0") se nombran con el nombre de
+ *              la zona padre delante ("package-0/core"). Las zonas
+ *              intel-rapl-mmio duplican las de MSR y se ignoran.
+ */
+static void discover_powercap(power_set *p, const char *sysfs_root) {
+    char dir[PATH_MAX];
+
+    snprintf(dir, sizeof(dir), "%s/class/powercap", sysfs_root);
+    DIR *d = opendir(dir);
+    if (!d) {
+        return;
+    }
+
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL) {
+        if (strncmp(de->d_name, "intel-rapl:", 11) != 0) {
+            continue;
+        }
+
+        char path[PATH_MAX + 64];
+        char leaf[POWER_NAME_LEN / 2];
+        char name[POWER_NAME_LEN];
+        char value[32];
+
+        // Rutas truncadas: la zona no se puede abrir con seguridad
+        if (snprintf(path, sizeof(path), "%s/%s/name", dir, de->d_name) >= (int)sizeof(path) ||
+            read_attr(path, leaf, sizeof(leaf)) < 0) {
+            continue;
+        }
+
+        // Subzona: anteponer el nombre de la zona padre
+        const char *last = strrchr(de->d_name, ':');
+        if (last && strchr(de->d_name, ':') != last) {
+            char parent[POWER_NAME_LEN / 2];
+            snprintf(path, sizeof(path), "%s/%.*s/name", dir, (int)(last - de->d_name), de->d_name);
+            if (read_attr(path, parent, sizeof(parent)) < 0) {
+                continue;
+            }
+            snprintf(name, sizeof(name), "%s/%s", parent, leaf);
+        } else {
+            snprintf(name, sizeof(name), "%s", leaf);
+        }
+
+        uint64_t max_range = 0;
+        if (snprintf(path, sizeof(path), "%s/%s/max_energy_range_uj", dir, de->d_name) < (int)sizeof(path) &&
+            read_attr(path, value, sizeof(value)) == 0) {
+            max_range = strtoull(value, NULL, 10);
+        }
+
+        if (snprintf(path, sizeof(path), "%s/%s/energy_uj", dir, de->d_name) < (int)sizeof(path)) {
+            add_zone(p, name, zone_kind(leaf), path, max_range);
+        }
+    }
+    closedir(d);
+}
+
+/**
+ * @brief Descubre los canales energyK_input del driver hwmon amd_energy
+ * @description Las etiquetas son "Esocket<N>" (paquete) y "Ecore<NNN>"
+ *              (núcleo). Los contadores son acumulados de 64 bits en el
+ *              driver, así que no tienen vuelta a cero.
+ */
+static void discover_hwmon(power_set *p, const char *sysfs_root) {
+    char dir[PATH_MAX];
+
+    snprintf(dir, sizeof(dir), "%s/class/hwmon", sysfs_root);
+    DIR *hwmon = opendir(dir);
+    if (!hwmon) {
+        return;
+    }
+
+    struct dirent *dev;
+    while ((dev = readdir(hwmon)) != NULL) {
+        char devdir[PATH_MAX + 16];
+        char attr[PATH_MAX + 64];
+        char driver[32];
+
+        if (strncmp(dev->d_name, "hwmon", 5) != 0) {
+            continue;
+        }
+        if (snprintf(devdir, sizeof(devdir), "%s/%s", dir, dev->d_name) >= (int)sizeof(devdir)) {
+            continue;
+        }
+        snprintf(attr, sizeof(attr), "%s/name", devdir);
+        if (read_attr(attr, driver, sizeof(driver)) < 0 || strcmp(driver, "amd_energy") != 0) {
+            continue;
+        }
+
+        DIR *d = opendir(devdir);
+        if (!d) {
+            continue;
+        }
+        struct dirent *e;
+        while ((e = readdir(d)) != NULL) {
+            unsigned k;
+            char tail[16];
+            char label[POWER_NAME_LEN];
+            if (sscanf(e->d_name, "energy%u_%15s", &k, tail) != 2 || strcmp(tail, "input") != 0) {
+                continue;
+            }
+            snprintf(attr, sizeof(attr), "%s/energy%u_label", devdir, k);
+            if (read_attr(attr, label, sizeof(label)) < 0) {
+                snprintf(label, sizeof(label), "energy%u", k);
+            }
+            if (snprintf(attr, sizeof(attr), "%s/%s", devdir, e->d_name) < (int)sizeof(attr)) {
+                add_zone(p, label, zone_kind(label), attr, 0);
+            }
+        }
+        closedir(d);
+    }
+    closedir(hwmon);
+}
+
+/**
+ * @brief Descubre las zonas de energía y abre sus contadores
+ */
+int power_open(power_set *p, const char *sysfs_root) {
+    memset(p, 0, sizeof(*p));
+    discover_powercap(p, sysfs_root);
+    discover_hwmon(p, sysfs_root);
+    return p->count;
+}
+
+/**
+ * @brief Lee todos los contadores y calcula la potencia del intervalo
+ */
+int power_sample(power_set *p, uint64_t now_ns, const acquire *a) {
+    char buf[POWER_READ_LEN];
+
+    if (p->count == 0) {
+        return -1;
+    }
+
+    p->package_w = p->core_w = 0.0;
+
+    for (int i = 0; i < p->count; i++) {
+        power_zone *z = &p->z[i];
+        ssize_t n = acquire_pread(a, z->fd, buf, sizeof(buf));
+        uint64_t uj = 0;
+        ssize_t j = 0;
+        for (; j < n && buf[j] >= '0' && buf[j] <= '9'; j++) {
+            uj = uj * 10 + (uint64_t)(buf[j] - '0');
+        }
+        if (j == 0) {
+            // Lectura fallida: se conservan lectura e instante anteriores, así
+            // el siguiente delta se divide por todo el tiempo transcurrido
+            z->watts = 0.0;
+            continue;
+        }
+
+        // El contador de RAPL vuelve a cero al llegar a max_energy_range_uj
+        // (unos 262 kJ: cerca de 20 minutos a 200 W)
+        uint64_t delta = 0;
+        if (uj >= z->last_uj) {
+            delta = uj - z->last_uj;
+        } else if (z->max_range_uj > z->last_uj) {
+            delta = z->max_range_uj - z->last_uj + uj;
+        }
+        double dt_s = z->primed && now_ns > z->last_ns ? (now_ns - z->last_ns) / 1e9 : 0.0;
+        z->watts = dt_s > 0.0 ? delta / 1e6 / dt_s : 0.0;
+        z->last_uj = uj;
+        z->last_ns = now_ns;
+        z->primed = 1;
+
+        if (z->kind == POWER_PACKAGE) {
+            p->package_w += z->watts;
+        } else if (z->kind == POWER_CORE) {
+            p->core_w += z->watts;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Cierra los contadores de todas las zonas
+ */
+void power_close(power_set *p) {
+    for (int i = 0; i < p->count; i++) {
+        if (p->z[i].fd >= 0) {
+            close(p->z[i].fd);
+        }
+    }
+    p->count = 0;
+}
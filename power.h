@@ -0,0 +1,91 @@
+/**
+ * @brief Header del módulo de energía y potencia (RAPL / powercap)
+ * @description Define la interfaz para leer los contadores de energía del
+ *              procesador en cada ciclo del daemon y convertirlos en potencia
+ *              media del intervalo. Se admiten dos fuentes bajo sysfs_root:
+ *              - class/powercap/intel-rapl:* (Intel y AMD Zen con el driver
+ *                powercap), con la vuelta a cero del contador en
+ *                max_energy_range_uj
+ *              - class/hwmon/hwmonN/energyK_input (driver amd_energy)
+ *              Los descriptores de los contadores se mantienen abiertos y se
+ *              leen con pread(). Con un sysfs_root falso se puede probar en
+ *              máquinas sin RAPL.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef POWER_H  // Si POWER_H no está definido
+#define POWER_H  // Definir POWER_H como macro de protección
+
+#include <stdint.h>  // Para tipos de ancho fijo
+#include "acquire.h" // Para acquire (lecturas servidas por el lote del ciclo)
+
+// Número máximo de zonas de energía
+#define POWER_MAX_ZONES 64
+
+// Longitud máxima del nombre de una zona ("package-0/core")
+#define POWER_NAME_LEN 48
+
+// Bytes leídos de cada energy_uj
+#define POWER_READ_LEN 32
+
+/**
+ * @brief Tipo de dominio de una zona
+ */
+typedef enum {
+    POWER_PACKAGE,  // Paquete (socket) completo
+    POWER_CORE,     // Núcleos (PP0 o un núcleo concreto en amd_energy)
+    POWER_OTHER     // uncore, dram, psys...: se informan pero no se suman
+} power_kind;
+
+/**
+ * @brief Zona de energía con su contador abierto
+ */
+typedef struct {
+    char name[POWER_NAME_LEN];  // Nombre legible de la zona
+    power_kind kind;            // Dominio de la zona
+    int fd;                     // Descriptor del contador de energía (µJ)
+    uint64_t max_range_uj;      // Valor en el que el contador vuelve a cero (0 = no vuelve)
+    uint64_t last_uj;           // Última lectura válida
+    uint64_t last_ns;           // Instante de last_uj (CLOCK_MONOTONIC)
+    double watts;               // Potencia media del último intervalo
+    int primed;                 // 1 si ya hay una lectura previa
+} power_zone;
+
+/**
+ * @brief Conjunto de zonas de energía descubiertas
+ */
+typedef struct {
+    int count;                          // Zonas válidas en z[]
+    power_zone z[POWER_MAX_ZONES];
+    double package_w;                   // Suma de las zonas POWER_PACKAGE
+    double core_w;                      // Suma de las zonas POWER_CORE
+} power_set;
+
+/**
+ * @brief Descubre las zonas de energía y abre sus contadores
+ *
+ * @param p          Conjunto a inicializar
+ * @param sysfs_root Raíz de sysfs
+ *
+ * @return int Número de zonas (0 si la máquina no expone contadores)
+ */
+int power_open(power_set *p, const char *sysfs_root);
+
+/**
+ * @brief Lee todos los contadores y calcula la potencia del intervalo
+ *
+ * @param p      Conjunto de zonas
+ * @param now_ns Instante de la lectura (CLOCK_MONOTONIC)
+ * @param a      Lote del ciclo (NULL = pread() directa)
+ *
+ * @return int 0 si éxito, -1 si no hay zonas
+ */
+int power_sample(power_set *p, uint64_t now_ns, const acquire *a);
+
+/**
+ * @brief Cierra los contadores de todas las zonas
+ */
+void power_close(power_set *p);
+
+#endif // POWER_H - Fin de las guardas de inclusión
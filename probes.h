@@ -0,0 +1,55 @@
+/**
+ * @brief Puntos de traza estáticos (USDT) del daemon
+ * @description Define macros para los probes estáticos del daemon,
+ *              compatibles con perf, bpftrace y SystemTap. Cuando el header
+ *              <sys/sdt.h> está disponible (paquete systemtap-sdt-dev), cada
+ *              probe compila a una sola instrucción NOP más una nota ELF
+ *              (.note.stapsdt) que describe sus argumentos: el coste con el
+ *              probe desactivado es nulo y las herramientas de traza lo
+ *              activan sobre el binario ya compilado, sin recompilar.
+ *              Sin <sys/sdt.h> las macros no generan código.
+ *
+ * @details Probes del proveedor "cpu_daemon":
+ *          - sensor_read(canal, miligrados)                ← temp_monitor.c
+ *          - sample_acquired(canal, miligrados, lat_ns)    ← main.c
+ *          - record_written(canal, miligrados, lat_ns)     ← main.c
+ *          - alert_raised(canal, miligrados, umbral_mC)    ← main.c
+ *          - alert_dispatched(canal, miligrados, lat_ns)   ← main.c
+ *          El canal es el índice en la tabla de sensores (-1 = 'sensors').
+ *          Las temperaturas se pasan como enteros en miligrados porque los
+ *          argumentos USDT se leen como enteros desde registros.
+ *
+ * @example Listar y trazar los probes:
+ *          ```bash
+ *          perf list sdt_cpu_daemon:*
+ *          bpftrace -l 'usdt:./cpu_daemon:*'
+ *          bpftrace -e 'usdt:./cpu_daemon:cpu_daemon:sample_acquired
+ *                       { printf("%d %d.%03d C %d ns\n", arg0,
+ *                                arg1 / 1000, arg1 % 1000, arg2); }'
+ *          ```
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef PROBES_H  // Si PROBES_H no está definido
+#define PROBES_H  // Definir PROBES_H como macro de protección
+
+#ifdef HAVE_SYS_SDT_H
+#include <sys/sdt.h>  // Para DTRACE_PROBEn()
+
+#define PROBE_SENSOR_READ(ch, mc)              DTRACE_PROBE2(cpu_daemon, sensor_read, ch, mc)
+#define PROBE_SAMPLE_ACQUIRED(ch, mc, ns)      DTRACE_PROBE3(cpu_daemon, sample_acquired, ch, mc, ns)
+#define PROBE_RECORD_WRITTEN(ch, mc, ns)       DTRACE_PROBE3(cpu_daemon, record_written, ch, mc, ns)
+#define PROBE_ALERT_RAISED(ch, mc, thr)        DTRACE_PROBE3(cpu_daemon, alert_raised, ch, mc, thr)
+#define PROBE_ALERT_DISPATCHED(ch, mc, ns)     DTRACE_PROBE3(cpu_daemon, alert_dispatched, ch, mc, ns)
+#else
+// Los argumentos se consumen con (void) para no generar avisos de variables
+// sin usar; el compilador elimina el código por completo
+#define PROBE_SENSOR_READ(ch, mc)              do { (void)(ch); (void)(mc); } while (0)
+#define PROBE_SAMPLE_ACQUIRED(ch, mc, ns)      do { (void)(ch); (void)(mc); (void)(ns); } while (0)
+#define PROBE_RECORD_WRITTEN(ch, mc, ns)       do { (void)(ch); (void)(mc); (void)(ns); } while (0)
+#define PROBE_ALERT_RAISED(ch, mc, thr)        do { (void)(ch); (void)(mc); (void)(thr); } while (0)
+#define PROBE_ALERT_DISPATCHED(ch, mc, ns)     do { (void)(ch); (void)(mc); (void)(ns); } while (0)
+#endif
+
+#endif // PROBES_H - Fin de las guardas de inclusión
@@ -0,0 +1,454 @@
+/**
+ * @brief Módulo de atribución de consumo de CPU por proceso
+ * @description Implementa la tabla incremental de procesos. Decisiones de
+ *              diseño para que un escaneo de miles de procesos cueste pocos
+ *              milisegundos:
+ *              - Direccionamiento abierto con sondeo lineal y borrado por
+ *                desplazamiento hacia atrás (sin marcas de borrado), en un
+ *                único arreglo que se reutiliza entre escaneos.
+ *              - openat() + pread() + close() por PID, relativos al
+ *                directorio /proc ya abierto: el coste no depende del límite
+ *                de descriptores (RLIMIT_NOFILE no se modifica) y el daemon no
+ *                retiene miles de descriptores entre escaneos.
+ *              - Lectura periódica de /proc/<pid>/schedstat (tiempo de CPU
+ *                en ns), que el kernel genera varias veces más rápido que
+ *                stat; stat solo se lee al descubrir un proceso (para comm)
+ *                o si el kernel no expone schedstat.
+ *              - Parser manual de stat y schedstat en lugar de sscanf().
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdlib.h>     // Para calloc(), free()
+#include <string.h>     // Para memcpy(), memset()
+#include <unistd.h>     // Para pread(), close(), sysconf()
+#include <fcntl.h>      // Para openat() y constantes O_*
+#include <time.h>       // Para clock_gettime()
+#include "proc_top.h"   // Header con declaraciones del módulo
+
+// Capacidad inicial de la tabla (se duplica al superar el 50 % de ocupación)
+#define PROC_TABLE_INITIAL_CAP 1024
+
+/**
+ * @brief Posición inicial de un PID en la tabla (hash multiplicativo)
+ */
+static size_t slot_of(const proc_table *t, int pid) {
+    return ((uint32_t)pid * 2654435761u) & (t->cap - 1);
+}
+
+/**
+ * @brief Tiempo monótono actual en nanosegundos
+ */
+static uint64_t mono_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Inicializa la tabla y abre el directorio de procesos
+ */
+int proc_table_init(proc_table *t, const char *proc_root) {
+    memset(t, 0, sizeof(*t));
+    t->cap = PROC_TABLE_INITIAL_CAP;
+    t->slots = calloc(t->cap, sizeof(proc_entry));
+    t->clk_tck = sysconf(_SC_CLK_TCK);
+    t->proc_fd = open(proc_root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (!t->slots || t->proc_fd < 0) {
+        proc_table_free(t);
+        return -1;
+    }
+
+    // schedstat requiere CONFIG_SCHED_INFO; si no existe se usa stat
+    t->use_schedstat = faccessat(t->proc_fd, "self/schedstat", R_OK, 0) == 0;
+
+    // fdopendir() se queda con una copia para poder seguir usando proc_fd
+    t->dir = fdopendir(dup(t->proc_fd));
+    if (!t->dir) {
+        proc_table_free(t);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Inserta una entrada ya inicializada en su posición (sin duplicados)
+ */
+static void insert_entry(proc_table *t, const proc_entry *e) {
+    size_t i = slot_of(t, e->pid);
+    while (t->slots[i].pid != 0) {
+        i = (i + 1) & (t->cap - 1);
+    }
+    t->slots[i] = *e;
+    t->used++;
+}
+
+/**
+ * @brief Duplica la capacidad de la tabla y reubica las entradas
+ * @return int 0 si éxito, -1 si no hay memoria (la tabla queda intacta)
+ */
+static int grow(proc_table *t) {
+    proc_entry *old = t->slots;
+    size_t old_cap = t->cap;
+    proc_entry *slots = calloc(old_cap * 2, sizeof(proc_entry));
+
+    if (!slots) {
+        return -1;
+    }
+    t->slots = slots;
+    t->cap = old_cap * 2;
+    t->used = 0;
+    for (size_t i = 0; i < old_cap; i++) {
+        if (old[i].pid != 0) {
+            insert_entry(t, &old[i]);
+        }
+    }
+    free(old);
+    return 0;
+}
+
+/**
+ * @brief Busca un PID o reserva una ranura libre para él
+ * @return proc_entry* Entrada (nueva con gen = 0), o NULL si la
+ *                     tabla está llena y no se pudo ampliar
+ */
+static proc_entry *lookup(proc_table *t, int pid) {
+    if ((t->used + 1) * 2 > t->cap && grow(t) < 0 && t->used + 1 >= t->cap) {
+        return NULL;
+    }
+
+    size_t i = slot_of(t, pid);
+    while (t->slots[i].pid != 0) {
+        if (t->slots[i].pid == pid) {
+            return &t->slots[i];
+        }
+        i = (i + 1) & (t->cap - 1);
+    }
+
+    proc_entry *e = &t->slots[i];
+    memset(e, 0, sizeof(*e));
+    e->pid = pid;
+    t->used++;
+    return e;
+}
+
+/**
+ * @brief Elimina la entrada de la ranura i (borrado por desplazamiento)
+ * @description Mueve hacia atrás las entradas siguientes del mismo grupo de
+ *              sondeo cuya posición ideal no queda entre el hueco y ellas,
+ *              de modo que las búsquedas nunca se cortan en un hueco falso.
+ */
+static void remove_at(proc_table *t, size_t i) {
+    size_t mask = t->cap - 1;
+
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (t->slots[j].pid == 0) {
+            break;
+        }
+        size_t k = slot_of(t, t->slots[j].pid);
+        // ¿Está k cíclicamente en (i, j]? Entonces la entrada se queda
+        int in_range = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+        if (!in_range) {
+            t->slots[i] = t->slots[j];
+            i = j;
+        }
+    }
+    memset(&t->slots[i], 0, sizeof(t->slots[i]));
+    t->used--;
+}
+
+/**
+ * @brief Convierte dígitos decimales en un entero sin signo avanzando el cursor
+ */
+static uint64_t parse_u64(const char **p, const char *end) {
+    uint64_t v = 0;
+    const char *s = *p;
+    while (s < end && *s >= '0' && *s <= '9') {
+        v = v * 10 + (uint64_t)(*s - '0');
+        s++;
+    }
+    *p = s;
+    return v;
+}
+
+/**
+ * @brief Salta @p n campos separados por espacios
+ */
+static const char *skip_fields(const char *s, const char *end, int n) {
+    while (n > 0 && s < end) {
+        if (*s++ == ' ') {
+            n--;
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief Extrae comm y utime + stime (en ticks) de /proc/<pid>/stat
+ * @description Formato: "pid (comm) state ppid ... utime(14) stime(15) ...".
+ *              comm puede contener espacios y ')', por eso se busca el
+ *              ÚLTIMO ')' y se cuentan campos desde ahí.
+ *
+ * @return int 0 si éxito, -1 si el contenido no tiene el formato esperado
+ */
+static int parse_stat(const char *buf, size_t len, char comm[16], uint64_t *ticks) {
+    const char *end = buf + len;
+    const char *open_paren = buf;
+    const char *close_paren = end;
+
+    while (open_paren < end && *open_paren != '(') {
+        open_paren++;
+    }
+    while (close_paren > open_paren && *--close_paren != ')') {
+    }
+    if (open_paren >= end || close_paren <= open_paren) {
+        return -1;
+    }
+
+    size_t comm_len = (size_t)(close_paren - open_paren - 1);
+    if (comm_len > 15) {
+        comm_len = 15;
+    }
+    memcpy(comm, open_paren + 1, comm_len);
+    comm[comm_len] = '\0';
+
+    // Tras ") " viene el campo 3 (state); utime es el campo 14
+    const char *s = skip_fields(close_paren + 2, end, 11);
+    uint64_t utime = parse_u64(&s, end);
+    s = skip_fields(s, end, 1);
+    if (s >= end) {
+        return -1;
+    }
+    *ticks = utime + parse_u64(&s, end);
+    return 0;
+}
+
+/**
+ * @brief Construye la ruta relativa "<pid>/<name>" sin snprintf()
+ */
+static void pid_path(char *out, int pid, const char *name) {
+    char digits[12];
+    int nd = 0, pos = 0;
+
+    do {
+        digits[nd++] = (char)('0' + pid % 10);
+        pid /= 10;
+    } while (pid > 0);
+    while (nd > 0) {
+        out[pos++] = digits[--nd];
+    }
+    out[pos++] = '/';
+    while (*name) {
+        out[pos++] = *name++;
+    }
+    out[pos] = '\0';
+}
+
+/**
+ * @brief Lee un archivo de un proceso con openat() + pread() + close()
+ * @return ssize_t Bytes leídos, <= 0 si el proceso terminó o no es legible
+ */
+static ssize_t read_pid_file(const proc_table *t, int pid, const char *name,
+                             char *buf, size_t size) {
+    char path[32];
+
+    pid_path(path, pid, name);
+    int fd = openat(t->proc_fd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = pread(fd, buf, size, 0);
+    close(fd);
+    return n;
+}
+
+/**
+ * @brief Lee el stat de un proceso (comm y tiempo de CPU)
+ * @return int 0 si éxito, -1 si el proceso terminó o no es legible
+ */
+static int read_stat(proc_table *t, proc_entry *e, uint64_t *cpu_ns) {
+    char buf[1024];
+    uint64_t ticks;
+
+    ssize_t n = read_pid_file(t, e->pid, "stat", buf, sizeof(buf));
+    if (n <= 0 || parse_stat(buf, (size_t)n, e->comm, &ticks) < 0) {
+        return -1;
+    }
+    *cpu_ns = ticks * (1000000000ull / (uint64_t)t->clk_tck);
+    return 0;
+}
+
+/**
+ * @brief Relee el tiempo de CPU de un proceso conocido
+ * @description schedstat: "<ns en CPU> <ns en espera> <rodajas>\n".
+ *              Sin schedstat se relee stat. Si el PID se reutilizó entre dos
+ *              escaneos el tiempo leído es el de la tarea nueva; un valor
+ *              menor que el anterior se toma entero como delta.
+ *
+ * @return int 0 si éxito, -1 si el proceso terminó
+ */
+static int read_cpu(proc_table *t, proc_entry *e, uint64_t *cpu_ns) {
+    char buf[1024];
+
+    ssize_t n = read_pid_file(t, e->pid, t->use_schedstat ? "schedstat" : "stat",
+                              buf, sizeof(buf));
+    if (n <= 0) {
+        return -1;
+    }
+
+    if (t->use_schedstat) {
+        const char *s = buf;
+        *cpu_ns = parse_u64(&s, buf + n);
+        return 0;
+    }
+
+    uint64_t ticks;
+    if (parse_stat(buf, (size_t)n, e->comm, &ticks) < 0) {
+        return -1;
+    }
+    *cpu_ns = ticks * (1000000000ull / (uint64_t)t->clk_tck);
+    return 0;
+}
+
+/**
+ * @brief Actualiza el delta de CPU de una entrada
+ * @return int 0 si el proceso sigue vivo, -1 si terminó o no es legible
+ */
+static int update_entry(proc_table *t, proc_entry *e, int first_scan) {
+    uint64_t cpu_ns;
+
+    if (e->gen == 0) {
+        // Proceso nuevo: leer comm; todo su tiempo de CPU ocurrió desde el
+        // escaneo anterior, salvo en el primer escaneo
+        if (read_stat(t, e, &cpu_ns) < 0) {
+            return -1;
+        }
+        if (t->use_schedstat && read_cpu(t, e, &cpu_ns) < 0) {
+            return -1;
+        }
+        e->delta_ns = first_scan ? 0 : cpu_ns;
+    } else {
+        if (read_cpu(t, e, &cpu_ns) < 0) {
+            return -1;
+        }
+        e->delta_ns = cpu_ns >= e->cpu_ns ? cpu_ns - e->cpu_ns : cpu_ns;
+    }
+
+    e->cpu_ns = cpu_ns;
+    e->gen = t->gen;
+    return 0;
+}
+
+/**
+ * @brief Escanea todos los procesos y actualiza sus deltas de CPU
+ */
+int proc_table_scan(proc_table *t) {
+    int first_scan = t->last_ns == 0;
+    int alive = 0;
+
+    t->gen++;
+    if (t->gen == 0) {
+        // Se reserva la generación 0 para "entrada nueva"
+        t->gen = 1;
+    }
+    rewinddir(t->dir);
+
+    struct dirent *de;
+    while ((de = readdir(t->dir)) != NULL) {
+        // Solo directorios numéricos (PIDs)
+        const char *s = de->d_name;
+        int pid = 0;
+        while (*s >= '0' && *s <= '9') {
+            pid = pid * 10 + (*s - '0');
+            s++;
+        }
+        if (*s != '\0' || pid <= 0) {
+            continue;
+        }
+
+        proc_entry *e = lookup(t, pid);
+        if (e && update_entry(t, e, first_scan) == 0) {
+            alive++;
+        }
+    }
+
+    // Barrido: eliminar procesos que no se vieron en este escaneo. Tras un
+    // borrado se vuelve a examinar la misma ranura, que pudo recibir otra
+    for (size_t i = 0; i < t->cap; i++) {
+        while (t->slots[i].pid != 0 && t->slots[i].gen != t->gen) {
+            remove_at(t, i);
+        }
+    }
+
+    uint64_t now = mono_ns();
+    t->elapsed_s = first_scan ? 0.0 : (double)(now - t->last_ns) / 1e9;
+    t->last_ns = now;
+    return alive;
+}
+
+/**
+ * @brief Obtiene los @p n procesos con mayor delta de CPU
+ * @description Selección parcial por inserción: O(procesos × n), sin ordenar
+ *              la tabla completa ni reservar memoria.
+ */
+int proc_table_top(proc_table *t, proc_usage *out, int n) {
+    proc_entry *best[PROC_TOP_MAX];
+    int count = 0;
+
+    if (n > PROC_TOP_MAX) {
+        n = PROC_TOP_MAX;
+    }
+    if (n <= 0 || t->elapsed_s <= 0.0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < t->cap; i++) {
+        proc_entry *e = &t->slots[i];
+        if (e->pid == 0 || e->delta_ns == 0) {
+            continue;
+        }
+        if (count == n && e->delta_ns <= best[count - 1]->delta_ns) {
+            continue;
+        }
+
+        int pos = count < n ? count++ : n - 1;
+        while (pos > 0 && best[pos - 1]->delta_ns < e->delta_ns) {
+            best[pos] = best[pos - 1];
+            pos--;
+        }
+        best[pos] = e;
+    }
+
+    for (int i = 0; i < count; i++) {
+        uint64_t unused;
+        // Refrescar comm (un exec() pudo cambiarlo); si el proceso ya
+        // terminó se conserva el último nombre conocido
+        if (t->use_schedstat) {
+            read_stat(t, best[i], &unused);
+        }
+        out[i].pid = best[i]->pid;
+        memcpy(out[i].comm, best[i]->comm, sizeof(out[i].comm));
+        out[i].cpu_pct = 100.0 * (double)best[i]->delta_ns / (t->elapsed_s * 1e9);
+    }
+    return count;
+}
+
+/**
+ * @brief Libera la tabla y cierra el directorio de procesos
+ */
+void proc_table_free(proc_table *t) {
+    if (t->slots) {
+        free(t->slots);
+        t->slots = NULL;
+    }
+    if (t->dir) {
+        closedir(t->dir);
+        t->dir = NULL;
+    }
+    if (t->proc_fd >= 0) {
+        close(t->proc_fd);
+    }
+    t->proc_fd = -1;
+}
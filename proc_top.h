@@ -0,0 +1,103 @@
+/**
+ * @brief Header del módulo de atribución de consumo de CPU por proceso
+ * @description Define una tabla incremental de tiempo de CPU por proceso,
+ *              alimentada desde procfs. La tabla usa direccionamiento
+ *              abierto indexado por PID y se reutiliza entre escaneos. Un
+ *              escaneo cuesta openat() + pread() + close() por proceso; no se
+ *              retienen descriptores. El daemon no escanea en cada ciclo:
+ *              conserva el último escaneo como referencia y, cuando se
+ *              dispara una alerta, escanea de nuevo y proc_table_top()
+ *              devuelve los procesos que más CPU consumieron entre ambos.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef PROC_TOP_H  // Si PROC_TOP_H no está definido
+#define PROC_TOP_H  // Definir PROC_TOP_H como macro de protección
+
+#include <stddef.h>  // Para size_t
+#include <stdint.h>  // Para uint64_t, uint32_t
+#include <dirent.h>  // Para DIR
+
+// Número máximo de procesos en un ranking
+#define PROC_TOP_MAX 16
+
+// Antigüedad máxima del escaneo de referencia (segundos): acota el intervalo
+// sobre el que se promedia el consumo de la primera alerta
+#define PROC_BASELINE_S 30
+
+/**
+ * @brief Consumo de CPU de un proceso en el último intervalo
+ */
+typedef struct {
+    int pid;           // PID del proceso
+    char comm[16];     // Nombre del ejecutable (campo comm de stat)
+    double cpu_pct;    // % de una CPU usado desde el escaneo anterior
+} proc_usage;
+
+/**
+ * @brief Entrada de la tabla de procesos
+ */
+typedef struct {
+    int pid;           // 0 = ranura libre
+    uint32_t gen;      // Generación del último escaneo en que se vio
+    uint64_t cpu_ns;   // Tiempo de CPU acumulado en el último escaneo
+    uint64_t delta_ns; // Tiempo de CPU consumido entre los dos últimos escaneos
+    char comm[16];     // Nombre del ejecutable
+} proc_entry;
+
+/**
+ * @brief Tabla de procesos con direccionamiento abierto (sondeo lineal)
+ */
+typedef struct {
+    proc_entry *slots;    // Ranuras (capacidad potencia de 2)
+    size_t cap;           // Número de ranuras
+    size_t used;          // Ranuras ocupadas
+    uint32_t gen;         // Generación del escaneo actual
+    int proc_fd;          // Descriptor del directorio /proc (para openat)
+    DIR *dir;             // Directorio /proc reutilizado con rewinddir()
+    uint64_t last_ns;     // Instante del último escaneo (CLOCK_MONOTONIC)
+    double elapsed_s;     // Segundos entre los dos últimos escaneos
+    long clk_tck;         // Ticks de reloj por segundo (sysconf)
+    int use_schedstat;    // 1 si el kernel expone /proc/<pid>/schedstat
+} proc_table;
+
+/**
+ * @brief Inicializa la tabla y abre el directorio de procesos
+ *
+ * @param t         Tabla a inicializar
+ * @param proc_root Raíz de procfs, normalmente "/proc"
+ *
+ * @return int 0 si éxito, -1 si error
+ */
+int proc_table_init(proc_table *t, const char *proc_root);
+
+/**
+ * @brief Escanea todos los procesos y actualiza sus deltas de CPU
+ * @description Recorre /proc, añade los procesos nuevos, relee el tiempo de
+ *              CPU de los conocidos y elimina los que terminaron. Los deltas
+ *              cubren el intervalo desde el escaneo anterior.
+ *
+ * @return int Número de procesos vivos, -1 si error
+ */
+int proc_table_scan(proc_table *t);
+
+/**
+ * @brief Obtiene los @p n procesos con mayor delta de CPU
+ * @description Refresca el nombre (comm) de los procesos elegidos, que
+ *              pudo cambiar por un exec() después de entrar en la tabla.
+ *
+ * @param t   Tabla escaneada al menos dos veces
+ * @param out Arreglo destino ordenado de mayor a menor consumo
+ * @param n   Tamaño del ranking (máximo PROC_TOP_MAX)
+ *
+ * @return int Número de procesos devueltos (con delta > 0)
+ */
+int proc_table_top(proc_table *t, proc_usage *out, int n);
+
+/**
+ * @brief Libera la tabla y cierra el directorio de procesos
+ */
+void proc_table_free(proc_table *t);
+
+#endif // PROC_TOP_H - Fin de las guardas de inclusión
@@ -0,0 +1,150 @@
+/**
+ * @brief Módulo de Pressure Stall Information (PSI)
+ * @description Implementa la lectura de /proc/pressure con pread() sobre
+ *              descriptores persistentes y un parser que recorre el buffer
+ *              leído en su sitio, sin copiar ni tokenizar las líneas.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdio.h>     // Para snprintf()
+#include <string.h>    // Para memset(), memcmp()
+#include <unistd.h>    // Para pread(), close()
+#include <fcntl.h>     // Para open() y constantes O_*
+#include <limits.h>    // Para PATH_MAX
+#include "psi.h"       // Header con declaraciones del módulo
+
+// Nombres de los recursos (mismo orden que psi_resource)
+static const char *const resource_names[PSI_RESOURCES] = {"cpu", "memory", "io"};
+
+/**
+ * @brief Abre los archivos de presión de todos los recursos
+ */
+int psi_open(psi_set *p, const char *proc_root) {
+    char path[PATH_MAX];
+    int n = 0;
+
+    memset(p, 0, sizeof(*p));
+    for (int i = 0; i < PSI_RESOURCES; i++) {
+        snprintf(path, sizeof(path), "%s/pressure/%s", proc_root, resource_names[i]);
+        p->r[i].fd = open(path, O_RDONLY | O_CLOEXEC);
+        n += p->r[i].fd >= 0;
+    }
+    return n;
+}
+
+/**
+ * @brief Lee un número con hasta dos decimales como entero x100
+ * @description "3.04" -> 304. Avanza *pp hasta el primer carácter que no
+ *              forma parte del número.
+ */
+static uint32_t parse_centi(const char **pp, const char *end) {
+    const char *p = *pp;
+    uint32_t v = 0;
+    int decimals = -1;
+
+    for (; p < end; p++) {
+        if (*p >= '0' && *p <= '9') {
+            if (decimals >= 2) {
+                continue;
+            }
+            v = v * 10 + (uint32_t)(*p - '0');
+            if (decimals >= 0) {
+                decimals++;
+            }
+        } else if (*p == '.' && decimals < 0) {
+            decimals = 0;
+        } else {
+            break;
+        }
+    }
+    for (int d = decimals < 0 ? 0 : decimals; d < 2; d++) {
+        v *= 10;
+    }
+    *pp = p;
+    return v;
+}
+
+/**
+ * @brief Extrae avg10 y total de una línea "some|full avg10=X ... total=N"
+ * @description Solo se convierten los valores de "avg10=" y "total=";
+ *              avg60 y avg300 se saltan carácter a carácter.
+ *
+ * @return const char* Inicio de la línea siguiente
+ */
+static const char *parse_line(const char *p, const char *end, uint32_t *avg10, uint64_t *total) {
+    while (p < end && *p != '\n') {
+        if (end - p > 6 && memcmp(p, "avg10=", 6) == 0) {
+            p += 6;
+            *avg10 = parse_centi(&p, end);
+        } else if (end - p > 6 && memcmp(p, "total=", 6) == 0) {
+            uint64_t v = 0;
+            for (p += 6; p < end && *p >= '0' && *p <= '9'; p++) {
+                v = v * 10 + (uint64_t)(*p - '0');
+            }
+            *total = v;
+        } else {
+            p++;
+        }
+    }
+    return p < end ? p + 1 : end;
+}
+
+/**
+ * @brief Lee todos los recursos y calcula los deltas del intervalo
+ */
+int psi_sample(psi_set *p, const acquire *a) {
+    char buf[PSI_READ_LEN];
+    int ok = 0;
+
+    for (int i = 0; i < PSI_RESOURCES; i++) {
+        psi_state *s = &p->r[i];
+        if (s->fd < 0) {
+            continue;
+        }
+
+        ssize_t n = acquire_pread(a, s->fd, buf, sizeof(buf));
+        if (n <= 0) {
+            continue;
+        }
+
+        const char *q = buf;
+        const char *end = buf + n;
+        uint64_t some_total = s->some_total, full_total = s->full_total;
+        while (q < end) {
+            if (end - q > 5 && memcmp(q, "some ", 5) == 0) {
+                q = parse_line(q + 5, end, &s->some_avg10, &some_total);
+            } else if (end - q > 5 && memcmp(q, "full ", 5) == 0) {
+                q = parse_line(q + 5, end, &s->full_avg10, &full_total);
+            } else {
+                break;
+            }
+        }
+
+        s->d_some_us = s->primed && some_total >= s->some_total ? some_total - s->some_total : 0;
+        s->d_full_us = s->primed && full_total >= s->full_total ? full_total - s->full_total : 0;
+        s->some_total = some_total;
+        s->full_total = full_total;
+        s->primed = 1;
+        ok = 1;
+    }
+    return ok ? 0 : -1;
+}
+
+/**
+ * @brief Nombre de un recurso ("cpu", "memory", "io")
+ */
+const char *psi_resource_name(psi_resource r) {
+    return r >= 0 && r < PSI_RESOURCES ? resource_names[r] : "?";
+}
+
+/**
+ * @brief Cierra los archivos de presión
+ */
+void psi_close(psi_set *p) {
+    for (int i = 0; i < PSI_RESOURCES; i++) {
+        if (p->r[i].fd >= 0) {
+            close(p->r[i].fd);
+        }
+        p->r[i].fd = -1;
+    }
+}
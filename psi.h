@@ -0,0 +1,87 @@
+/**
+ * @brief Header del módulo de Pressure Stall Information (PSI)
+ * @description Define la interfaz para leer /proc/pressure/{cpu,memory,io}
+ *              en cada ciclo del daemon. Cada archivo tiene dos líneas
+ *              ("some" y "full") con medias móviles (avg10, avg60, avg300)
+ *              y el tiempo total de espera acumulado en microsegundos. Se
+ *              guardan avg10 y el delta del total desde la muestra anterior,
+ *              que es el tiempo de espera visible por las aplicaciones
+ *              durante el intervalo de la lectura de temperatura.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef PSI_H  // Si PSI_H no está definido
+#define PSI_H  // Definir PSI_H como macro de protección
+
+#include <stdint.h>  // Para tipos de ancho fijo
+#include "acquire.h" // Para acquire (lecturas servidas por el lote del ciclo)
+
+// Bytes leídos de cada /proc/pressure/<recurso>
+#define PSI_READ_LEN 256
+
+/**
+ * @brief Recursos con información de presión
+ */
+typedef enum {
+    PSI_CPU,
+    PSI_MEMORY,
+    PSI_IO,
+    PSI_RESOURCES
+} psi_resource;
+
+/**
+ * @brief Estado de la presión de un recurso
+ * @description Los avg10 se guardan en centésimas de punto porcentual (la
+ *              misma resolución que muestra el kernel) para no usar coma
+ *              flotante al parsear.
+ */
+typedef struct {
+    int fd;                   // Descriptor de /proc/pressure/<recurso> (-1 = no disponible)
+    uint32_t some_avg10;      // % de tiempo con alguna tarea esperando (x100)
+    uint32_t full_avg10;      // % de tiempo con todas las tareas esperando (x100)
+    uint64_t some_total;      // Totales acumulados de la última lectura (µs)
+    uint64_t full_total;
+    uint64_t d_some_us;       // Espera "some" durante el último intervalo
+    uint64_t d_full_us;       // Espera "full" durante el último intervalo
+    int primed;               // 1 si ya hay una lectura previa para deltas
+} psi_state;
+
+/**
+ * @brief Presión de todos los recursos
+ */
+typedef struct {
+    psi_state r[PSI_RESOURCES];
+} psi_set;
+
+/**
+ * @brief Abre los archivos de presión de todos los recursos
+ *
+ * @param p         Conjunto a inicializar
+ * @param proc_root Raíz de procfs
+ *
+ * @return int Número de recursos disponibles (0 si el kernel no tiene PSI)
+ */
+int psi_open(psi_set *p, const char *proc_root);
+
+/**
+ * @brief Lee todos los recursos y calcula los deltas del intervalo
+ *
+ * @param p Conjunto de recursos
+ * @param a Lote del ciclo (NULL = pread() directa)
+ *
+ * @return int 0 si éxito, -1 si ningún recurso está disponible
+ */
+int psi_sample(psi_set *p, const acquire *a);
+
+/**
+ * @brief Nombre de un recurso ("cpu", "memory", "io")
+ */
+const char *psi_resource_name(psi_resource r);
+
+/**
+ * @brief Cierra los archivos de presión
+ */
+void psi_close(psi_set *p);
+
+#endif // PSI_H - Fin de las guardas de inclusión
@@ -0,0 +1,11 @@
+#!/bin/bash
+
+if pgrep -x "cpu_daemon" > /dev/null
+then
+    echo "🔄 Recargando configuración del daemon..."
+    # SIGHUP: recarga la configuración y reabre el log sin detener el muestreo
+    pkill -HUP -x "cpu_daemon"
+    echo "✅ Recarga solicitada."
+else
+    echo "🟡 El daemon no está corriendo."
+fi
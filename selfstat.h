@@ -0,0 +1,119 @@
+/**
+ * @brief Header del módulo de auto-instrumentación del daemon
+ * @description Define histogramas de latencia por etapa del ciclo de
+ *              muestreo (lectura del sensor, formateo, flush, notificación,
+ *              instantánea) y contadores de salud del propio daemon. El
+ *              registro cuesta una lectura de CLOCK_MONOTONIC (vDSO, sin
+ *              syscall) y unas pocas sumas, así que puede quedar activo
+ *              siempre en producción.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef SELFSTAT_H  // Si SELFSTAT_H no está definido
+#define SELFSTAT_H  // Definir SELFSTAT_H como macro de protección
+
+#include <stdio.h>   // Para FILE
+#include <stdint.h>  // Para uint64_t
+#include <time.h>    // Para clock_gettime()
+
+// Cubetas logarítmicas: la cubeta i cubre [2^i, 2^(i+1)) ns (hasta ~4 s)
+#define SELFSTAT_BUCKETS 32
+
+/**
+ * @brief Etapas instrumentadas del ciclo de muestreo
+ */
+typedef enum {
+    STAGE_ACQUIRE,   // Lectura de temperatura (sysfs o 'sensors')
+    STAGE_FORMAT,    // fprintf() de la línea de log al buffer de stdio
+    STAGE_FLUSH,     // fflush() del log (write al archivo)
+    STAGE_NOTIFY,    // send_notification()
+    STAGE_SNAPSHOT,  // Guardado periódico de la instantánea
+    STAGE_CYCLE,     // Ciclo completo de muestreo
+    // Las etapas nuevas se añaden al final: el log binario guarda el índice
+    STAGE_ATTRIBUTE, // Escaneo de procesos para atribución de consumo
+    STAGE_CGROUP,    // Muestreo de cpu.stat de los cgroups
+    STAGE_COUNTERS,  // Utilización, frecuencia y throttling por CPU
+    STAGE_POWER,     // Contadores de energía RAPL
+    STAGE_PSI,       // Pressure Stall Information
+    STAGE_PMU,       // Lectura de los grupos perf_event
+    STAGE_TOPOLOGY,  // Agregados por núcleo, CCD, paquete y nodo
+    STAGE_STRESS,    // Contadores de trabajo de cpu_stressor
+    STAGE_COUNT
+} selfstat_stage;
+
+/**
+ * @brief Histograma de latencias de una etapa
+ */
+typedef struct {
+    uint64_t count;                      // Número de mediciones
+    uint64_t total_ns;                   // Suma de latencias
+    uint64_t max_ns;                     // Latencia máxima observada
+    uint64_t buckets[SELFSTAT_BUCKETS];  // Histograma logarítmico
+} stage_hist;
+
+/**
+ * @brief Estadísticas internas del daemon
+ */
+typedef struct {
+    stage_hist stage[STAGE_COUNT];  // Un histograma por etapa
+    uint64_t cycles;                // Ciclos de muestreo ejecutados
+    uint64_t missed_deadlines;      // Expiraciones del timer perdidas (ciclos saltados)
+    uint64_t overruns;              // Ciclos que tardaron más que el intervalo
+    uint64_t started_ns;            // Instante de arranque (CLOCK_MONOTONIC)
+} self_stats;
+
+/**
+ * @brief Tiempo monótono actual en nanosegundos
+ * @description clock_gettime(CLOCK_MONOTONIC) se resuelve en el vDSO sin
+ *              entrar al kernel (~20 ns).
+ */
+static inline uint64_t selfstat_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Inicializa las estadísticas y marca el instante de arranque
+ */
+void selfstat_init(self_stats *s);
+
+/**
+ * @brief Registra la latencia de una etapa
+ *
+ * @param s     Estadísticas
+ * @param stage Etapa medida
+ * @param ns    Latencia en nanosegundos
+ */
+void selfstat_record(self_stats *s, selfstat_stage stage, uint64_t ns);
+
+/**
+ * @brief Percentil aproximado de una etapa
+ * @description Devuelve el límite superior de la cubeta que contiene el
+ *              percentil pedido (error máximo de un factor 2).
+ *
+ * @param h Histograma de la etapa
+ * @param p Percentil entre 0 y 100
+ *
+ * @return uint64_t Latencia en nanosegundos (0 si no hay mediciones)
+ */
+uint64_t selfstat_percentile(const stage_hist *h, double p);
+
+/**
+ * @brief Nombre corto de una etapa ("acquire", "flush"...)
+ */
+const char *selfstat_stage_name(selfstat_stage stage);
+
+/**
+ * @brief Escribe un informe legible de las estadísticas internas
+ * @description Incluye latencias por etapa (media, p50, p99, máx.), los
+ *              contadores de ciclos y plazos perdidos, las llamadas de la
+ *              familia read/write (read_calls/write_calls, de syscr/syscw
+ *              en /proc/self/io; no son el total de syscalls) y los bytes
+ *              del heap (mallinfo2, solo con glibc >= 2.33). Se consultan
+ *              solo aquí para no añadir coste al ciclo de muestreo.
+ */
+void selfstat_report(FILE *out, const self_stats *s);
+
+#endif // SELFSTAT_H - Fin de las guardas de inclusión
@@ -0,0 +1,424 @@
+/**
+ * @brief Microbenchmark de los backends de adquisición de sensores
+ * @description Mide latencia, rendimiento y coste de CPU de cada forma de
+ *              leer la temperatura:
+ *              - popen:  get_cpu_temp(), el comando 'sensors' por una tubería
+ *              - open:   open()/read()/close() de cada canal en cada muestra
+ *              - pread:  pread() sobre descriptores persistentes (el daemon)
+ *              - uring:  una lectura fija por canal enviada en un solo lote
+ *                        de io_uring, con descriptores y búfer registrados
+ *              Una muestra es una lectura de todos los canales (una llamada
+ *              a get_cpu_temp() en popen). Por backend se informan los
+ *              percentiles 50 y 99 y el máximo de la duración de una
+ *              muestra, las lecturas por segundo y los µs de CPU por muestra
+ *              (usuario más sistema, incluidos los procesos hijos de popen).
+ *              Los canales son los tempN_input descubiertos bajo -S; con -N
+ *              mayor que los descubiertos se repiten (cada copia con su
+ *              propio descriptor). Sin ningún canal hwmon se crean N
+ *              archivos sintéticos en /tmp: sirven para comparar el coste
+ *              de las llamadas al sistema, no el del driver.
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage cpu_sensor_bench [-S raíz_sysfs] [-N canales] [-n muestras]
+ *                         [-p muestras_popen] [-b backend,...]
+ */
+
+#define _GNU_SOURCE     // Para mkdtemp()
+
+#include <stdio.h>      // Para printf(), fprintf(), snprintf()
+#include <stdlib.h>     // Para malloc(), free(), qsort(), strtol()
+#include <string.h>     // Para strcmp(), strtok_r()
+#include <unistd.h>     // Para pread(), read(), close(), unlink(), getopt()
+#include <fcntl.h>      // Para open() y constantes O_*
+#include <limits.h>     // Para PATH_MAX
+#include <sys/uio.h>    // Para struct iovec
+#include <sys/resource.h> // Para getrusage()
+#include "temp_monitor.h" // Para get_cpu_temp() y sensors_discover()
+#include "selfstat.h"     // Para selfstat_now()
+#include "uring.h"        // Para el backend io_uring
+
+// Límites de canales y muestras
+#define BENCH_MAX_CHANNELS 4096
+#define BENCH_MAX_SAMPLES 1000000
+
+// Muestras por defecto (popen es unas mil veces más lento)
+#define BENCH_DEFAULT_SAMPLES 2000
+#define BENCH_DEFAULT_POPEN 100
+
+// Muestras de calentamiento descartadas por backend
+#define BENCH_WARMUP 10
+
+// Canales sintéticos por defecto sin hwmon
+#define BENCH_DEFAULT_SYNTHETIC 16
+
+// Bytes leídos por canal (como sensors_read())
+#define BENCH_READ_LEN 24
+
+/**
+ * @brief Canales abiertos y estado del backend io_uring
+ */
+typedef struct {
+    int count;                              // Canales
+    char (*path)[SENSOR_PATH_LEN];          // Ruta de cada canal
+    int *fd;                                // Descriptor persistente de cada canal
+    char (*buf)[BENCH_READ_LEN];            // Búfer de lectura de cada canal
+    uring ring;                             // Anillo (fd = -1 si no disponible)
+    uring_completion *done;                 // Resultados recogidos
+    long errors;                            // Lecturas fallidas de la pasada actual
+    char synthetic[PATH_MAX];               // Directorio de los canales sintéticos ("" = hwmon)
+} bench_channels;
+
+/**
+ * @brief Convierte un valor de hwmon en miligrados (igual que sensors_read())
+ */
+static long parse_milli(const char *buf, ssize_t n) {
+    long milli = 0;
+    ssize_t i = 0;
+    int neg = n > 0 && buf[0] == '-';
+    for (i = neg; i < n && buf[i] >= '0' && buf[i] <= '9'; i++) {
+        milli = milli * 10 + (buf[i] - '0');
+    }
+    return neg ? -milli : milli;
+}
+
+/**
+ * @brief Una muestra con get_cpu_temp()
+ */
+static long sample_popen(bench_channels *c) {
+    float temp = get_cpu_temp();
+    if (temp <= 0.0f) {
+        c->errors++;
+    }
+    return (long)(temp * 1000.0f);
+}
+
+/**
+ * @brief Una muestra abriendo, leyendo y cerrando cada canal
+ */
+static long sample_open(bench_channels *c) {
+    long sum = 0;
+    for (int i = 0; i < c->count; i++) {
+        int fd = open(c->path[i], O_RDONLY | O_CLOEXEC);
+        ssize_t n = fd >= 0 ? read(fd, c->buf[i], BENCH_READ_LEN) : -1;
+        if (fd >= 0) {
+            close(fd);
+        }
+        if (n <= 0) {
+            c->errors++;
+            continue;
+        }
+        sum += parse_milli(c->buf[i], n);
+    }
+    return sum;
+}
+
+/**
+ * @brief Una muestra con pread() sobre descriptores persistentes
+ */
+static long sample_pread(bench_channels *c) {
+    long sum = 0;
+    for (int i = 0; i < c->count; i++) {
+        ssize_t n = pread(c->fd[i], c->buf[i], BENCH_READ_LEN, 0);
+        if (n <= 0) {
+            c->errors++;
+            continue;
+        }
+        sum += parse_milli(c->buf[i], n);
+    }
+    return sum;
+}
+
+/**
+ * @brief Una muestra con un lote de io_uring: una llamada al sistema
+ */
+static long sample_uring(bench_channels *c) {
+    long sum = 0;
+    for (int i = 0; i < c->count; i++) {
+        uring_queue_read(&c->ring, (unsigned)i, c->buf[i], BENCH_READ_LEN, 0, (uint64_t)i);
+    }
+    if (uring_submit(&c->ring, (unsigned)c->count) < 0) {
+        c->errors += c->count;
+        return 0;
+    }
+
+    unsigned got = 0;
+    while (got < (unsigned)c->count) {
+        unsigned n = uring_reap(&c->ring, c->done, (unsigned)c->count);
+        for (unsigned k = 0; k < n; k++) {
+            if (c->done[k].res <= 0) {
+                c->errors++;
+                continue;
+            }
+            sum += parse_milli(c->buf[c->done[k].user_data], c->done[k].res);
+        }
+        got += n;
+        if (got < (unsigned)c->count && uring_submit(&c->ring, (unsigned)c->count - got) < 0) {
+            c->errors += c->count - (long)got;
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Backend: nombre y función de muestra
+ */
+typedef struct {
+    const char *name;
+    long (*sample)(bench_channels *c);
+} bench_backend;
+
+static const bench_backend backends[] = {
+    {"popen", sample_popen},
+    {"open", sample_open},
+    {"pread", sample_pread},
+    {"uring", sample_uring},
+};
+
+/**
+ * @brief Tiempo de CPU consumido (propio y de los hijos), en ns
+ */
+static uint64_t cpu_ns(void) {
+    struct rusage self, children;
+    getrusage(RUSAGE_SELF, &self);
+    getrusage(RUSAGE_CHILDREN, &children);
+    uint64_t us = (uint64_t)(self.ru_utime.tv_sec + self.ru_stime.tv_sec
+                             + children.ru_utime.tv_sec + children.ru_stime.tv_sec) * 1000000ull
+                  + (uint64_t)(self.ru_utime.tv_usec + self.ru_stime.tv_usec
+                               + children.ru_utime.tv_usec + children.ru_stime.tv_usec);
+    return us * 1000ull;
+}
+
+/**
+ * @brief Comparador de duraciones para qsort()
+ */
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * @brief Mide un backend y escribe su fila
+ *
+ * @param reads   Lecturas por muestra (1 en popen, count en los demás)
+ * @param samples Muestras medidas
+ * @param dur     Arreglo de trabajo con capacidad para samples
+ */
+static void run_backend(const bench_backend *b, bench_channels *c, int reads, int samples,
+                        uint64_t *dur) {
+    volatile long sink = 0;
+
+    for (int i = 0; i < BENCH_WARMUP; i++) {
+        sink += b->sample(c);
+    }
+    c->errors = 0;
+
+    uint64_t cpu0 = cpu_ns(), wall0 = selfstat_now();
+    for (int i = 0; i < samples; i++) {
+        uint64_t t0 = selfstat_now();
+        sink += b->sample(c);
+        dur[i] = selfstat_now() - t0;
+    }
+    uint64_t wall = selfstat_now() - wall0, cpu = cpu_ns() - cpu0;
+    (void)sink;
+
+    qsort(dur, (size_t)samples, sizeof(dur[0]), cmp_u64);
+    double p50 = dur[(samples - 1) / 2] / 1e3;
+    double p99 = dur[(int)((samples - 1) * 0.99 + 0.5)] / 1e3;
+    printf("%-6s %8d %8d %10.2f %10.2f %10.2f %10.3f %12.0f %10.2f %8ld\n",
+           b->name, reads, samples, p50, p99, dur[samples - 1] / 1e3, p50 / reads,
+           (double)samples * reads / (wall / 1e9), cpu / 1e3 / samples, c->errors);
+    fflush(stdout);
+}
+
+/**
+ * @brief Crea N canales sintéticos en un directorio temporal
+ * @return int 0 si éxito, -1 si error
+ */
+static int synthetic_channels(bench_channels *c, int n) {
+    char *dir = c->synthetic;
+    snprintf(dir, sizeof(c->synthetic), "%s", "/tmp/cpu_sensor_bench.XXXXXX");
+    if (mkdtemp(dir) == NULL) {
+        perror("mkdtemp");
+        dir[0] = '\0';
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        if (snprintf(c->path[i], SENSOR_PATH_LEN, "%s/temp%d_input", dir, i + 1) >= SENSOR_PATH_LEN) {
+            fprintf(stderr, "cpu_sensor_bench: path too long in %s\n", dir);
+            return -1;
+        }
+        FILE *f = fopen(c->path[i], "w");
+        if (!f) {
+            perror(c->path[i]);
+            return -1;
+        }
+        fprintf(f, "%d\n", 40000 + i * 100);
+        fclose(f);
+    }
+    c->count = n;
+    fprintf(stderr, "cpu_sensor_bench: no hwmon channels, using %d synthetic files in %s\n", n, dir);
+    return 0;
+}
+
+/**
+ * @brief Reserva, descubre y abre los canales, y prepara el anillo
+ * @return int 0 si éxito, -1 si error
+ */
+static int open_channels(bench_channels *c, const char *root, int want) {
+    static sensor_table t;
+    int found = sensors_discover(&t, root);
+    int n = want > 0 ? want : (found > 0 ? found : BENCH_DEFAULT_SYNTHETIC);
+
+    c->path = calloc((size_t)n, sizeof(*c->path));
+    c->fd = calloc((size_t)n, sizeof(*c->fd));
+    c->buf = calloc((size_t)n, sizeof(*c->buf));
+    c->done = calloc((size_t)n, sizeof(*c->done));
+    if (!c->path || !c->fd || !c->buf || !c->done) {
+        return -1;
+    }
+
+    if (found > 0) {
+        // Los canales descubiertos, repetidos hasta completar n
+        for (int i = 0; i < n; i++) {
+            snprintf(c->path[i], SENSOR_PATH_LEN, "%s", t.ch[i % found].path);
+        }
+        c->count = n;
+        fprintf(stderr, "cpu_sensor_bench: %d hwmon channels under %s, reading %d\n", found, root, n);
+    } else if (synthetic_channels(c, n) < 0) {
+        return -1;
+    }
+
+    for (int i = 0; i < c->count; i++) {
+        c->fd[i] = open(c->path[i], O_RDONLY | O_CLOEXEC);
+        if (c->fd[i] < 0) {
+            perror(c->path[i]);
+            return -1;
+        }
+    }
+
+    // Anillo con una entrada por canal, descriptores y búfer registrados
+    unsigned entries = 1;
+    while (entries < (unsigned)c->count) {
+        entries <<= 1;
+    }
+    struct iovec iov = {.iov_base = c->buf, .iov_len = (size_t)c->count * BENCH_READ_LEN};
+    if (uring_init(&c->ring, entries) < 0) {
+        perror("cpu_sensor_bench: io_uring");
+    } else if (uring_register_files(&c->ring, c->fd, (unsigned)c->count) < 0
+               || uring_register_buffers(&c->ring, &iov, 1) < 0) {
+        perror("cpu_sensor_bench: io_uring register");
+        uring_free(&c->ring);
+    }
+    return 0;
+}
+
+/**
+ * @brief Muestra la ayuda de línea de comandos
+ */
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [-S raíz_sysfs] [-N canales] [-n muestras] [-p muestras_popen]\n"
+            "       [-b backend,...]\n"
+            "  -S raíz_sysfs    Raíz de sysfs de los canales (por defecto, /sys)\n"
+            "  -N canales       Canales por muestra (por defecto, los descubiertos)\n"
+            "  -n muestras      Muestras por backend (por defecto, %d)\n"
+            "  -p muestras      Muestras de popen (por defecto, %d)\n"
+            "  -b backend,...   popen, open, pread y/o uring (por defecto, todos)\n",
+            prog, BENCH_DEFAULT_SAMPLES, BENCH_DEFAULT_POPEN);
+}
+
+/**
+ * @brief Función principal del microbenchmark
+ * @return int 0 si éxito, 1 si los argumentos no son válidos o no hay canales
+ */
+int main(int argc, char *argv[]) {
+    const char *root = "/sys";
+    char list[64] = "popen,open,pread,uring";
+    int want = 0, samples = BENCH_DEFAULT_SAMPLES, popen_samples = BENCH_DEFAULT_POPEN;
+    bench_channels c = {0};
+    char *end;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "S:N:n:p:b:h")) != -1) {
+        switch (opt) {
+            case 'S':
+                root = optarg;
+                break;
+            case 'N':
+                want = (int)strtol(optarg, &end, 10);
+                if (*end != '\0' || want <= 0 || want > BENCH_MAX_CHANNELS) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'n':
+            case 'p': {
+                int v = (int)strtol(optarg, &end, 10);
+                if (*end != '\0' || v <= 0 || v > BENCH_MAX_SAMPLES) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                *(opt == 'n' ? &samples : &popen_samples) = v;
+                break;
+            }
+            case 'b':
+                snprintf(list, sizeof(list), "%s", optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    c.ring.fd = -1;
+    if (open_channels(&c, root, want) < 0) {
+        return 1;
+    }
+    uint64_t *dur = malloc(sizeof(*dur) * (size_t)(samples > popen_samples ? samples : popen_samples));
+    if (!dur) {
+        return 1;
+    }
+
+    printf("# backend reads samples p50_us p99_us max_us read_p50_us reads_per_s cpu_us_per_sample errors\n");
+    char *save;
+    for (char *name = strtok_r(list, ",", &save); name; name = strtok_r(NULL, ",", &save)) {
+        const bench_backend *b = NULL;
+        for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+            if (strcmp(name, backends[i].name) == 0) {
+                b = &backends[i];
+            }
+        }
+        if (b == NULL) {
+            fprintf(stderr, "cpu_sensor_bench: unknown backend %s\n", name);
+            continue;
+        }
+        if (b->sample == sample_popen && get_cpu_temp() <= 0.0f) {
+            fprintf(stderr, "cpu_sensor_bench: popen: 'sensors' gives no temperature, skipped\n");
+            continue;
+        }
+        if (b->sample == sample_uring && c.ring.fd < 0) {
+            fprintf(stderr, "cpu_sensor_bench: uring: io_uring unavailable, skipped\n");
+            continue;
+        }
+        int popen_backend = b->sample == sample_popen;
+        run_backend(b, &c, popen_backend ? 1 : c.count, popen_backend ? popen_samples : samples, dur);
+    }
+
+    uring_free(&c.ring);
+    for (int i = 0; i < c.count; i++) {
+        close(c.fd[i]);
+        if (c.synthetic[0] != '\0') {
+            unlink(c.path[i]);
+        }
+    }
+    if (c.synthetic[0] != '\0') {
+        rmdir(c.synthetic);
+    }
+    free(dur);
+    free(c.done);
+    free(c.buf);
+    free(c.fd);
+    free(c.path);
+    return 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * @brief Módulo de serie de muestras correlacionadas
+ * @description Implementa el anillo columnar de registros de muestra y las
+ *              consultas que recorren sus columnas.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdlib.h>   // Para calloc(), free()
+#include <string.h>   // Para memset()
+#include "series.h"   // Header con declaraciones del módulo
+
+/**
+ * @brief Reserva las columnas para @p ncpu CPUs
+ */
+int series_init(sample_series *s, int ncpu) {
+    size_t per_cpu = (size_t)(ncpu > 0 ? ncpu : 0) * SERIES_CAPACITY;
+
+    memset(s, 0, sizeof(*s));
+    s->ncpu = ncpu > 0 ? ncpu : 0;
+    s->ts_ns = calloc(SERIES_CAPACITY, sizeof(uint64_t));
+    s->milli = calloc(SERIES_CAPACITY, sizeof(int32_t));
+    s->package_w = calloc(SERIES_CAPACITY, sizeof(float));
+    s->core_w = calloc(SERIES_CAPACITY, sizeof(float));
+    s->psi_avg10 = calloc(PSI_RESOURCES * SERIES_CAPACITY, sizeof(uint16_t));
+    s->psi_some_us = calloc(PSI_RESOURCES * SERIES_CAPACITY, sizeof(uint32_t));
+    s->psi_full_us = calloc(PSI_RESOURCES * SERIES_CAPACITY, sizeof(uint32_t));
+    s->util_pm = calloc(per_cpu + 1, sizeof(uint16_t));
+    s->freq_mhz = calloc(per_cpu + 1, sizeof(uint16_t));
+    s->core_thr = calloc(per_cpu + 1, sizeof(uint32_t));
+    s->pkg_thr = calloc(per_cpu + 1, sizeof(uint32_t));
+    s->ipc_milli = calloc(per_cpu + 1, sizeof(uint16_t));
+    s->eff_mhz = calloc(per_cpu + 1, sizeof(uint16_t));
+
+    if (!s->ts_ns || !s->milli || !s->package_w || !s->core_w ||
+        !s->psi_avg10 || !s->psi_some_us || !s->psi_full_us ||
+        !s->util_pm || !s->freq_mhz || !s->core_thr || !s->pkg_thr ||
+        !s->ipc_milli || !s->eff_mhz) {
+        series_free(s);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Añade un registro con la temperatura y los contadores del ciclo
+ */
+unsigned series_append(sample_series *s, uint64_t ts_ns, float temp, const cpu_counters *c) {
+    unsigned rec = s->head;
+
+    if (!s->ts_ns) {
+        return 0;
+    }
+    s->ts_ns[rec] = ts_ns;
+    s->milli[rec] = (int32_t)(temp * 1000.0f);
+    s->package_w[rec] = 0.0f;
+    s->core_w[rec] = 0.0f;
+    for (int r = 0; r < PSI_RESOURCES; r++) {
+        s->psi_avg10[series_at(r, rec)] = 0;
+        s->psi_some_us[series_at(r, rec)] = 0;
+        s->psi_full_us[series_at(r, rec)] = 0;
+    }
+
+    for (int cpu = 0; cpu < s->ncpu; cpu++) {
+        unsigned at = series_at(cpu, rec);
+        int have = cpu < c->ncpu;
+        s->util_pm[at] = have ? c->util_pm[cpu] : 0;
+        s->freq_mhz[at] = have ? c->freq_mhz[cpu] : 0;
+        s->core_thr[at] = have ? c->d_core_thr[cpu] : 0;
+        s->pkg_thr[at] = have ? c->d_pkg_thr[cpu] : 0;
+        s->ipc_milli[at] = 0;
+        s->eff_mhz[at] = 0;
+    }
+
+    s->head = (rec + 1) % SERIES_CAPACITY;
+    if (s->count < SERIES_CAPACITY) {
+        s->count++;
+    }
+    return rec;
+}
+
+/**
+ * @brief Completa la potencia del registro @p rec
+ */
+void series_set_power(sample_series *s, unsigned rec, double package_w, double core_w) {
+    if (!s->package_w || rec >= SERIES_CAPACITY) {
+        return;
+    }
+    s->package_w[rec] = (float)package_w;
+    s->core_w[rec] = (float)core_w;
+}
+
+/**
+ * @brief Completa la presión (PSI) del registro @p rec
+ */
+void series_set_psi(sample_series *s, unsigned rec, const psi_set *p) {
+    if (!s->psi_avg10 || rec >= SERIES_CAPACITY) {
+        return;
+    }
+    for (int r = 0; r < PSI_RESOURCES; r++) {
+        s->psi_avg10[series_at(r, rec)] = (uint16_t)p->r[r].some_avg10;
+        s->psi_some_us[series_at(r, rec)] = (uint32_t)p->r[r].d_some_us;
+        s->psi_full_us[series_at(r, rec)] = (uint32_t)p->r[r].d_full_us;
+    }
+}
+
+/**
+ * @brief Completa el IPC y la frecuencia efectiva por CPU del registro @p rec
+ */
+void series_set_pmu(sample_series *s, unsigned rec, const pmu_set *p) {
+    if (!s->ipc_milli || rec >= SERIES_CAPACITY) {
+        return;
+    }
+    for (int cpu = 0; cpu < s->ncpu && cpu < p->ncpu; cpu++) {
+        s->ipc_milli[series_at(cpu, rec)] = p->cpu[cpu].ipc_milli;
+        s->eff_mhz[series_at(cpu, rec)] = p->cpu[cpu].eff_mhz;
+    }
+}
+
+/**
+ * @brief Calcula el coste del throttling sobre todo el anillo
+ * @description Dos pasadas por CPU sobre columnas contiguas: la primera
+ *              obtiene las frecuencias medias de cada grupo y la segunda
+ *              pondera la pérdida por la utilización.
+ */
+void series_throttle_cost(const sample_series *s, series_cost *out) {
+    double thr_sum = 0.0, free_sum = 0.0;
+
+    memset(out, 0, sizeof(*out));
+    for (int cpu = 0; cpu < s->ncpu; cpu++) {
+        const uint16_t *util = &s->util_pm[series_at(cpu, 0)];
+        const uint16_t *freq = &s->freq_mhz[series_at(cpu, 0)];
+        const uint32_t *core = &s->core_thr[series_at(cpu, 0)];
+        const uint32_t *pkg = &s->pkg_thr[series_at(cpu, 0)];
+
+        for (unsigned i = 0; i < s->count; i++) {
+            if (util[i] < SERIES_BUSY_PM || freq[i] == 0) {
+                continue;
+            }
+            out->busy++;
+            if (core[i] || pkg[i]) {
+                out->throttled++;
+                thr_sum += freq[i];
+            } else {
+                free_sum += freq[i];
+            }
+        }
+    }
+
+    if (out->throttled > 0) {
+        out->throttled_mhz = thr_sum / out->throttled;
+    }
+    if (out->busy > out->throttled) {
+        out->free_mhz = free_sum / (out->busy - out->throttled);
+    }
+    if (out->throttled == 0 || out->free_mhz <= 0.0) {
+        return;
+    }
+
+    double lost = 0.0, total = 0.0;
+    for (int cpu = 0; cpu < s->ncpu; cpu++) {
+        const uint16_t *util = &s->util_pm[series_at(cpu, 0)];
+        const uint16_t *freq = &s->freq_mhz[series_at(cpu, 0)];
+        const uint32_t *core = &s->core_thr[series_at(cpu, 0)];
+        const uint32_t *pkg = &s->pkg_thr[series_at(cpu, 0)];
+
+        for (unsigned i = 0; i < s->count; i++) {
+            if (util[i] < SERIES_BUSY_PM || freq[i] == 0) {
+                continue;
+            }
+            total += out->free_mhz * util[i];
+            if ((core[i] || pkg[i]) && freq[i] < out->free_mhz) {
+                lost += (out->free_mhz - freq[i]) * util[i];
+            }
+        }
+    }
+    out->cost_pct = total > 0.0 ? lost * 100.0 / total : 0.0;
+}
+
+/**
+ * @brief Libera las columnas de la serie
+ */
+void series_free(sample_series *s) {
+    free(s->ts_ns);
+    free(s->milli);
+    free(s->package_w);
+    free(s->core_w);
+    free(s->psi_avg10);
+    free(s->psi_some_us);
+    free(s->psi_full_us);
+    free(s->util_pm);
+    free(s->freq_mhz);
+    free(s->core_thr);
+    free(s->pkg_thr);
+    free(s->ipc_milli);
+    free(s->eff_mhz);
+    memset(s, 0, sizeof(*s));
+}
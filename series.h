@@ -0,0 +1,122 @@
+/**
+ * @brief Header del módulo de serie de muestras correlacionadas
+ * @description Define un anillo de registros de muestra en el que cada ciclo
+ *              del daemon guarda, con la misma marca de tiempo, la
+ *              temperatura y los contadores de todas las CPUs (utilización,
+ *              frecuencia y eventos de throttling). El almacenamiento es
+ *              columnar (estructura de arreglos): cada magnitud de cada CPU
+ *              es un arreglo contiguo en el tiempo, así las consultas que
+ *              recorren una columna leen memoria secuencial y el registro i
+ *              es simplemente la posición i de todas las columnas.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef SERIES_H  // Si SERIES_H no está definido
+#define SERIES_H  // Definir SERIES_H como macro de protección
+
+#include <stdint.h>        // Para tipos de ancho fijo
+#include "cpu_counters.h"  // Para cpu_counters
+#include "psi.h"           // Para psi_set, PSI_RESOURCES
+#include "pmu.h"           // Para pmu_set
+
+// Registros del anillo (algo más de 1 hora con el intervalo por defecto)
+#define SERIES_CAPACITY 1024
+
+// Utilización mínima (por mil) para que una CPU cuente en el coste de throttling
+#define SERIES_BUSY_PM 500
+
+/**
+ * @brief Anillo columnar de registros de muestra
+ * @description Las columnas por CPU tienen ncpu * SERIES_CAPACITY elementos;
+ *              el valor de la CPU c en el registro i está en
+ *              [c * SERIES_CAPACITY + i] (ver series_at()). Las columnas de
+ *              presión siguen el mismo esquema con el recurso en lugar de la
+ *              CPU.
+ */
+typedef struct {
+    int ncpu;              // CPUs por registro
+    unsigned head;         // Próximo registro a escribir
+    unsigned count;        // Registros válidos (<= SERIES_CAPACITY)
+    uint64_t *ts_ns;       // Marca de tiempo CLOCK_MONOTONIC de cada registro
+    int32_t *milli;        // Temperatura en miligrados
+    float *package_w;      // Potencia de los paquetes en vatios
+    float *core_w;         // Potencia de los núcleos en vatios
+    uint16_t *psi_avg10;   // avg10 "some" por recurso (x100)
+    uint32_t *psi_some_us; // Espera "some" por recurso en el intervalo
+    uint32_t *psi_full_us; // Espera "full" por recurso en el intervalo
+    uint16_t *util_pm;     // Utilización por CPU (por mil)
+    uint16_t *freq_mhz;    // Frecuencia por CPU en MHz
+    uint32_t *core_thr;    // Eventos de throttling del núcleo en el intervalo
+    uint32_t *pkg_thr;     // Eventos de throttling del paquete en el intervalo
+    uint16_t *ipc_milli;   // Instrucciones por ciclo por CPU (x1000, perf_event)
+    uint16_t *eff_mhz;     // Frecuencia efectiva por CPU (ciclos / tiempo ocupado)
+} sample_series;
+
+/**
+ * @brief Coste estimado del throttling sobre los registros del anillo
+ * @description Solo cuentan las muestras (CPU, registro) con utilización
+ *              de al menos SERIES_BUSY_PM: una CPU ociosa baja la
+ *              frecuencia sin que eso cueste rendimiento.
+ */
+typedef struct {
+    unsigned busy;          // Muestras ocupadas
+    unsigned throttled;     // Muestras ocupadas con eventos de throttling
+    double throttled_mhz;   // Frecuencia media de las muestras limitadas
+    double free_mhz;        // Frecuencia media de las muestras no limitadas
+    double cost_pct;        // Porcentaje de ciclos perdidos sobre el total ocupado
+} series_cost;
+
+/**
+ * @brief Posición de la CPU @p cpu del registro @p rec en una columna por CPU
+ */
+static inline unsigned series_at(int cpu, unsigned rec) {
+    return (unsigned)cpu * SERIES_CAPACITY + rec;
+}
+
+/**
+ * @brief Reserva las columnas para @p ncpu CPUs
+ * @return int 0 si éxito, -1 si no hay memoria
+ */
+int series_init(sample_series *s, int ncpu);
+
+/**
+ * @brief Añade un registro con la temperatura y los contadores del ciclo
+ * @description Si los contadores tienen otro número de CPUs que la serie,
+ *              las columnas por CPU sobrantes quedan a cero.
+ *
+ * @return unsigned Índice del registro escrito
+ */
+unsigned series_append(sample_series *s, uint64_t ts_ns, float temp, const cpu_counters *c);
+
+/**
+ * @brief Completa la potencia del registro @p rec
+ */
+void series_set_power(sample_series *s, unsigned rec, double package_w, double core_w);
+
+/**
+ * @brief Completa la presión (PSI) del registro @p rec
+ */
+void series_set_psi(sample_series *s, unsigned rec, const psi_set *p);
+
+/**
+ * @brief Completa el IPC y la frecuencia efectiva por CPU del registro @p rec
+ */
+void series_set_pmu(sample_series *s, unsigned rec, const pmu_set *p);
+
+/**
+ * @brief Calcula el coste del throttling sobre todo el anillo
+ * @description Las muestras limitadas son las que tienen eventos de
+ *              throttling de núcleo o de paquete. Los ciclos perdidos se
+ *              estiman como (free_mhz - freq) * utilización de cada muestra
+ *              limitada, relativo a free_mhz * utilización de todas las
+ *              muestras ocupadas.
+ */
+void series_throttle_cost(const sample_series *s, series_cost *out);
+
+/**
+ * @brief Libera las columnas de la serie
+ */
+void series_free(sample_series *s);
+
+#endif // SERIES_H - Fin de las guardas de inclusión
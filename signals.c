@@ -0,0 +1,124 @@
+/**
+ * @brief Módulo de manejo de señales basado en signalfd
+ * @description Convierte las señales de control del daemon en eventos que se
+ *              leen desde un descriptor de archivo. Evita manejadores
+ *              asíncronos y las restricciones de funciones async-signal-safe:
+ *              toda la lógica de apagado y recarga se ejecuta en el bucle
+ *              principal, fuera de contexto de señal.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <signal.h>       // Para sigset_t, sigprocmask(), SIG_IGN
+#include <unistd.h>       // Para read(), close()
+#include <errno.h>        // Para errno, EAGAIN
+#include <time.h>         // Para clock_gettime()
+#include <sys/wait.h>     // Para waitpid(), WNOHANG
+#include <sys/signalfd.h> // Para signalfd(), struct signalfd_siginfo
+#include "signals.h"      // Header con declaraciones del módulo de señales
+
+/**
+ * @brief Conjunto de las señales de control del daemon
+ */
+static void control_signals(sigset_t *mask) {
+    sigemptyset(mask);
+    sigaddset(mask, SIGTERM);  // Apagado ordenado (stop.sh, systemd)
+    sigaddset(mask, SIGINT);   // Apagado ordenado (Ctrl+C en primer plano)
+    sigaddset(mask, SIGHUP);   // Recarga de configuración y reapertura de logs
+    sigaddset(mask, SIGUSR1);  // Volcado del informe de estado
+}
+
+/**
+ * @brief Bloquea las señales de control y crea el descriptor signalfd
+ */
+int signals_open(void) {
+    sigset_t mask;
+    control_signals(&mask);
+
+    // Bloquear las señales: a partir de aquí solo se entregan por signalfd
+    if (sigprocmask(SIG_BLOCK, &mask, NULL) < 0) {
+        return -1;
+    }
+
+    // Un pipe o socket cerrado no debe terminar el daemon
+    signal(SIGPIPE, SIG_IGN);
+
+    return signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+}
+
+/**
+ * @brief Lee la siguiente señal pendiente del descriptor signalfd
+ */
+int signals_next(int fd) {
+    struct signalfd_siginfo info;
+    ssize_t n;
+
+    do {
+        n = read(fd, &info, sizeof(info));
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        // Sin señales pendientes (descriptor no bloqueante)
+        return errno == EAGAIN ? 0 : -1;
+    }
+    if (n != (ssize_t)sizeof(info)) {
+        return -1;
+    }
+    return (int)info.ssi_signo;
+}
+
+/**
+ * @brief Inicializa atributos de posix_spawn() con las señales por defecto
+ */
+int signals_spawnattr(posix_spawnattr_t *attr, short flags) {
+    sigset_t empty, defaults;
+    int rc = posix_spawnattr_init(attr);
+    if (rc != 0) {
+        return rc;
+    }
+
+    sigemptyset(&empty);
+    control_signals(&defaults);
+    sigaddset(&defaults, SIGPIPE);
+    rc = posix_spawnattr_setsigmask(attr, &empty);
+    if (rc == 0) {
+        rc = posix_spawnattr_setsigdefault(attr, &defaults);
+    }
+    if (rc == 0) {
+        rc = posix_spawnattr_setflags(attr, (short)(flags | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF));
+    }
+    if (rc == 0 && (flags & POSIX_SPAWN_SETPGROUP)) {
+        rc = posix_spawnattr_setpgroup(attr, 0);
+    }
+    if (rc != 0) {
+        posix_spawnattr_destroy(attr);
+    }
+    return rc;
+}
+
+/**
+ * @brief Milisegundos de CLOCK_MONOTONIC
+ */
+long signals_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+/**
+ * @brief Recoge un proceso hijo esperando como mucho hasta un plazo
+ * @description Sondea con WNOHANG cada milisegundo: el hijo suele estar
+ *              terminando y la espera real es corta.
+ */
+int signals_reap_child(pid_t pid, long start_ms, unsigned timeout_ms, int group) {
+    if (timeout_ms == 0) {
+        return waitpid(pid, NULL, 0) == pid ? 0 : -1;
+    }
+    while (waitpid(pid, NULL, WNOHANG) == 0) {
+        if (signals_now_ms() - start_ms >= (long)timeout_ms) {
+            kill(group ? -pid : pid, SIGKILL);
+            return waitpid(pid, NULL, WNOHANG) == 0 ? -1 : 0;
+        }
+        usleep(1000);
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * @brief Header del módulo de manejo de señales del daemon
+ * @description Define la interfaz para recibir las señales de control del
+ *              daemon (SIGTERM, SIGINT, SIGHUP, SIGUSR1) como eventos a
+ *              través de un descriptor signalfd, en lugar de manejadores
+ *              asíncronos. Así el bucle principal puede atender señales y
+ *              muestreo desde un único poll().
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef SIGNALS_H  // Si SIGNALS_H no está definido
+#define SIGNALS_H  // Definir SIGNALS_H como macro de protección
+
+#include <spawn.h>      // Para posix_spawnattr_t
+#include <sys/types.h>  // Para pid_t
+
+/**
+ * @brief Bloquea las señales de control y crea el descriptor signalfd
+ * @description Bloquea SIGTERM, SIGINT, SIGHUP y SIGUSR1 en la máscara del proceso
+ *              (para que no ejecuten su acción por defecto) y crea un
+ *              signalfd no bloqueante que las entrega como lecturas.
+ *              SIGPIPE se ignora para que un lector cerrado no mate al daemon.
+ *
+ * @return int Descriptor signalfd (>= 0) o -1 si hubo un error
+ *
+ * @note Debe llamarse después de create_daemon(): la máscara se hereda en
+ *       fork(), pero el descriptor debe pertenecer al proceso final.
+ * @note La máscara y SIG_IGN también se heredan en posix_spawn() y exec():
+ *       todo proceso hijo debe lanzarse con signals_spawnattr().
+ */
+int signals_open(void);
+
+/**
+ * @brief Inicializa atributos de posix_spawn() con las señales por defecto
+ * @description El hijo arranca con la máscara vacía y con SIGPIPE y las
+ *              señales de control en su acción por defecto: sin esto
+ *              heredaría las señales bloqueadas por signals_open() (no se
+ *              podría terminar con SIGTERM) y SIGPIPE ignorada (terminaría
+ *              por EPIPE en lugar de por la señal).
+ *
+ * @param attr  Atributos a inicializar (posix_spawnattr_destroy() al acabar)
+ * @param flags Flags adicionales de posix_spawnattr_setflags() (0 o
+ *              POSIX_SPAWN_SETPGROUP, con el grupo puesto a 0)
+ *
+ * @return int 0 si éxito, un código de error si falla
+ */
+int signals_spawnattr(posix_spawnattr_t *attr, short flags);
+
+/**
+ * @brief Recoge un proceso hijo esperando como mucho hasta un plazo
+ * @description Si el hijo no termina a tiempo se mata con SIGKILL (a su
+ *              grupo si se lanzó con POSIX_SPAWN_SETPGROUP).
+ *
+ * @param pid        Proceso hijo
+ * @param start_ms   Instante de referencia del plazo (signals_now_ms())
+ * @param timeout_ms Plazo desde start_ms (0 = esperar sin límite)
+ * @param group      1 si el hijo es líder de su propio grupo de procesos
+ *
+ * @return int 0 si se recogió, -1 si se mató pero aún no se pudo recoger
+ *             (el llamante debe volver a intentarlo con WNOHANG)
+ */
+int signals_reap_child(pid_t pid, long start_ms, unsigned timeout_ms, int group);
+
+/**
+ * @brief Milisegundos de CLOCK_MONOTONIC (referencia de signals_reap_child())
+ */
+long signals_now_ms(void);
+
+/**
+ * @brief Lee la siguiente señal pendiente del descriptor signalfd
+ *
+ * @param fd Descriptor devuelto por signals_open()
+ *
+ * @return int Número de señal, 0 si no hay señales pendientes, -1 si error
+ */
+int signals_next(int fd);
+
+#endif // SIGNALS_H - Fin de las guardas de inclusión
@@ -0,0 +1,154 @@
+/**
+ * @brief Módulo de instantáneas para reinicio en caliente
+ * @description Serializa las estructuras planas del daemon (temp_history y
+ *              sensor_table) detrás de una cabecera con firma, versión y
+ *              suma FNV-1a. La lectura usa mmap() para evitar copias
+ *              intermedias: restaurar ~30 KB lleva microsegundos.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdio.h>      // Para snprintf(), rename()
+#include <string.h>     // Para memcpy(), memcmp()
+#include <unistd.h>     // Para write(), fsync(), close(), sysconf()
+#include <fcntl.h>      // Para open() y constantes O_*
+#include <limits.h>     // Para PATH_MAX
+#include <sys/mman.h>   // Para mmap(), munmap()
+#include <sys/stat.h>   // Para fstat()
+#include "snapshot.h"   // Header con declaraciones del módulo de instantáneas
+
+// Firma al inicio del archivo
+static const char snapshot_magic[8] = {'C', 'P', 'U', 'D', 'S', 'N', 'A', 'P'};
+
+/**
+ * @brief Cabecera de la instantánea (seguida de temp_history y sensor_table)
+ */
+typedef struct {
+    char magic[8];           // "CPUDSNAP"
+    uint32_t version;        // SNAPSHOT_VERSION
+    uint32_t ncpus;          // CPUs en línea al guardar (huella del hardware)
+    uint32_t history_size;   // sizeof(temp_history) al guardar
+    uint32_t sensors_size;   // sizeof(sensor_table) al guardar
+    uint32_t checksum;       // FNV-1a de la carga útil
+    uint32_t reserved;
+    int64_t saved_at;        // Tiempo Unix del guardado
+} snapshot_header;
+
+/**
+ * @brief Suma FNV-1a de 32 bits sobre un bloque de memoria
+ */
+static uint32_t fnv1a(uint32_t h, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Escribe un bloque completo reintentando escrituras parciales
+ */
+static int write_all(int fd, const void *data, size_t len) {
+    const char *p = data;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n <= 0) {
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Guarda el estado del daemon en una instantánea
+ */
+int snapshot_save(const char *path, const temp_history *h, const sensor_table *s) {
+    char tmp[PATH_MAX];
+    snapshot_header hdr;
+
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) {
+        return -1;
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, snapshot_magic, sizeof(hdr.magic));
+    hdr.version = SNAPSHOT_VERSION;
+    hdr.ncpus = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    hdr.history_size = sizeof(*h);
+    hdr.sensors_size = sizeof(*s);
+    hdr.checksum = fnv1a(fnv1a(2166136261u, h, sizeof(*h)), s, sizeof(*s));
+    hdr.saved_at = time(NULL);
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int rc = write_all(fd, &hdr, sizeof(hdr));
+    if (rc == 0) {
+        rc = write_all(fd, h, sizeof(*h));
+    }
+    if (rc == 0) {
+        rc = write_all(fd, s, sizeof(*s));
+    }
+    if (rc == 0) {
+        rc = fsync(fd);
+    }
+    close(fd);
+
+    if (rc == 0) {
+        rc = rename(tmp, path);
+    }
+    if (rc < 0) {
+        unlink(tmp);
+    }
+    return rc;
+}
+
+/**
+ * @brief Restaura el estado del daemon desde una instantánea
+ */
+int snapshot_load(const char *path, temp_history *h, sensor_table *s) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat st;
+    size_t expected = sizeof(snapshot_header) + sizeof(*h) + sizeof(*s);
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size != expected) {
+        close(fd);
+        return -1;
+    }
+
+    const unsigned char *map = mmap(NULL, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    const snapshot_header *hdr = (const snapshot_header *)map;
+    const unsigned char *hist = map + sizeof(*hdr);
+    const unsigned char *sens = hist + sizeof(*h);
+    int rc = -1;
+
+    // Cualquier diferencia de formato o de hardware implica arranque en frío
+    if (memcmp(hdr->magic, snapshot_magic, sizeof(hdr->magic)) == 0 &&
+        hdr->version == SNAPSHOT_VERSION &&
+        hdr->ncpus == (uint32_t)sysconf(_SC_NPROCESSORS_ONLN) &&
+        hdr->history_size == sizeof(*h) &&
+        hdr->sensors_size == sizeof(*s) &&
+        hdr->checksum == fnv1a(fnv1a(2166136261u, hist, sizeof(*h)), sens, sizeof(*s))) {
+        memcpy(h, hist, sizeof(*h));
+        memcpy(s, sens, sizeof(*s));
+        for (int i = 0; i < SENSOR_MAX_CHANNELS; i++) {
+            s->ch[i].fd = -1;
+        }
+        rc = 0;
+    }
+
+    munmap((void *)map, expected);
+    return rc;
+}
@@ -0,0 +1,43 @@
+/**
+ * @brief Header del módulo de instantáneas para reinicio en caliente
+ * @description Define la interfaz para guardar en disco el estado en memoria
+ *              del daemon (historial de temperaturas y tabla de sensores) y
+ *              restaurarlo al arrancar. El formato es binario, versionado y
+ *              protegido con suma de verificación; cualquier discrepancia
+ *              provoca un arranque en frío.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef SNAPSHOT_H  // Si SNAPSHOT_H no está definido
+#define SNAPSHOT_H  // Definir SNAPSHOT_H como macro de protección
+
+#include "history.h"       // Para temp_history
+#include "temp_monitor.h"  // Para sensor_table
+
+// Versión del formato: incrementar ante cualquier cambio de las estructuras
+#define SNAPSHOT_VERSION 2
+
+/**
+ * @brief Guarda el estado del daemon en una instantánea
+ * @description Escribe en "<path>.tmp", sincroniza a disco y renombra sobre
+ *              @p path, de modo que un corte a mitad de escritura nunca deja
+ *              una instantánea truncada en lugar de la anterior.
+ *
+ * @return int 0 si éxito, -1 si error
+ */
+int snapshot_save(const char *path, const temp_history *h, const sensor_table *s);
+
+/**
+ * @brief Restaura el estado del daemon desde una instantánea
+ * @description Mapea el archivo con mmap() y valida firma, versión, tamaños
+ *              de las estructuras, número de CPUs y suma de verificación antes
+ *              de copiar el contenido. Los descriptores de la tabla de
+ *              sensores restaurada quedan cerrados (fd = -1).
+ *
+ * @return int 0 si se restauró, -1 si no existe o no es compatible
+ *             (en ese caso @p h y @p s no se modifican)
+ */
+int snapshot_load(const char *path, temp_history *h, sensor_table *s);
+
+#endif // SNAPSHOT_H - Fin de las guardas de inclusión
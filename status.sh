@@ -0,0 +1,65 @@
+#!/bin/bash
+
+# Uso: status.sh [archivo_configuración]
+# El informe se lee de la clave status_path de la configuración: la pasada
+# como argumento, si no la del -c del daemon en marcha (si es absoluta) y si
+# no /etc/cpu_daemon.conf. Sin la clave, la ruta por defecto del daemon.
+
+DEFAULT_CONFIG="/etc/cpu_daemon.conf"
+DEFAULT_STATUS="/home/henry/CLionProjects/cpu_daemon/logs/cpu_daemon.status"
+
+PID=$(pgrep -x "cpu_daemon" | head -n 1)
+if [ -z "$PID" ]
+then
+    echo "🟡 El daemon no está corriendo."
+    exit 0
+fi
+
+CONFIG="$1"
+if [ -z "$CONFIG" ]
+then
+    # Argumento de -c en la línea de comandos del daemon
+    CONFIG=$(tr '\0' '\n' < "/proc/$PID/cmdline" | sed -n '/^-c$/{n;p;q}; s/^-c\(.\)/\1/p' | head -n 1)
+    case "$CONFIG" in
+        /*) ;;
+        *) CONFIG="$DEFAULT_CONFIG" ;;
+    esac
+fi
+
+STATUS="$DEFAULT_STATUS"
+if [ -r "$CONFIG" ]
+then
+    KEY='^[[:space:]]*status_path[[:space:]]*='
+    if grep -q "$KEY" "$CONFIG"
+    then
+        # Última línea "status_path = ruta" (la que aplica el daemon)
+        STATUS=$(sed -n "s/$KEY[[:space:]]*//p" "$CONFIG" | tail -n 1 | sed 's/[[:space:]]*$//')
+    fi
+elif [ -n "$1" ]
+then
+    echo "🔴 No se puede leer $CONFIG."
+    exit 1
+fi
+if [ -z "$STATUS" ]
+then
+    echo "🟡 El informe de estado está desactivado (status_path vacío en $CONFIG)."
+    exit 0
+fi
+
+# SIGUSR1: el daemon escribe su informe de estado de forma atómica (archivo
+# temporal y rename). Cada informe es un inodo nuevo: se espera a que cambien
+# el inodo o el mtime para no mostrar el informe anterior
+BEFORE=$(stat -c '%i %Y' "$STATUS" 2>/dev/null)
+pkill -USR1 -x "cpu_daemon"
+for _ in $(seq 40)
+do
+    NOW=$(stat -c '%i %Y' "$STATUS" 2>/dev/null)
+    if [ -n "$NOW" ] && [ "$NOW" != "$BEFORE" ]
+    then
+        cat "$STATUS"
+        exit 0
+    fi
+    sleep 0.05
+done
+echo "🔴 El daemon no escribió un informe nuevo en $STATUS en 2 s."
+exit 1
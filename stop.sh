@@ -3,7 +3,13 @@
 if pgrep -x "cpu_daemon" > /dev/null
 then
     echo "🔴 Deteniendo daemon..."
-    pkill -x "cpu_daemon"
+    # SIGTERM: el daemon vacía el log y termina de forma ordenada
+    pkill -TERM -x "cpu_daemon"
+    # Esperar a que termine (el daemon tiene un plazo máximo de apagado)
+    for _ in $(seq 1 50); do
+        pgrep -x "cpu_daemon" > /dev/null || break
+        sleep 0.1
+    done
     echo "✅ Daemon detenido."
 else
     echo "🟡 El daemon no está corriendo."
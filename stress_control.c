@@ -0,0 +1,56 @@
+/**
+ * @brief Controlador de temperatura de cpu_stressor
+ * @description Implementa el controlador PI y el reparto de su salida.
+ *              No lee sensores ni conoce los hilos: cpu_stressor le pasa la
+ *              temperatura y aplica el resultado.
+ * @author Sistema de pruebas CPU
+ */
+
+#include "stress_control.h" // Header con declaraciones del módulo
+
+/**
+ * @brief Limita un valor al intervalo [0, 1]
+ */
+static double clamp01(double v) {
+    return v < 0.0 ? 0.0 : v > 1.0 ? 1.0 : v;
+}
+
+/**
+ * @brief Inicializa el controlador con salida nula
+ */
+void pi_init(pi_controller *c, double setpoint, double kp, double ki) {
+    c->setpoint = setpoint;
+    c->kp = kp;
+    c->ki = ki;
+    c->integral = 0.0;
+    c->output = 0.0;
+}
+
+/**
+ * @brief Calcula la nueva salida a partir de una medida
+ */
+double pi_update(pi_controller *c, double measured, double dt_s) {
+    double error = c->setpoint - measured;
+    double p = c->kp * error;
+
+    // Integración condicional: solo si la salida no está saturada en el
+    // sentido en que empujaría el error
+    double raw = p + c->integral;
+    if ((raw < 1.0 || error < 0.0) && (raw > 0.0 || error > 0.0)) {
+        c->integral = clamp01(c->integral + c->ki * error * dt_s);
+    }
+
+    c->output = clamp01(p + c->integral);
+    return c->output;
+}
+
+/**
+ * @brief Reparte una fracción de capacidad en hilos activos y ciclo de trabajo
+ */
+int stress_control_split(double output, int threads, double *duty) {
+    double cpus = clamp01(output) * threads;
+    int active = (int)cpus + ((double)(int)cpus < cpus);
+
+    *duty = active > 0 ? cpus / active : 0.0;
+    return active;
+}
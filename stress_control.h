@@ -0,0 +1,69 @@
+/**
+ * @brief Header del controlador de temperatura de cpu_stressor
+ * @description Define un controlador proporcional-integral (PI) que fija la
+ *              fracción de capacidad del stressor (0 a 1) para mantener una
+ *              temperatura de consigna. La salida se reparte después en
+ *              hilos activos y ciclo de trabajo (stress_control_split()).
+ *              Con la temperatura fijada, el rendimiento del stressor es el
+ *              rendimiento sostenido del equipo a ese techo térmico.
+ * @author Sistema de pruebas CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef STRESS_CONTROL_H  // Si STRESS_CONTROL_H no está definido
+#define STRESS_CONTROL_H  // Definir STRESS_CONTROL_H como macro de protección
+
+// Ganancias por defecto: 20 °C de error piden la capacidad completa, y un
+// error sostenido de 1 °C mueve la salida un 1% por segundo
+#define STRESS_DEFAULT_KP 0.05
+#define STRESS_DEFAULT_KI 0.01
+
+// Periodo del lazo de control en milisegundos
+#define STRESS_CONTROL_MS 500
+
+/**
+ * @brief Estado del controlador PI
+ */
+typedef struct {
+    double setpoint;        // Temperatura de consigna en °C
+    double kp;              // Ganancia proporcional (fracción por °C)
+    double ki;              // Ganancia integral (fracción por °C y segundo)
+    double integral;        // Término integral acumulado (0 a 1)
+    double output;          // Última salida (0 a 1)
+} pi_controller;
+
+/**
+ * @brief Inicializa el controlador con salida nula
+ */
+void pi_init(pi_controller *c, double setpoint, double kp, double ki);
+
+/**
+ * @brief Calcula la nueva salida a partir de una medida
+ * @description Antisaturación por integración condicional: el término
+ *              integral no crece mientras la salida está saturada en el
+ *              mismo sentido del error, así que al cruzar la consigna el
+ *              controlador responde sin arrastrar un sobreimpulso largo.
+ *
+ * @param c        Controlador
+ * @param measured Temperatura medida en °C
+ * @param dt_s     Segundos desde la medida anterior
+ *
+ * @return double Fracción de capacidad (0 a 1)
+ */
+double pi_update(pi_controller *c, double measured, double dt_s);
+
+/**
+ * @brief Reparte una fracción de capacidad en hilos activos y ciclo de trabajo
+ * @description Usa el menor número de hilos que puede dar la fracción, cada
+ *              uno con el mismo ciclo de trabajo: menos CPUs calientes a más
+ *              carga se parecen más a una carga real que todas a poca carga.
+ *
+ * @param output  Fracción de capacidad (0 a 1)
+ * @param threads Hilos disponibles
+ * @param duty    Ciclo de trabajo de los hilos activos (0 a 1)
+ *
+ * @return int Hilos activos
+ */
+int stress_control_split(double output, int threads, double *duty);
+
+#endif // STRESS_CONTROL_H - Fin de las guardas de inclusión
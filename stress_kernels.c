@@ -0,0 +1,394 @@
+/**
+ * @brief Núcleos de carga de cpu_stressor
+ * @description Implementa los núcleos de trabajo y la selección en tiempo de
+ *              ejecución de la variante de FMA (AVX-512F, AVX2+FMA o escalar)
+ *              con __builtin_cpu_supports(). Las variantes vectoriales se
+ *              compilan con __attribute__((target)), así que el binario no
+ *              exige AVX para arrancar.
+ * @author Sistema de pruebas CPU
+ */
+
+#include <stdlib.h>       // Para posix_memalign(), free()
+#include <string.h>       // Para memset(), strcmp()
+#include "stress_kernels.h" // Header con declaraciones del módulo
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>    // Para intrínsecos AVX2 / AVX-512
+#define KERNEL_X86 1
+#endif
+
+// Tamaño de bloque de cada núcleo (del orden de 1 ms en un núcleo actual)
+#define FMA_ITERS 524288      // Iteraciones de FMA por acumulador
+#define FMA_ACC 8             // Acumuladores independientes (latencia x puertos)
+#define INT_ITERS 131072      // Pasos del generador entero
+#define MEMBW_CHUNK 524288    // Elementos de triad por bloque (12 MiB de tráfico)
+#define CHASE_STEPS 8192      // Cargas dependientes por bloque
+#define LINE_WORDS 8          // uint64_t por línea de caché de 64 bytes
+
+// Nombres y unidades (mismo orden que kernel_id)
+static const char *const kernel_names[KERNEL_COUNT] = {
+    "scalar", "fma", "int", "membw", "chase", "mixed"
+};
+static const char *const kernel_units[KERNEL_COUNT] = {
+    "mul", "flop", "iter", "byte", "load", "chunk"
+};
+
+// Constantes de FMA: acc = acc * 0.999999 + 1e-6 converge a 1.0 sin
+// desbordar ni caer en subnormales
+#define FMA_MUL 0.999999
+#define FMA_ADD 1e-6
+
+#ifdef KERNEL_X86
+/**
+ * @brief Bloque de FMA con registros de 512 bits
+ */
+__attribute__((target("avx512f")))
+static double fma_avx512(double start) {
+    __m512d mul = _mm512_set1_pd(FMA_MUL);
+    __m512d add = _mm512_set1_pd(FMA_ADD);
+    __m512d acc[FMA_ACC];
+
+    // Valores iniciales distintos y conocidos solo en ejecución: el
+    // compilador no puede fusionar las cadenas ni precalcular el resultado
+    for (int j = 0; j < FMA_ACC; j++) {
+        acc[j] = _mm512_set1_pd(start + j);
+    }
+    for (int i = 0; i < FMA_ITERS; i++) {
+        for (int j = 0; j < FMA_ACC; j++) {
+            acc[j] = _mm512_fmadd_pd(acc[j], mul, add);
+        }
+    }
+    for (int j = 1; j < FMA_ACC; j++) {
+        acc[0] = _mm512_add_pd(acc[0], acc[j]);
+    }
+    return _mm512_reduce_add_pd(acc[0]);
+}
+
+/**
+ * @brief Bloque de FMA con registros de 256 bits
+ */
+__attribute__((target("avx2,fma")))
+static double fma_avx2(double start) {
+    __m256d mul = _mm256_set1_pd(FMA_MUL);
+    __m256d add = _mm256_set1_pd(FMA_ADD);
+    __m256d acc[FMA_ACC];
+    double lanes[4];
+
+    for (int j = 0; j < FMA_ACC; j++) {
+        acc[j] = _mm256_set1_pd(start + j);
+    }
+    for (int i = 0; i < FMA_ITERS; i++) {
+        for (int j = 0; j < FMA_ACC; j++) {
+            acc[j] = _mm256_fmadd_pd(acc[j], mul, add);
+        }
+    }
+    for (int j = 1; j < FMA_ACC; j++) {
+        acc[0] = _mm256_add_pd(acc[0], acc[j]);
+    }
+    _mm256_storeu_pd(lanes, acc[0]);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+#endif
+
+/**
+ * @brief Bloque de FMA escalar (CPUs sin AVX2 u otras arquitecturas)
+ */
+static double fma_scalar(double start) {
+    double acc[FMA_ACC];
+    double sum = 0.0;
+
+    for (int j = 0; j < FMA_ACC; j++) {
+        acc[j] = start + j;
+    }
+    for (int i = 0; i < FMA_ITERS; i++) {
+        for (int j = 0; j < FMA_ACC; j++) {
+            acc[j] = acc[j] * FMA_MUL + FMA_ADD;
+        }
+    }
+    for (int j = 0; j < FMA_ACC; j++) {
+        sum += acc[j];
+    }
+    return sum;
+}
+
+/**
+ * @brief Doubles por registro de la variante de FMA disponible (8, 4 o 1)
+ */
+static int fma_lanes(void) {
+#ifdef KERNEL_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        return 8;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return 4;
+    }
+#endif
+    return 1;
+}
+
+/**
+ * @brief Variante de FMA elegida en tiempo de ejecución
+ */
+const char *kernel_fma_isa(void) {
+    switch (fma_lanes()) {
+        case 8:
+            return "avx512f";
+        case 4:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+/**
+ * @brief Bloque de FMA con la variante más ancha disponible
+ */
+static uint64_t run_fma(kernel_ctx *k) {
+    int lanes = fma_lanes();
+    // Cada bloque parte del resultado del anterior
+    double start = k->sink;
+
+#ifdef KERNEL_X86
+    if (lanes == 8) {
+        k->sink = fma_avx512(start);
+    } else if (lanes == 4) {
+        k->sink = fma_avx2(start);
+    } else
+#endif
+    {
+        k->sink = fma_scalar(start);
+    }
+    // Dos operaciones de coma flotante por FMA y carril
+    return (uint64_t)FMA_ITERS * FMA_ACC * (uint64_t)lanes * 2;
+}
+
+/**
+ * @brief Bloque de la cadena escalar original (x *= 1.000001)
+ */
+static uint64_t run_scalar(kernel_ctx *k) {
+    double x = 1.0;
+
+    for (int i = 0; i < 1000000; ++i) {
+        x *= 1.000001;
+    }
+    k->sink = x;
+    return 1000000;
+}
+
+/**
+ * @brief Bloque entero con saltos impredecibles
+ * @description El generador xorshift decide en cada paso entre cuatro ramas
+ *              con trabajo distinto (suma, multiplicación, rotación,
+ *              división), así que el predictor de saltos falla a menudo.
+ */
+static uint64_t run_int(kernel_ctx *k) {
+    uint64_t x = k->state;
+    uint64_t a = 0;
+
+    for (int i = 0; i < INT_ITERS; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        switch (x & 3) {
+            case 0:
+                a += x >> 3;
+                break;
+            case 1:
+                a ^= x * 0x9E3779B97F4A7C15ull;
+                break;
+            case 2:
+                a = (a << 5) | (a >> 59);
+                break;
+            default:
+                a -= x / ((x >> 56) | 1);
+                break;
+        }
+    }
+    k->state = x;
+    k->sink = (double)a;
+    return INT_ITERS;
+}
+
+/**
+ * @brief Bloque de triad a[i] = b[i] + s * c[i] sobre arreglos mayores que la LLC
+ */
+static uint64_t run_membw(kernel_ctx *k) {
+    size_t len = k->n - k->pos < MEMBW_CHUNK ? k->n - k->pos : MEMBW_CHUNK;
+    double *a = k->a + k->pos;
+    const double *b = k->b + k->pos;
+    const double *c = k->c + k->pos;
+
+    for (size_t i = 0; i < len; i++) {
+        a[i] = b[i] + 3.0 * c[i];
+    }
+    k->sink = a[0];
+    k->pos = k->pos + len >= k->n ? 0 : k->pos + len;
+    // Dos lecturas y una escritura por elemento
+    return (uint64_t)len * 3 * sizeof(double);
+}
+
+/**
+ * @brief Bloque de cargas dependientes sobre un ciclo aleatorio
+ */
+static uint64_t run_chase(kernel_ctx *k) {
+    size_t cur = k->cur;
+
+    for (int i = 0; i < CHASE_STEPS; i++) {
+        cur = (size_t)k->chain[cur * LINE_WORDS];
+    }
+    k->cur = cur;
+    k->sink = (double)cur;
+    return CHASE_STEPS;
+}
+
+/**
+ * @brief Ejecuta un bloque del núcleo
+ */
+uint64_t kernel_run(kernel_ctx *k) {
+    switch (k->id) {
+        case KERNEL_SCALAR:
+            return run_scalar(k);
+        case KERNEL_FMA:
+            return run_fma(k);
+        case KERNEL_INT:
+            return run_int(k);
+        case KERNEL_MEMBW:
+            return run_membw(k);
+        case KERNEL_CHASE:
+            return run_chase(k);
+        case KERNEL_MIXED:
+            // Un bloque de cada núcleo por turno
+            switch (k->phase++ & 3) {
+                case 0:
+                    run_fma(k);
+                    break;
+                case 1:
+                    run_int(k);
+                    break;
+                case 2:
+                    run_membw(k);
+                    break;
+                default:
+                    run_chase(k);
+                    break;
+            }
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Reserva memoria alineada a línea de caché
+ */
+static void *alloc_lines(size_t bytes) {
+    void *p = NULL;
+    return posix_memalign(&p, 64, bytes) == 0 ? p : NULL;
+}
+
+/**
+ * @brief Siguiente valor del generador xorshift
+ */
+static uint64_t next_random(uint64_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+/**
+ * @brief Prepara un núcleo y sus búferes
+ * @description chase enlaza los nodos en un único ciclo aleatorio
+ *              (algoritmo de Sattolo), de modo que el prefetcher no puede
+ *              adivinar la siguiente línea y todo nodo se visita.
+ */
+int kernel_init(kernel_ctx *k, kernel_id id, size_t mem_bytes, uint64_t seed) {
+    memset(k, 0, sizeof(*k));
+    k->id = id;
+    k->state = seed | 1;
+
+    // mixed reparte la memoria entre membw y chase
+    size_t membw_bytes = id == KERNEL_MEMBW ? mem_bytes : id == KERNEL_MIXED ? mem_bytes / 2 : 0;
+    size_t chase_bytes = id == KERNEL_CHASE ? mem_bytes : id == KERNEL_MIXED ? mem_bytes / 2 : 0;
+
+    if (membw_bytes > 0) {
+        k->n = membw_bytes / 3 / sizeof(double);
+        if (k->n == 0) {
+            return -1;
+        }
+        k->a = alloc_lines(k->n * sizeof(double));
+        k->b = alloc_lines(k->n * sizeof(double));
+        k->c = alloc_lines(k->n * sizeof(double));
+        if (!k->a || !k->b || !k->c) {
+            kernel_free(k);
+            return -1;
+        }
+        // Primer acceso desde el hilo fijado: páginas en su nodo NUMA
+        for (size_t i = 0; i < k->n; i++) {
+            k->a[i] = 0.0;
+            k->b[i] = (double)i;
+            k->c[i] = 1.0;
+        }
+    }
+
+    if (chase_bytes > 0) {
+        k->nodes = chase_bytes / (LINE_WORDS * sizeof(uint64_t));
+        if (k->nodes < 2) {
+            kernel_free(k);
+            return -1;
+        }
+        k->chain = alloc_lines(k->nodes * LINE_WORDS * sizeof(uint64_t));
+        if (!k->chain) {
+            kernel_free(k);
+            return -1;
+        }
+        for (size_t i = 0; i < k->nodes; i++) {
+            k->chain[i * LINE_WORDS] = i;
+        }
+        for (size_t i = k->nodes - 1; i > 0; i--) {
+            size_t j = (size_t)(next_random(&k->state) % i);
+            uint64_t t = k->chain[i * LINE_WORDS];
+            k->chain[i * LINE_WORDS] = k->chain[j * LINE_WORDS];
+            k->chain[j * LINE_WORDS] = t;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Libera los búferes del núcleo
+ */
+void kernel_free(kernel_ctx *k) {
+    free(k->a);
+    free(k->b);
+    free(k->c);
+    free(k->chain);
+    k->a = k->b = k->c = NULL;
+    k->chain = NULL;
+}
+
+/**
+ * @brief Busca un núcleo por nombre
+ */
+int kernel_parse(const char *name) {
+    for (int i = 0; i < KERNEL_COUNT; i++) {
+        if (strcmp(name, kernel_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Nombre de un núcleo ("fma", "int", ...)
+ */
+const char *kernel_name(kernel_id id) {
+    return id >= 0 && id < KERNEL_COUNT ? kernel_names[id] : "?";
+}
+
+/**
+ * @brief Unidad de trabajo que devuelve kernel_run() ("flop", "byte", ...)
+ */
+const char *kernel_unit(kernel_id id) {
+    return id >= 0 && id < KERNEL_COUNT ? kernel_units[id] : "?";
+}
@@ -0,0 +1,106 @@
+/**
+ * @brief Header de los núcleos de carga de cpu_stressor
+ * @description Define los núcleos de trabajo seleccionables con -k. Cada uno
+ *              estresa una parte distinta del procesador y produce un patrón
+ *              de calor y de throttling diferente:
+ *              - scalar: cadena escalar dependiente (el bucle original)
+ *              - fma:    FMA vectorial AVX-512 o AVX2 según la CPU, con
+ *                        suficientes acumuladores independientes para
+ *                        saturar las unidades de FMA
+ *              - int:    aritmética entera con saltos impredecibles
+ *              - membw:  ancho de banda de memoria en streaming (triad)
+ *              - chase:  recorrido de punteros aleatorio, un fallo de caché
+ *                        por carga
+ *              - mixed:  alterna los cuatro anteriores por bloque
+ *              Cada llamada a kernel_run() ejecuta un bloque de tamaño fijo
+ *              (del orden de un milisegundo) y deja su resultado en memoria
+ *              del contexto, para que el compilador no pueda eliminar el
+ *              cálculo con -O3.
+ * @author Sistema de pruebas CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef STRESS_KERNELS_H  // Si STRESS_KERNELS_H no está definido
+#define STRESS_KERNELS_H  // Definir STRESS_KERNELS_H como macro de protección
+
+#include <stddef.h>  // Para size_t
+#include <stdint.h>  // Para tipos de ancho fijo
+
+/**
+ * @brief Núcleos disponibles
+ */
+typedef enum {
+    KERNEL_SCALAR,
+    KERNEL_FMA,
+    KERNEL_INT,
+    KERNEL_MEMBW,
+    KERNEL_CHASE,
+    KERNEL_MIXED,
+    KERNEL_COUNT
+} kernel_id;
+
+/**
+ * @brief Estado de un núcleo en un hilo de trabajo
+ * @description Los búferes se reservan y se tocan por primera vez en
+ *              kernel_init(), que debe llamarse desde el hilo ya fijado a su
+ *              CPU para que la memoria quede en su nodo NUMA.
+ */
+typedef struct {
+    kernel_id id;           // Núcleo seleccionado
+    int phase;              // Siguiente núcleo de mixed
+    double *a, *b, *c;      // Arreglos de membw
+    size_t n;               // Elementos de cada arreglo de membw
+    size_t pos;             // Siguiente bloque de membw
+    uint64_t *chain;        // Nodos de chase (un índice por línea de caché)
+    size_t nodes;           // Nodos de chase
+    size_t cur;             // Nodo actual de chase
+    uint64_t state;         // Estado del generador de int
+    double sink;            // Resultado del último bloque (evita la eliminación)
+} kernel_ctx;
+
+/**
+ * @brief Prepara un núcleo y sus búferes
+ *
+ * @param k         Contexto a inicializar
+ * @param id        Núcleo
+ * @param mem_bytes Memoria por hilo para membw y chase
+ * @param seed      Semilla (distinta por hilo)
+ *
+ * @return int 0 si éxito, -1 si no hay memoria
+ */
+int kernel_init(kernel_ctx *k, kernel_id id, size_t mem_bytes, uint64_t seed);
+
+/**
+ * @brief Ejecuta un bloque del núcleo
+ * @return uint64_t Trabajo hecho, en las unidades de kernel_unit()
+ */
+uint64_t kernel_run(kernel_ctx *k);
+
+/**
+ * @brief Libera los búferes del núcleo
+ */
+void kernel_free(kernel_ctx *k);
+
+/**
+ * @brief Busca un núcleo por nombre
+ * @return int kernel_id, o -1 si no existe
+ */
+int kernel_parse(const char *name);
+
+/**
+ * @brief Nombre de un núcleo ("fma", "int", ...)
+ */
+const char *kernel_name(kernel_id id);
+
+/**
+ * @brief Unidad de trabajo que devuelve kernel_run() ("flop", "byte", ...)
+ */
+const char *kernel_unit(kernel_id id);
+
+/**
+ * @brief Variante de FMA elegida en tiempo de ejecución
+ * @return const char* "avx512f", "avx2" o "scalar"
+ */
+const char *kernel_fma_isa(void);
+
+#endif // STRESS_KERNELS_H - Fin de las guardas de inclusión
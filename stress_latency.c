@@ -0,0 +1,174 @@
+/**
+ * @brief Sondas de latencia por bloque de cpu_stressor
+ * @description Implementa el histograma log-lineal y la cola de ventanas.
+ *              latency_record() es la única función en el camino del hilo
+ *              de trabajo: unas decenas de instrucciones por bloque de un
+ *              milisegundo.
+ * @author Sistema de pruebas CPU
+ */
+
+#include <string.h>          // Para memset()
+#include "stress_latency.h"  // Header con declaraciones del módulo
+
+/**
+ * @brief Cubeta de una latencia
+ * @description Valores menores que LATENCY_SUB tienen cubeta propia; el
+ *              resto se reparte en LATENCY_SUB cubetas por octava según los
+ *              bits que siguen al más significativo.
+ */
+static int bucket_of(uint64_t ns) {
+    if (ns < LATENCY_SUB) {
+        return (int)ns;
+    }
+    int msb = 63 - __builtin_clzll(ns);
+    if (msb > LATENCY_MAX_MSB) {
+        return LATENCY_BUCKETS - 1;
+    }
+    int shift = msb - LATENCY_SUB_BITS;
+    return (shift + 1) * LATENCY_SUB + (int)((ns >> shift) & (LATENCY_SUB - 1));
+}
+
+/**
+ * @brief Punto medio del rango de valores de una cubeta
+ */
+static uint64_t bucket_mid(int b) {
+    if (b < LATENCY_SUB) {
+        return (uint64_t)b;
+    }
+    int shift = b / LATENCY_SUB - 1;
+    uint64_t low = (uint64_t)(LATENCY_SUB + b % LATENCY_SUB) << shift;
+    return low + ((1ull << shift) >> 1);
+}
+
+/**
+ * @brief Inicializa una sonda
+ */
+void latency_init(latency_probe *p, uint64_t epoch_ns, uint64_t window_ns) {
+    memset(p, 0, sizeof(*p));
+    p->epoch_ns = epoch_ns;
+    p->window_ns = window_ns;
+    p->hist.min_ns = UINT64_MAX;
+    p->w_min = UINT64_MAX;
+}
+
+/**
+ * @brief Publica la ventana en curso y la reinicia
+ * @description Si la cola está llena la ventana se descarta y se cuenta:
+ *              el hilo de trabajo nunca espera al consumidor.
+ */
+static void close_window(latency_probe *p) {
+    if (p->w_count > 0) {
+        uint32_t head = p->head;
+        uint32_t tail = __atomic_load_n(&p->tail, __ATOMIC_ACQUIRE);
+        if (head - tail < LATENCY_RING) {
+            latency_window *w = &p->ring[head % LATENCY_RING];
+            w->end_ns = p->window_end;
+            w->count = p->w_count;
+            w->min_ns = (uint32_t)(p->w_min < UINT32_MAX ? p->w_min : UINT32_MAX);
+            w->mean_ns = (uint32_t)(p->w_sum / p->w_count < UINT32_MAX ? p->w_sum / p->w_count : UINT32_MAX);
+            w->max_ns = (uint32_t)(p->w_max < UINT32_MAX ? p->w_max : UINT32_MAX);
+            __atomic_store_n(&p->head, head + 1, __ATOMIC_RELEASE);
+        } else {
+            p->dropped++;
+        }
+    }
+    p->w_count = 0;
+    p->w_sum = 0;
+    p->w_min = UINT64_MAX;
+    p->w_max = 0;
+}
+
+/**
+ * @brief Registra un bloque (solo el hilo dueño de la sonda)
+ */
+void latency_record(latency_probe *p, uint64_t end_ns, uint64_t ns) {
+    latency_hist *h = &p->hist;
+    h->count++;
+    h->buckets[bucket_of(ns)]++;
+    if (ns < h->min_ns) {
+        h->min_ns = ns;
+    }
+    if (ns > h->max_ns) {
+        h->max_ns = ns;
+    }
+
+    if (p->window_ns == 0) {
+        return;
+    }
+    // El bloque cuenta en la ventana en la que terminó
+    if (end_ns >= p->window_end) {
+        close_window(p);
+        p->window_end = p->epoch_ns + ((end_ns - p->epoch_ns) / p->window_ns + 1) * p->window_ns;
+    }
+    p->w_count++;
+    p->w_sum += ns;
+    if (ns < p->w_min) {
+        p->w_min = ns;
+    }
+    if (ns > p->w_max) {
+        p->w_max = ns;
+    }
+}
+
+/**
+ * @brief Cierra la ventana en curso (al terminar el hilo)
+ */
+void latency_flush(latency_probe *p) {
+    if (p->window_ns != 0) {
+        close_window(p);
+    }
+}
+
+/**
+ * @brief Extrae la ventana más antigua pendiente (solo el consumidor)
+ */
+int latency_pop(latency_probe *p, latency_window *out) {
+    uint32_t tail = p->tail;
+    if (tail == __atomic_load_n(&p->head, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    *out = p->ring[tail % LATENCY_RING];
+    __atomic_store_n(&p->tail, tail + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/**
+ * @brief Acumula un histograma en otro
+ */
+void latency_merge(latency_hist *dst, const latency_hist *src) {
+    if (dst->count == 0) {
+        dst->min_ns = UINT64_MAX;
+    }
+    dst->count += src->count;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        dst->buckets[i] += src->buckets[i];
+    }
+    if (src->count > 0 && src->min_ns < dst->min_ns) {
+        dst->min_ns = src->min_ns;
+    }
+    if (src->max_ns > dst->max_ns) {
+        dst->max_ns = src->max_ns;
+    }
+}
+
+/**
+ * @brief Percentil de un histograma
+ */
+uint64_t latency_percentile(const latency_hist *h, double pct) {
+    if (h->count == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(pct / 100.0 * (double)h->count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint64_t v = bucket_mid(i);
+            return v < h->min_ns ? h->min_ns : v > h->max_ns ? h->max_ns : v;
+        }
+    }
+    return h->max_ns;
+}
@@ -0,0 +1,120 @@
+/**
+ * @brief Header de las sondas de latencia por bloque de cpu_stressor
+ * @description Cada hilo mide la duración de cada bloque de kernel_run(),
+ *              que tiene un tamaño de trabajo fijo: si la frecuencia baja
+ *              por throttling, el bloque tarda más en la misma proporción,
+ *              y se ve en milisegundos sin depender de los contadores de
+ *              sysfs. Cada hilo mantiene:
+ *              - un histograma acumulado log-lineal (16 cubetas por octava,
+ *                error relativo < 6,25%) para los percentiles finales
+ *              - un resumen por ventana (mínimo, media y máximo) alineado
+ *                con el reloj común, que pasa al hilo principal por una
+ *                cola circular de un productor y un consumidor
+ *              El reloj es CLOCK_MONOTONIC, el mismo del daemon, para poder
+ *              comparar ambas trazas.
+ * @author Sistema de pruebas CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef STRESS_LATENCY_H  // Si STRESS_LATENCY_H no está definido
+#define STRESS_LATENCY_H  // Definir STRESS_LATENCY_H como macro de protección
+
+#include <stdint.h>  // Para tipos de ancho fijo
+
+// Cubetas por octava (2^LATENCY_SUB_BITS) y octava máxima (2^39 ns ~ 9 min)
+#define LATENCY_SUB_BITS 4
+#define LATENCY_SUB (1 << LATENCY_SUB_BITS)
+#define LATENCY_MAX_MSB 39
+#define LATENCY_BUCKETS ((LATENCY_MAX_MSB - LATENCY_SUB_BITS + 2) * LATENCY_SUB)
+
+// Ventanas pendientes por hilo (2,5 s con ventanas de 10 ms)
+#define LATENCY_RING 256
+
+// Ventana por defecto de los resúmenes, en milisegundos
+#define LATENCY_DEFAULT_WINDOW_MS 10
+
+/**
+ * @brief Histograma acumulado de latencias
+ */
+typedef struct {
+    uint64_t count;                      // Bloques medidos
+    uint64_t min_ns, max_ns;             // Extremos observados
+    uint64_t buckets[LATENCY_BUCKETS];   // Histograma log-lineal
+} latency_hist;
+
+/**
+ * @brief Resumen de una ventana
+ */
+typedef struct {
+    uint64_t end_ns;        // Final de la ventana (CLOCK_MONOTONIC)
+    uint32_t count;         // Bloques terminados en la ventana
+    uint32_t min_ns;        // Bloque más rápido
+    uint32_t mean_ns;       // Media
+    uint32_t max_ns;        // Bloque más lento
+} latency_window;
+
+/**
+ * @brief Sonda de un hilo de trabajo
+ * @description Solo el hilo escribe el histograma y la ventana en curso;
+ *              head la escribe el hilo y tail el consumidor.
+ */
+typedef struct {
+    latency_hist hist;              // Histograma acumulado
+    uint64_t epoch_ns;              // Origen común de las ventanas
+    uint64_t window_ns;             // Duración de la ventana (0 = sin ventanas)
+    uint64_t window_end;            // Final de la ventana en curso
+    uint32_t w_count;               // Ventana en curso: bloques, suma y extremos
+    uint64_t w_sum, w_min, w_max;
+    latency_window ring[LATENCY_RING];
+    uint32_t head;                  // Próxima posición a escribir (hilo)
+    uint32_t tail;                  // Próxima posición a leer (consumidor)
+    uint64_t dropped;               // Ventanas perdidas con la cola llena
+} latency_probe;
+
+/**
+ * @brief Inicializa una sonda
+ *
+ * @param p         Sonda
+ * @param epoch_ns  Origen común de las ventanas
+ * @param window_ns Duración de la ventana (0 = solo histograma)
+ */
+void latency_init(latency_probe *p, uint64_t epoch_ns, uint64_t window_ns);
+
+/**
+ * @brief Registra un bloque (solo el hilo dueño de la sonda)
+ *
+ * @param p      Sonda
+ * @param end_ns Instante en que terminó el bloque
+ * @param ns     Duración del bloque
+ */
+void latency_record(latency_probe *p, uint64_t end_ns, uint64_t ns);
+
+/**
+ * @brief Cierra la ventana en curso (al terminar el hilo)
+ */
+void latency_flush(latency_probe *p);
+
+/**
+ * @brief Extrae la ventana más antigua pendiente (solo el consumidor)
+ * @return int 1 si se extrajo una ventana, 0 si no hay ninguna
+ */
+int latency_pop(latency_probe *p, latency_window *out);
+
+/**
+ * @brief Acumula un histograma en otro
+ */
+void latency_merge(latency_hist *dst, const latency_hist *src);
+
+/**
+ * @brief Percentil de un histograma
+ * @description Devuelve el punto medio de la cubeta que contiene el
+ *              percentil, limitado a los extremos observados.
+ *
+ * @param h   Histograma
+ * @param pct Percentil entre 0 y 100
+ *
+ * @return uint64_t Latencia en nanosegundos (0 si no hay mediciones)
+ */
+uint64_t latency_percentile(const latency_hist *h, double pct);
+
+#endif // STRESS_LATENCY_H - Fin de las guardas de inclusión
@@ -0,0 +1,101 @@
+/**
+ * @brief Enlace con los contadores de cpu_stressor
+ * @description Implementa la lectura del objeto de memoria compartida de
+ *              cpu_stressor. Cada ciclo hace un stat() de la ruta para
+ *              detectar que el objeto se ha recreado o borrado; la lectura
+ *              de los contadores son cargas atómicas sin llamadas al
+ *              sistema.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <string.h>     // Para memset()
+#include <unistd.h>     // Para close()
+#include <fcntl.h>      // Para open() y constantes O_*
+#include <sys/mman.h>   // Para mmap(), munmap()
+#include <sys/stat.h>   // Para stat(), fstat()
+#include "stress_link.h" // Header con declaraciones del módulo
+
+/**
+ * @brief Inicializa un enlace sin objeto mapeado
+ */
+void stress_link_init(stress_link *l) {
+    memset(l, 0, sizeof(*l));
+}
+
+/**
+ * @brief Libera el objeto mapeado
+ */
+void stress_link_close(stress_link *l) {
+    if (l->map != NULL) {
+        munmap((void *)l->map, l->size);
+    }
+    stress_link_init(l);
+}
+
+/**
+ * @brief Mapea el objeto y valida su cabecera
+ * @return int 0 si éxito, -1 si no existe o aún no está completo
+ */
+static int link_map(stress_link *l, const char *path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat sb;
+    if (fstat(fd, &sb) < 0 || (size_t)sb.st_size < sizeof(stress_shm)) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)sb.st_size;
+    void *p = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        return -1;
+    }
+
+    // magic se publica al final: si no está, cpu_stressor aún arranca
+    const stress_shm *s = p;
+    if (__atomic_load_n(&s->magic, __ATOMIC_ACQUIRE) != STRESS_SHM_MAGIC ||
+        s->version != STRESS_SHM_VERSION || STRESS_SHM_SIZE(s->threads) > size) {
+        munmap(p, size);
+        return -1;
+    }
+
+    l->map = s;
+    l->size = size;
+    l->ino = sb.st_ino;
+    l->primed = 0;
+    return 0;
+}
+
+/**
+ * @brief Lee los contadores y calcula el rendimiento del intervalo
+ */
+int stress_link_sample(stress_link *l, const char *path, uint64_t now_ns) {
+    struct stat sb;
+
+    if (stat(path, &sb) < 0) {
+        stress_link_close(l);
+        return -1;
+    }
+    if (l->map != NULL && sb.st_ino != l->ino) {
+        stress_link_close(l);
+    }
+    if (l->map == NULL && link_map(l, path) < 0) {
+        return -1;
+    }
+
+    uint64_t ops = 0;
+    for (uint32_t i = 0; i < l->map->threads; i++) {
+        ops += __atomic_load_n(&l->map->slot[i].ops, __ATOMIC_RELAXED);
+    }
+
+    int valid = l->primed && now_ns > l->last_ns;
+    if (valid) {
+        l->ops_per_s = (double)(ops - l->last_ops) * 1e9 / (double)(now_ns - l->last_ns);
+    }
+    l->last_ops = ops;
+    l->last_ns = now_ns;
+    l->primed = 1;
+    return valid;
+}
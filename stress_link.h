@@ -0,0 +1,59 @@
+/**
+ * @brief Header del enlace con los contadores de cpu_stressor
+ * @description Define la interfaz con la que el daemon lee el trabajo
+ *              publicado por cpu_stressor -s (stress_shm.h) y lo convierte
+ *              en rendimiento por segundo en cada ciclo de muestreo. Junto
+ *              con la temperatura y la frecuencia de la misma muestra, la
+ *              caída del rendimiento cuantifica el coste del throttling.
+ *              El objeto se mapea en solo lectura y se vuelve a mapear
+ *              cuando cambia (un nuevo cpu_stressor con el mismo nombre).
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef STRESS_LINK_H  // Si STRESS_LINK_H no está definido
+#define STRESS_LINK_H  // Definir STRESS_LINK_H como macro de protección
+
+#include <stdint.h>      // Para tipos de ancho fijo
+#include <stddef.h>      // Para size_t
+#include <sys/types.h>   // Para ino_t
+#include "stress_shm.h"  // Para stress_shm
+
+/**
+ * @brief Estado del enlace
+ */
+typedef struct {
+    const stress_shm *map;    // Objeto mapeado (NULL = sin cpu_stressor)
+    size_t size;              // Bytes mapeados
+    ino_t ino;                // Inodo del objeto mapeado
+    uint64_t last_ops;        // Trabajo total de la lectura anterior
+    uint64_t last_ns;         // Instante de la lectura anterior
+    int primed;               // 1 si ya hay una lectura previa para el ritmo
+    double ops_per_s;         // Rendimiento del último intervalo
+} stress_link;
+
+/**
+ * @brief Inicializa un enlace sin objeto mapeado
+ */
+void stress_link_init(stress_link *l);
+
+/**
+ * @brief Lee los contadores y calcula el rendimiento del intervalo
+ * @description Mapea el objeto si aparece o si se ha recreado, y lo libera
+ *              si desaparece (cpu_stressor terminó).
+ *
+ * @param l       Enlace
+ * @param path    Ruta del objeto (/dev/shm/<nombre>)
+ * @param now_ns  Instante de la lectura (CLOCK_MONOTONIC)
+ *
+ * @return int 1 si ops_per_s es válido, 0 si aún no hay intervalo, -1 si
+ *             no hay un cpu_stressor publicando en path
+ */
+int stress_link_sample(stress_link *l, const char *path, uint64_t now_ns);
+
+/**
+ * @brief Libera el objeto mapeado
+ */
+void stress_link_close(stress_link *l);
+
+#endif // STRESS_LINK_H - Fin de las guardas de inclusión
@@ -0,0 +1,223 @@
+/**
+ * @brief Perfiles de carga de cpu_stressor
+ * @description Implementa las formas de onda y la lectura de trazas de
+ *              utilización. profile_level() es una función pura del tiempo:
+ *              todos los hilos la evalúan al inicio de cada periodo y
+ *              obtienen el mismo valor sin compartir estado.
+ * @author Sistema de pruebas CPU
+ */
+
+#include <stdio.h>      // Para fopen(), fgets()
+#include <stdlib.h>     // Para strtod(), realloc(), free()
+#include <string.h>     // Para memset(), strchr(), strncmp()
+#include <ctype.h>      // Para isspace()
+#include "stress_profile.h" // Header con declaraciones del módulo
+
+// Nombres de las formas de onda (mismo orden que profile_shape)
+static const char *const shape_names[] = {"constant", "square", "sawtooth", "ramp", "trace"};
+
+/**
+ * @brief Inicializa un perfil constante
+ */
+void profile_constant(stress_profile *p, double util) {
+    memset(p, 0, sizeof(*p));
+    p->shape = PROFILE_CONSTANT;
+    p->low = p->high = util;
+}
+
+/**
+ * @brief Lee un porcentaje entre 0 y 100 seguido de @p sep
+ * @return int 0 si éxito, -1 si no es válido
+ */
+static int parse_pct(const char **s, char sep, double *out) {
+    char *end;
+    double v = strtod(*s, &end);
+    if (end == *s || *end != sep || v < 0.0 || v > 100.0) {
+        return -1;
+    }
+    *out = v / 100.0;
+    *s = sep != '\0' ? end + 1 : end;
+    return 0;
+}
+
+/**
+ * @brief Interpreta una forma de onda "forma:periodo_s:low_pct:high_pct"
+ */
+int profile_parse_wave(stress_profile *p, const char *spec) {
+    const char *colon = strchr(spec, ':');
+    char *end;
+
+    memset(p, 0, sizeof(*p));
+    if (colon == NULL) {
+        return -1;
+    }
+    // Solo las formas periódicas: constant y trace tienen sus propias opciones
+    size_t len = (size_t)(colon - spec);
+    int found = 0;
+    for (int i = PROFILE_SQUARE; i <= PROFILE_RAMP; i++) {
+        if (strlen(shape_names[i]) == len && strncmp(spec, shape_names[i], len) == 0) {
+            p->shape = (profile_shape)i;
+            found = 1;
+        }
+    }
+    if (!found) {
+        return -1;
+    }
+
+    const char *s = colon + 1;
+    p->period_s = strtod(s, &end);
+    if (end == s || *end != ':' || !(p->period_s > 0.0)) {
+        return -1;
+    }
+    s = end + 1;
+    if (parse_pct(&s, ':', &p->low) < 0 || parse_pct(&s, '\0', &p->high) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Carga una traza de utilización
+ */
+int profile_load_trace(stress_profile *p, const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[256];
+    size_t cap = 0;
+
+    memset(p, 0, sizeof(*p));
+    p->shape = PROFILE_TRACE;
+    if (!f) {
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        char *s = line, *end;
+        while (isspace((unsigned char)*s)) {
+            s++;
+        }
+        if (*s == '\0' || *s == '#') {
+            continue;
+        }
+
+        double t = strtod(s, &end);
+        if (end == s) {
+            goto fail;
+        }
+        s = end;
+        double pct = strtod(s, &end);
+        while (isspace((unsigned char)*end)) {
+            end++;
+        }
+        if (end == s || *end != '\0' || pct < 0.0 || pct > 100.0) {
+            goto fail;
+        }
+
+        if (p->npoints == cap) {
+            cap = cap ? cap * 2 : 256;
+            profile_point *grown = realloc(p->points, cap * sizeof(*grown));
+            if (grown == NULL) {
+                goto fail;
+            }
+            p->points = grown;
+        }
+        p->points[p->npoints].t_s = t;
+        p->points[p->npoints].util = pct / 100.0;
+        p->npoints++;
+    }
+    fclose(f);
+    f = NULL;
+
+    if (p->npoints == 0) {
+        goto fail;
+    }
+    // Tiempos relativos al primer punto y no decrecientes
+    double t0 = p->points[0].t_s;
+    for (size_t i = 0; i < p->npoints; i++) {
+        p->points[i].t_s -= t0;
+        if (i > 0 && p->points[i].t_s < p->points[i - 1].t_s) {
+            goto fail;
+        }
+    }
+    return 0;
+
+fail:
+    if (f) {
+        fclose(f);
+    }
+    profile_free(p);
+    return -1;
+}
+
+/**
+ * @brief Busca el último punto de la traza con tiempo <= t_s
+ * @description Búsqueda binaria: una traza de horas a 1 Hz tiene miles de
+ *              puntos y se consulta en cada periodo de cada hilo.
+ */
+static double trace_level(const stress_profile *p, double t_s) {
+    size_t lo = 0, hi = p->npoints;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (p->points[mid].t_s <= t_s) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return p->points[lo].util;
+}
+
+/**
+ * @brief Fracción transcurrida del periodo actual (0 a 1)
+ */
+static double phase(const stress_profile *p, double t_s) {
+    double cycles = t_s / p->period_s;
+    return cycles - (double)(unsigned long long)cycles;
+}
+
+/**
+ * @brief Utilización objetivo en un instante
+ */
+double profile_level(const stress_profile *p, double t_s) {
+    switch (p->shape) {
+        case PROFILE_SQUARE:
+            return phase(p, t_s) < 0.5 ? p->high : p->low;
+        case PROFILE_SAWTOOTH:
+            return p->low + (p->high - p->low) * phase(p, t_s);
+        case PROFILE_RAMP:
+            if (t_s >= p->period_s) {
+                return p->high;
+            }
+            return p->low + (p->high - p->low) * t_s / p->period_s;
+        case PROFILE_TRACE:
+            return trace_level(p, t_s);
+        case PROFILE_CONSTANT:
+        default:
+            return p->high;
+    }
+}
+
+/**
+ * @brief Duración natural del perfil
+ */
+double profile_length(const stress_profile *p) {
+    if (p->shape != PROFILE_TRACE || p->npoints == 0) {
+        return 0.0;
+    }
+    return p->points[p->npoints - 1].t_s;
+}
+
+/**
+ * @brief Nombre de la forma de onda ("square", ...)
+ */
+const char *profile_name(profile_shape shape) {
+    return shape_names[shape];
+}
+
+/**
+ * @brief Libera la traza del perfil
+ */
+void profile_free(stress_profile *p) {
+    free(p->points);
+    p->points = NULL;
+    p->npoints = 0;
+}
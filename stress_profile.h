@@ -0,0 +1,101 @@
+/**
+ * @brief Header de los perfiles de carga de cpu_stressor
+ * @description Define la utilización objetivo en función del tiempo. Los
+ *              hilos de trabajo la convierten en ciclos de trabajo y reposo
+ *              (duty cycle) dentro de periodos cortos y comunes a todos los
+ *              hilos, de modo que el socket entero sigue la forma de onda:
+ *              - constant: utilización fija (-u)
+ *              - square:   alterna low y high cada medio periodo
+ *              - sawtooth: sube de low a high en cada periodo y vuelve a low
+ *              - ramp:     sube de low a high una sola vez y se mantiene
+ *              - trace:    reproduce una traza "segundos porcentaje"
+ *                          grabada en producción (valor retenido hasta el
+ *                          punto siguiente)
+ * @author Sistema de pruebas CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef STRESS_PROFILE_H  // Si STRESS_PROFILE_H no está definido
+#define STRESS_PROFILE_H  // Definir STRESS_PROFILE_H como macro de protección
+
+#include <stddef.h>  // Para size_t
+
+/**
+ * @brief Formas de onda disponibles
+ */
+typedef enum {
+    PROFILE_CONSTANT,
+    PROFILE_SQUARE,
+    PROFILE_SAWTOOTH,
+    PROFILE_RAMP,
+    PROFILE_TRACE
+} profile_shape;
+
+/**
+ * @brief Punto de una traza de utilización
+ */
+typedef struct {
+    double t_s;             // Segundos desde el primer punto
+    double util;            // Utilización (0 a 1)
+} profile_point;
+
+/**
+ * @brief Perfil de carga
+ */
+typedef struct {
+    profile_shape shape;    // Forma de onda
+    double low, high;       // Utilización mínima y máxima (0 a 1)
+    double period_s;        // Periodo de square y sawtooth, duración de ramp
+    profile_point *points;  // Traza (solo PROFILE_TRACE)
+    size_t npoints;
+} stress_profile;
+
+/**
+ * @brief Inicializa un perfil constante
+ * @param util Utilización (0 a 1)
+ */
+void profile_constant(stress_profile *p, double util);
+
+/**
+ * @brief Interpreta una forma de onda "forma:periodo_s:low_pct:high_pct"
+ * @description Por ejemplo "square:20:10:100" o "ramp:60:0:100".
+ *
+ * @return int 0 si éxito, -1 si la especificación no es válida
+ */
+int profile_parse_wave(stress_profile *p, const char *spec);
+
+/**
+ * @brief Carga una traza de utilización
+ * @description Una línea por punto, "segundos porcentaje", con tiempos no
+ *              decrecientes; las líneas vacías y las que empiezan con '#'
+ *              se ignoran. Los tiempos se toman relativos al primer punto,
+ *              así que sirven las marcas absolutas de una grabación.
+ *
+ * @return int 0 si éxito, -1 si el archivo no existe o no es válido
+ */
+int profile_load_trace(stress_profile *p, const char *path);
+
+/**
+ * @brief Utilización objetivo en un instante
+ * @param t_s Segundos desde el arranque
+ * @return double Utilización (0 a 1)
+ */
+double profile_level(const stress_profile *p, double t_s);
+
+/**
+ * @brief Duración natural del perfil
+ * @return double Segundos de la traza, 0 si el perfil no termina
+ */
+double profile_length(const stress_profile *p);
+
+/**
+ * @brief Nombre de la forma de onda ("square", ...)
+ */
+const char *profile_name(profile_shape shape);
+
+/**
+ * @brief Libera la traza del perfil
+ */
+void profile_free(stress_profile *p);
+
+#endif // STRESS_PROFILE_H - Fin de las guardas de inclusión
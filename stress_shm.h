@@ -0,0 +1,54 @@
+/**
+ * @brief Formato de los contadores compartidos de cpu_stressor
+ * @description cpu_stressor publica en un objeto de memoria compartida
+ *              (shm_open(), visible como /dev/shm/<nombre>) el trabajo
+ *              acumulado por cada hilo. El daemon lo mapea en solo lectura
+ *              (clave stress_shm) y registra el rendimiento junto a la
+ *              temperatura de cada muestra. Cada hilo escribe solo su propia
+ *              línea de caché, con almacenamientos atómicos de 64 bits, así
+ *              que no hay bloqueos ni falso compartir.
+ * @author Sistema de pruebas CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef STRESS_SHM_H  // Si STRESS_SHM_H no está definido
+#define STRESS_SHM_H  // Definir STRESS_SHM_H como macro de protección
+
+#include <stdint.h>  // Para tipos de ancho fijo
+
+// Identificación del formato ("STS1") y versión
+#define STRESS_SHM_MAGIC 0x31535453u
+#define STRESS_SHM_VERSION 1
+
+// Longitud de los nombres de núcleo y unidad
+#define STRESS_SHM_NAME_LEN 16
+
+/**
+ * @brief Contador de un hilo (una línea de caché)
+ */
+typedef struct {
+    uint64_t ops;        // Trabajo acumulado, en la unidad del núcleo
+    uint64_t pad[7];
+} stress_shm_slot;
+
+/**
+ * @brief Cabecera del objeto compartido, seguida de un contador por hilo
+ * @description magic se escribe en último lugar: un lector que ve el valor
+ *              correcto ve también el resto de la cabecera.
+ */
+typedef struct {
+    uint32_t magic;                      // STRESS_SHM_MAGIC
+    uint32_t version;                    // STRESS_SHM_VERSION
+    uint32_t threads;                    // Contadores que siguen a la cabecera
+    int32_t pid;                         // PID de cpu_stressor
+    char kernel[STRESS_SHM_NAME_LEN];    // Nombre del núcleo ("fma")
+    char unit[STRESS_SHM_NAME_LEN];      // Unidad de trabajo ("flop")
+    uint64_t start_ns;                   // Arranque (CLOCK_MONOTONIC)
+    uint64_t reserved;
+    stress_shm_slot slot[];              // Un contador por hilo
+} stress_shm;
+
+// Tamaño del objeto para n hilos
+#define STRESS_SHM_SIZE(n) (sizeof(stress_shm) + (size_t)(n) * sizeof(stress_shm_slot))
+
+#endif // STRESS_SHM_H - Fin de las guardas de inclusión
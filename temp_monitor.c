@@ -7,34 +7,138 @@
  * @dependencies Requiere lm-sensors instalado en el sistema Linux
  */
 
-#include <stdio.h>      // Para FILE, fgets(), popen(), pclose()
+#include <stdio.h>      // Para snprintf(), sscanf()
 #include <stdlib.h>     // Para funciones de utilidad del sistema
-#include <string.h>     // Para strstr() - búsqueda de subcadenas
+#include <string.h>     // Para strchr(), strcspn(), strncmp()
+#include <errno.h>      // Para errno, EINTR, EAGAIN
+#include <spawn.h>      // Para posix_spawnp(), posix_spawn_file_actions_*
+#include <poll.h>       // Para poll()
+#include <dirent.h>     // Para opendir(), readdir() - recorrido de hwmon
+#include <fcntl.h>      // Para open() y constantes O_*
+#include <unistd.h>     // Para pread(), read(), pipe(), close(), access(), usleep()
+#include <sys/wait.h>   // Para waitpid()
 #include "temp_monitor.h" // Header con declaraciones del monitor de temperatura
+#include "probes.h"     // Probes USDT (sin coste si están desactivados)
+#include "signals.h"    // Para signals_spawnattr(), signals_reap_child()
+
+/**
+ * @brief Regla de un perfil: etiqueta (o prefijo seguido de un número) y rol
+ */
+typedef struct {
+    const char *label;    // Etiqueta exacta, o prefijo si indexed
+    int indexed;          // 1 si la etiqueta termina en un número ("Core 3")
+    sensor_role role;     // Rol asignado al canal
+    int rank;             // Preferencia como canal primario (0 = nunca)
+} label_rule;
+
+/**
+ * @brief Perfil de un driver hwmon: sus reglas de etiquetas
+ */
+typedef struct {
+    const char *driver;        // Contenido de hwmonN/name
+    const label_rule *rules;   // Terminado en {NULL}
+} driver_profile;
+
+/*
+ * k10temp / zenpower: en Zen 1 y Zen+ Tctl = Tdie + offset (10 a 27 °C
+ * según el modelo) y el driver expone Tdie aparte; desde Zen 2 el offset es
+ * 0 y solo existe Tctl. Preferir Tdie evita alertas falsas por el offset.
+ */
+static const label_rule amd_rules[] = {
+    {"Tdie", 0, SENSOR_ROLE_DIE, 5},
+    {"Tctl", 0, SENSOR_ROLE_CONTROL, 4},
+    {"Tccd", 1, SENSOR_ROLE_CCD, 2},
+    {NULL, 0, SENSOR_ROLE_OTHER, 0},
+};
+
+// coretemp: un canal por paquete y uno por núcleo físico
+static const label_rule coretemp_rules[] = {
+    {"Package id ", 1, SENSOR_ROLE_PACKAGE, 4},
+    {"Core ", 1, SENSOR_ROLE_CORE, 2},
+    {NULL, 0, SENSOR_ROLE_OTHER, 0},
+};
+
+// acpitz: zonas térmicas ACPI sin etiqueta; último recurso
+static const label_rule acpitz_rules[] = {
+    {"temp", 1, SENSOR_ROLE_ZONE, 1},
+    {NULL, 0, SENSOR_ROLE_OTHER, 0},
+};
+
+static const driver_profile profiles[] = {
+    {"k10temp", amd_rules},
+    {"zenpower", amd_rules},
+    {"coretemp", coretemp_rules},
+    {"acpitz", acpitz_rules},
+};
+
+/**
+ * @brief Asigna rol, índice y preferencia a un canal según su driver
+ * @description Solo se ejecuta en el descubrimiento. Un driver sin perfil
+ *              o una etiqueta desconocida dejan el canal como
+ *              SENSOR_ROLE_OTHER, que nunca se elige como primario.
+ */
+static void classify(sensor_channel *c) {
+    c->role = SENSOR_ROLE_OTHER;
+    c->index = 0;
+    c->rank = 0;
+
+    for (size_t i = 0; i < sizeof(profiles) / sizeof(profiles[0]); i++) {
+        if (strcmp(profiles[i].driver, c->driver) != 0) {
+            continue;
+        }
+        for (const label_rule *r = profiles[i].rules; r->label; r++) {
+            size_t n = strlen(r->label);
+            int index = 0;
+            char end;
+            if (r->indexed
+                ? strncmp(c->label, r->label, n) == 0 && sscanf(c->label + n, "%d%c", &index, &end) == 1
+                : strcmp(c->label, r->label) == 0) {
+                c->role = r->role;
+                c->index = index;
+                c->rank = r->rank;
+                return;
+            }
+        }
+        return;
+    }
+}
+
+/**
+ * @brief Indica si el canal b es mejor primario que el canal a
+ * @description Mayor preferencia primero; a igualdad, el índice menor
+ *              ("Package id 0" antes que "Package id 1").
+ */
+static int better_primary(const sensor_channel *a, const sensor_channel *b) {
+    if (b->rank == 0) {
+        return 0;
+    }
+    return !a || b->rank > a->rank || (b->rank == a->rank && b->index < a->index);
+}
 
 /**
  * @brief Obtiene la temperatura actual del CPU del sistema
  * @description Esta función ejecuta el comando 'sensors' del sistema y parsea
- *              su salida para extraer la temperatura del controlador térmico (Tctl).
- *              Utiliza pipes para capturar la salida del comando y busca 
- *              específicamente la línea que contiene "Tctl:" con el formato
- *              "Tctl: +XX.X°C".
+ *              su salida para extraer la temperatura del canal preferido. La
+ *              salida agrupa los canales por chip ("k10temp-pci-00c3",
+ *              "coretemp-isa-0000"); el driver se toma de esa cabecera y cada
+ *              línea "<etiqueta>: +XX.X°C" se clasifica con los mismos perfiles
+ *              que el descubrimiento de hwmon.
  * 
  * @return float Temperatura del CPU en grados Celsius
  *               - Valor positivo: Temperatura válida del CPU
  *               - -1.0: Error al ejecutar el comando sensors o al leer la temperatura
- *               - 0.0: No se encontró la línea Tctl o formato incorrecto
+ *               - 0.0: No se encontró ningún canal con perfil o formato incorrecto
  * 
  * @details Proceso interno:
- *          1. Ejecuta 'sensors' usando popen() para capturar su salida
+ *          1. Ejecuta 'sensors' con un plazo de SENSORS_TIMEOUT_MS
  *          2. Lee línea por línea la salida del comando
- *          3. Busca la línea que contiene "Tctl:" (Temperature Control)
- *          4. Extrae el valor numérico con formato "+XX.X°C"
- *          5. Retorna la temperatura como float
+ *          3. Las líneas sin ':' son cabeceras de chip: driver actual
+ *          4. Las líneas "<etiqueta>: +XX.X°C" se clasifican por driver
+ *          5. Retorna la temperatura del canal de mayor preferencia
  * 
  * @note Formato esperado de sensors: "Tctl: +XX.X°C (high = +XX.X°C)"
  * @note Tctl = Temperature Control - sensor térmico principal en CPUs AMD
- * @note Para CPUs Intel, el formato puede variar (Core 0, Package id 0, etc.)
+ * @note En CPUs Intel se usa "Package id 0" de coretemp
  * 
  * @warning Requiere que lm-sensors esté instalado y configurado
  * @warning La función es específica para el formato de salida de sensors en Linux
@@ -48,47 +152,420 @@
  *          }
  */
 float get_cpu_temp() {
-    // Ejecutar comando 'sensors' y abrir pipe para leer su salida
-    // popen(): crea un pipe y ejecuta el comando, retorna FILE* para leer
-    // "r": modo lectura del pipe
-    FILE *fp = popen("sensors", "r");
-    
-    // Verificar si el comando se ejecutó correctamente
-    if (!fp) {
+    return get_cpu_temp_timeout(SENSORS_TIMEOUT_MS);
+}
+
+// Proceso 'sensors' que no terminó en su plazo y aún no se ha recogido
+static pid_t sensors_stuck;
+
+/**
+ * @brief get_cpu_temp() con un plazo para el comando 'sensors'
+ * @description Lanza 'sensors' con posix_spawnp() y lee su salida por una
+ *              tubería no bloqueante con poll(), de modo que la espera
+ *              nunca pasa del plazo (popen() y fgets() esperaban sin límite).
+ */
+float get_cpu_temp_timeout(unsigned timeout_ms) {
+    extern char **environ;
+
+    // Un 'sensors' anterior sigue bloqueado: no lanzar otro
+    if (sensors_stuck > 0) {
+        if (waitpid(sensors_stuck, NULL, WNOHANG) == 0) {
+            return -1;
+        }
+        sensors_stuck = 0;
+    }
+
+    // Tubería para la salida del comando; el extremo de lectura no bloquea
+    int fds[2];
+    if (pipe(fds) < 0) {
+        return -1;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+    // Grupo de procesos propio: al vencer el plazo se mata también lo que
+    // haya lanzado (un envoltorio de 'sensors')
+    posix_spawn_file_actions_t fa;
+    posix_spawnattr_t attr;
+    if (signals_spawnattr(&attr, POSIX_SPAWN_SETPGROUP) != 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    posix_spawn_file_actions_init(&fa);
+    posix_spawn_file_actions_adddup2(&fa, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&fa, fds[1]);
+    char *argv[] = {"sensors", NULL};
+    pid_t pid;
+    int rc = posix_spawnp(&pid, "sensors", &fa, &attr, argv, environ);
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&fa);
+    close(fds[1]);
+    if (rc != 0) {
         // Error al ejecutar sensors - posiblemente no está instalado
+        close(fds[0]);
         return -1;
     }
 
-    // Buffer para almacenar cada línea de la salida de sensors
-    // 256 caracteres es suficiente para las líneas típicas de sensors
-    char line[256];
-    
-    // Variable para almacenar la temperatura extraída
+    // Leer toda la salida hasta el fin de archivo o el plazo
+    long start = signals_now_ms();
+    char out[8192], discard[512];
+    size_t len = 0;
+    int timed_out = 0;
+    for (;;) {
+        int wait_ms = -1;
+        if (timeout_ms > 0) {
+            long elapsed = signals_now_ms() - start;
+            if (elapsed >= (long)timeout_ms) {
+                timed_out = 1;
+                break;
+            }
+            wait_ms = (int)((long)timeout_ms - elapsed);
+        }
+        struct pollfd p = {.fd = fds[0], .events = POLLIN};
+        int ready = poll(&p, 1, wait_ms);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+
+        // Lo que no cabe se descarta para que 'sensors' no se bloquee escribiendo
+        ssize_t n = len < sizeof(out) - 1 ? read(fds[0], out + len, sizeof(out) - 1 - len)
+                                          : read(fds[0], discard, sizeof(discard));
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+            break;
+        }
+        if (n > 0 && len < sizeof(out) - 1) {
+            len += (size_t)n;
+        }
+    }
+    close(fds[0]);
+    // Tras el fin de archivo el hijo suele estar terminando: se le espera lo
+    // que quede del plazo antes de matar su grupo
+    if (signals_reap_child(pid, start, timeout_ms, 1) < 0) {
+        sensors_stuck = pid;
+    }
+    if (timed_out) {
+        return -1;
+    }
+    out[len] = '\0';
+
+    // Canal de la línea actual y mejor canal visto hasta ahora
+    sensor_channel cur, best;
+    int found = 0;
     float temp = 0.0;
 
-    // Leer la salida del comando línea por línea
-    while (fgets(line, sizeof(line), fp)) {
-        // Buscar la línea que contiene "Tctl:" (Temperature Control)
-        // strstr(): busca la subcadena "Tctl:" en la línea actual
-        // Tctl es el sensor de temperatura principal en procesadores AMD
-        if (strstr(line, "Tctl:")) {
-            // Parsear la línea para extraer el valor de temperatura
-            // Formato esperado: "Tctl: +XX.X°C (high = +XX.X°C, crit = +XX.X°C)"
-            // sscanf(): extrae el valor numérico después del signo +
-            // "+%f°C": patrón que reconoce el signo + seguido de float y °C
-            if (sscanf(line, "Tctl: +%f°C", &temp) == 1) {
-                // Temperatura extraída exitosamente, salir del bucle
-                break;
+    memset(&cur, 0, sizeof(cur));
+
+    // Recorrer la salida del comando línea por línea
+    char *next;
+    for (char *line = out; *line != '\0'; line = next) {
+        next = strchr(line, '\n');
+        if (next) {
+            *next++ = '\0';
+        } else {
+            next = line + strlen(line);
+        }
+
+        char *colon = strchr(line, ':');
+        if (!colon) {
+            // Cabecera de chip "driver-bus-dirección": el driver es el
+            // texto hasta el primer '-'
+            if (line[0] != '\0') {
+                snprintf(cur.driver, sizeof(cur.driver), "%.*s", (int)strcspn(line, "-"), line);
             }
+            continue;
+        }
+
+        // Etiqueta antes de ':' y valor con formato "+XX.X°C" después
+        float value;
+        snprintf(cur.label, sizeof(cur.label), "%.*s", (int)(colon - line), line);
+        if (sscanf(colon + 1, " %f°C", &value) != 1) {
+            continue;
+        }
+        classify(&cur);
+        if (better_primary(found ? &best : NULL, &cur)) {
+            best = cur;
+            temp = value;
+            found = 1;
         }
     }
 
-    // Cerrar el pipe y liberar recursos
-    // pclose(): cierra el pipe y espera a que termine el proceso hijo
-    pclose(fp);
-    
     // Retornar la temperatura obtenida
-    // - Si se encontró Tctl: retorna la temperatura en °C
+    // - Si se encontró un canal con perfil: retorna la temperatura en °C
     // - Si no se encontró: retorna 0.0
     return temp;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Lee un archivo pequeño de sysfs (una línea) eliminando el '\n' final
+ * @return int 0 si éxito, -1 si el archivo no existe o no se pudo leer
+ */
+static int read_attr(const char *path, char *buf, size_t size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    ssize_t n = read(fd, buf, size - 1);
+    close(fd);
+    if (n <= 0) {
+        return -1;
+    }
+
+    buf[n] = '\0';
+    if (buf[n - 1] == '\n') {
+        buf[n - 1] = '\0';
+    }
+    return 0;
+}
+
+/**
+ * @brief Elige el canal primario de la tabla
+ * @description Mismo criterio que get_cpu_temp(): el canal de mayor
+ *              preferencia según el perfil de su driver.
+ */
+static void pick_primary(sensor_table *t) {
+    t->primary = -1;
+    for (int i = 0; i < t->count; i++) {
+        if (better_primary(t->primary >= 0 ? &t->ch[t->primary] : NULL, &t->ch[i])) {
+            t->primary = i;
+        }
+    }
+}
+
+/**
+ * @brief Añade a la tabla los canales de un dispositivo hwmonN
+ * @description Lee "name" y enumera los tempK_input. Los índices K no
+ *              tienen por qué ser consecutivos (k10temp expone temp1, temp3,
+ *              temp5...), por eso se recorre el directorio en lugar de
+ *              probar índices.
+ *
+ * @return int Canales añadidos
+ */
+static int scan_device(sensor_table *t, const char *devname) {
+    char devdir[SENSOR_PATH_LEN];
+    char attr[SENSOR_PATH_LEN + 32];
+    char driver[SENSOR_NAME_LEN];
+    int added = 0;
+
+    if (snprintf(devdir, sizeof(devdir), "%s/class/hwmon/%s", t->root, devname) >= (int)sizeof(devdir)) {
+        // Las rutas de sus canales tampoco cabrían en SENSOR_PATH_LEN
+        return 0;
+    }
+    snprintf(attr, sizeof(attr), "%s/name", devdir);
+    if (read_attr(attr, driver, sizeof(driver)) < 0) {
+        return 0;
+    }
+
+    DIR *d = opendir(devdir);
+    if (!d) {
+        return 0;
+    }
+
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL && t->count < SENSOR_MAX_CHANNELS) {
+        // Buscar entradas "tempK_input"
+        unsigned k;
+        char tail[16];
+        if (sscanf(e->d_name, "temp%u_%15s", &k, tail) != 2 || strcmp(tail, "input") != 0) {
+            continue;
+        }
+
+        sensor_channel *c = &t->ch[t->count];
+        snprintf(c->driver, sizeof(c->driver), "%s", driver);
+        if (snprintf(c->path, sizeof(c->path), "%s/%s", devdir, e->d_name) >= (int)sizeof(c->path)) {
+            continue;
+        }
+
+        snprintf(attr, sizeof(attr), "%s/temp%u_label", devdir, k);
+        if (read_attr(attr, c->label, sizeof(c->label)) < 0) {
+            snprintf(c->label, sizeof(c->label), "temp%u", k);
+        }
+        c->fd = -1;
+        classify(c);
+        t->count++;
+        added++;
+    }
+    closedir(d);
+    return added;
+}
+
+/**
+ * @brief Indica si un canal pertenece al dispositivo hwmonN dado
+ */
+static int channel_on_device(const sensor_channel *c, const char *devname) {
+    const char *slash = strrchr(c->path, '/');
+    size_t n = strlen(devname);
+
+    return slash && (size_t)(slash - c->path) > n && slash[-(long)n - 1] == '/' &&
+           strncmp(slash - n, devname, n) == 0;
+}
+
+/**
+ * @brief Descubre los canales de temperatura bajo <sysfs_root>/class/hwmon
+ * @description Recorre los dispositivos hwmon y añade los canales de cada
+ *              uno; después elige el canal primario.
+ */
+int sensors_discover(sensor_table *t, const char *sysfs_root) {
+    char dir[SENSOR_PATH_LEN];
+
+    memset(t, 0, sizeof(*t));
+    t->primary = -1;
+    snprintf(t->root, sizeof(t->root), "%s", sysfs_root);
+    snprintf(dir, sizeof(dir), "%s/class/hwmon", sysfs_root);
+
+    DIR *hwmon = opendir(dir);
+    if (!hwmon) {
+        return -1;
+    }
+
+    struct dirent *dev;
+    while ((dev = readdir(hwmon)) != NULL && t->count < SENSOR_MAX_CHANNELS) {
+        if (strncmp(dev->d_name, "hwmon", 5) == 0) {
+            scan_device(t, dev->d_name);
+        }
+    }
+    closedir(hwmon);
+
+    pick_primary(t);
+    return t->count;
+}
+
+/**
+ * @brief Añade los canales de un dispositivo hwmon que acaba de aparecer
+ */
+int sensors_add_device(sensor_table *t, const char *devname) {
+    for (int i = 0; i < t->count; i++) {
+        if (channel_on_device(&t->ch[i], devname)) {
+            // Evento repetido: el dispositivo ya está en la tabla
+            return 0;
+        }
+    }
+
+    int first = t->count;
+    int added = scan_device(t, devname);
+    for (int i = first; i < t->count; i++) {
+        t->ch[i].fd = open(t->ch[i].path, O_RDONLY | O_CLOEXEC);
+    }
+    pick_primary(t);
+    return added;
+}
+
+/**
+ * @brief Quita de la tabla los canales de un dispositivo hwmon retirado
+ */
+int sensors_remove_device(sensor_table *t, const char *devname) {
+    int kept = 0;
+
+    for (int i = 0; i < t->count; i++) {
+        if (!channel_on_device(&t->ch[i], devname)) {
+            t->ch[kept++] = t->ch[i];
+        } else if (t->ch[i].fd >= 0) {
+            close(t->ch[i].fd);
+        }
+    }
+
+    int removed = t->count - kept;
+    t->count = kept;
+    pick_primary(t);
+    return removed;
+}
+
+/**
+ * @brief Comprueba que una tabla cacheada sigue describiendo el hardware
+ * @description Los números hwmonN pueden cambiar tras recargar un driver; en
+ *              ese caso el archivo "name" del directorio cacheado ya no
+ *              coincide (o no existe) y la tabla se descarta.
+ */
+int sensors_validate(const sensor_table *t, const char *sysfs_root) {
+    if (strcmp(t->root, sysfs_root) != 0 || t->count <= 0 || t->count > SENSOR_MAX_CHANNELS) {
+        return -1;
+    }
+
+    for (int i = 0; i < t->count; i++) {
+        const sensor_channel *c = &t->ch[i];
+        char attr[SENSOR_PATH_LEN + 32];
+        char driver[SENSOR_NAME_LEN];
+
+        // Directorio del dispositivo: la ruta sin el "/tempK_input" final
+        const char *slash = strrchr(c->path, '/');
+        if (!slash) {
+            return -1;
+        }
+        snprintf(attr, sizeof(attr), "%.*s/name", (int)(slash - c->path), c->path);
+
+        if (read_attr(attr, driver, sizeof(driver)) < 0 || strcmp(driver, c->driver) != 0) {
+            return -1;
+        }
+        if (access(c->path, R_OK) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Abre los descriptores persistentes de todos los canales
+ */
+int sensors_open(sensor_table *t) {
+    int rc = 0;
+
+    for (int i = 0; i < t->count; i++) {
+        t->ch[i].fd = open(t->ch[i].path, O_RDONLY | O_CLOEXEC);
+        if (t->ch[i].fd < 0) {
+            rc = -1;
+        }
+    }
+    return rc;
+}
+
+/**
+ * @brief Cierra los descriptores persistentes de todos los canales
+ */
+void sensors_close(sensor_table *t) {
+    for (int i = 0; i < t->count; i++) {
+        if (t->ch[i].fd >= 0) {
+            close(t->ch[i].fd);
+            t->ch[i].fd = -1;
+        }
+    }
+}
+
+/**
+ * @brief Lee la temperatura de un canal con pread() sobre su descriptor
+ * @description hwmon expone miligrados Celsius como entero decimal. pread()
+ *              con desplazamiento 0 vuelve a generar el valor sin necesidad
+ *              de lseek() ni de reabrir el archivo. En el daemon el valor
+ *              suele venir ya leído en el lote del ciclo.
+ */
+float sensors_read(const sensor_table *t, int channel, const acquire *a) {
+    if (channel < 0 || channel >= t->count || t->ch[channel].fd < 0) {
+        return -1;
+    }
+
+    char buf[SENSOR_READ_LEN + 1];
+    ssize_t n = acquire_pread(a, t->ch[channel].fd, buf, SENSOR_READ_LEN);
+    if (n <= 0) {
+        return -1;
+    }
+
+    // Conversión manual de miligrados (más barata que sscanf en cada muestra)
+    long milli = 0;
+    int neg = 0;
+    ssize_t i = 0;
+    if (buf[0] == '-') {
+        neg = 1;
+        i = 1;
+    }
+    for (; i < n && buf[i] >= '0' && buf[i] <= '9'; i++) {
+        milli = milli * 10 + (buf[i] - '0');
+    }
+    if (neg) {
+        milli = -milli;
+    }
+    PROBE_SENSOR_READ(channel, milli);
+    return milli / 1000.0f;
+}
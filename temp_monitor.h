@@ -12,22 +12,26 @@
 #ifndef TEMP_MONITOR_H  // Si TEMP_MONITOR_H no está definido
 #define TEMP_MONITOR_H  // Definir TEMP_MONITOR_H como macro
 
+#include "acquire.h"  // Para acquire (lecturas servidas por el lote del ciclo)
+
 /**
  * @brief Declaración de función para obtener la temperatura actual del CPU
  * @description Esta función obtiene la temperatura actual del procesador
  *              ejecutando el comando 'sensors' del sistema y parseando su salida
- *              para extraer el valor de temperatura del controlador térmico (Tctl).
+ *              para extraer la temperatura del canal preferido según los
+ *              mismos perfiles de driver que sensors_discover().
  * 
  * @return float Temperatura del CPU en grados Celsius
  *               - Valor positivo (ej: 45.5): Temperatura válida del CPU
  *               - -1.0: Error al ejecutar el comando sensors o leer datos
- *               - 0.0: No se encontró el sensor Tctl o formato incorrecto
+ *               - 0.0: No se encontró ningún canal con perfil o formato incorrecto
  * 
  * @details Comportamiento de la función:
  *          - Ejecuta 'sensors' usando pipes del sistema
- *          - Busca líneas que contengan "Tctl:" (Temperature Control)
- *          - Extrae valores con formato "Tctl: +XX.X°C"
- *          - Maneja errores de ejecución y formato
+ *          - Toma el driver de la cabecera de cada chip ("k10temp-pci-00c3")
+ *          - Extrae valores con formato "<etiqueta>: +XX.X°C"
+ *          - Se queda con el canal de mayor preferencia (Tdie, Tctl,
+ *            "Package id 0", ...)
  * 
  * @dependencies Sistema requerido:
  *               - Linux con lm-sensors instalado
@@ -35,8 +39,8 @@
  *               - Sensores de temperatura configurados
  * 
  * @compatibility 
- *                - CPUs AMD: Utiliza sensor "Tctl" (Temperature Control)
- *                - CPUs Intel: Puede requerir adaptación del formato
+ *                - CPUs AMD: Tdie si existe, si no "Tctl" (Temperature Control)
+ *                - CPUs Intel: "Package id 0" de coretemp
  *                - Sistemas Linux: Probado con lm-sensors estándar
  * 
  * @performance 
@@ -57,7 +61,7 @@
  *        } else if (temp == -1.0) {
  *            printf("Error: sensors no disponible\n");
  *        } else {
- *            printf("Error: sensor Tctl no encontrado\n");
+ *            printf("Error: sensor de CPU no encontrado\n");
  *        }
  *        
  *        // Uso en bucle de monitoreo
@@ -75,4 +79,146 @@
  */
 float get_cpu_temp();
 
+// Plazo por defecto de get_cpu_temp() para que 'sensors' escriba su salida
+#define SENSORS_TIMEOUT_MS 2000
+
+/**
+ * @brief get_cpu_temp() con un plazo para el comando 'sensors'
+ * @description Si 'sensors' no termina a tiempo (un chip que no responde
+ *              bloquea su lectura) se mata con SIGKILL y se devuelve -1.
+ *              Mientras ese proceso no haya terminado no se lanza otro: un
+ *              hijo bloqueado en el kernel no se acumula en cada muestra.
+ *
+ * @param timeout_ms Espera máxima (0 = sin plazo)
+ *
+ * @return float Igual que get_cpu_temp(); -1 también si venció el plazo
+ */
+float get_cpu_temp_timeout(unsigned timeout_ms);
+
+// Capacidad máxima de la tabla de sensores descubiertos
+#define SENSOR_MAX_CHANNELS 64
+
+// Longitud máxima de las rutas y nombres almacenados en la tabla
+#define SENSOR_PATH_LEN 128
+#define SENSOR_NAME_LEN 32
+
+// Bytes leídos de cada tempN_input
+#define SENSOR_READ_LEN 23
+
+/**
+ * @brief Semántica de un canal según el perfil de su driver
+ * @description Se asigna una sola vez en el descubrimiento; el muestreo y
+ *              los módulos que agregan por topología usan el rol y el índice
+ *              sin volver a comparar etiquetas.
+ */
+typedef enum {
+    SENSOR_ROLE_OTHER,    // Driver o etiqueta sin perfil
+    SENSOR_ROLE_ZONE,     // Zona térmica ACPI (acpitz, "tempN")
+    SENSOR_ROLE_CONTROL,  // Tctl: temperatura de control (Tdie + offset en Zen 1 / Zen+)
+    SENSOR_ROLE_DIE,      // Tdie: temperatura real del die (solo si hay offset)
+    SENSOR_ROLE_CCD,      // TccdN: un CCD
+    SENSOR_ROLE_PACKAGE,  // Package id N: un paquete Intel
+    SENSOR_ROLE_CORE      // Core N: un núcleo físico Intel
+} sensor_role;
+
+/**
+ * @brief Canal de temperatura descubierto en /sys/class/hwmon
+ * @description Describe un archivo tempN_input de un dispositivo hwmon. Todos
+ *              los campos salvo fd son datos planos, por lo que la tabla se
+ *              puede guardar tal cual en la instantánea de reinicio en caliente.
+ */
+typedef struct {
+    char driver[SENSOR_NAME_LEN];  // Contenido de hwmonN/name (k10temp, coretemp...)
+    char label[SENSOR_NAME_LEN];   // Contenido de tempK_label, o "tempK" si no existe
+    char path[SENSOR_PATH_LEN];    // Ruta completa del archivo tempK_input
+    int role;                      // sensor_role según el perfil del driver
+    int index;                     // N de "Core N", "TccdN", "Package id N" o "tempN"
+    int rank;                      // Preferencia como canal primario (0 = nunca)
+    int fd;                        // Descriptor persistente (-1 si está cerrado)
+} sensor_channel;
+
+/**
+ * @brief Tabla de canales de temperatura del sistema
+ * @description Se construye una sola vez en el descubrimiento; el muestreo
+ *              solo hace pread() sobre descriptores ya abiertos, sin recorrer
+ *              directorios ni ejecutar procesos externos.
+ */
+typedef struct {
+    char root[SENSOR_PATH_LEN];    // Raíz de sysfs usada ("/sys" o un árbol falso)
+    int count;                     // Número de canales válidos
+    int primary;                   // Canal usado como temperatura del CPU (-1 si ninguno)
+    sensor_channel ch[SENSOR_MAX_CHANNELS];
+} sensor_table;
+
+/**
+ * @brief Descubre los canales de temperatura bajo <sysfs_root>/class/hwmon
+ * @description Recorre los dispositivos hwmon y registra cada tempN_input con
+ *              su driver y etiqueta, y le asigna rol e índice con el perfil
+ *              de su driver (k10temp, zenpower, coretemp, acpitz). El canal
+ *              principal es el de mayor preferencia: Tdie, luego Tctl o
+ *              "Package id" del paquete 0, luego CCDs y núcleos y por último
+ *              las zonas ACPI. No abre descriptores.
+ *
+ * @param t          Tabla destino (se sobrescribe)
+ * @param sysfs_root Raíz de sysfs, normalmente "/sys"
+ *
+ * @return int Número de canales descubiertos, -1 si no se pudo leer hwmon
+ */
+int sensors_discover(sensor_table *t, const char *sysfs_root);
+
+/**
+ * @brief Añade los canales de un dispositivo hwmon que acaba de aparecer
+ * @description Recorre solo <root>/class/hwmon/<devname>, abre los
+ *              descriptores de sus canales y vuelve a elegir el primario. Si
+ *              el dispositivo ya está en la tabla no hace nada.
+ *
+ * @param t       Tabla de sensores
+ * @param devname Nombre del dispositivo ("hwmon3")
+ *
+ * @return int Canales añadidos
+ */
+int sensors_add_device(sensor_table *t, const char *devname);
+
+/**
+ * @brief Quita de la tabla los canales de un dispositivo hwmon retirado
+ * @description Cierra sus descriptores, compacta la tabla y vuelve a elegir
+ *              el primario. Los índices de los canales restantes pueden
+ *              cambiar.
+ *
+ * @return int Canales quitados
+ */
+int sensors_remove_device(sensor_table *t, const char *devname);
+
+/**
+ * @brief Comprueba que una tabla cacheada sigue describiendo el hardware
+ * @description Verifica que la raíz coincide, que cada dispositivo hwmon
+ *              conserva el mismo driver y que cada tempN_input existe. Es
+ *              mucho más barato que un descubrimiento completo.
+ *
+ * @return int 0 si la tabla es válida, -1 si el hardware cambió
+ */
+int sensors_validate(const sensor_table *t, const char *sysfs_root);
+
+/**
+ * @brief Abre los descriptores persistentes de todos los canales
+ * @return int 0 si se abrieron todos, -1 si alguno falló (queda con fd = -1)
+ */
+int sensors_open(sensor_table *t);
+
+/**
+ * @brief Cierra los descriptores persistentes de todos los canales
+ */
+void sensors_close(sensor_table *t);
+
+/**
+ * @brief Lee la temperatura de un canal con pread() sobre su descriptor
+ *
+ * @param t       Tabla de sensores
+ * @param channel Canal
+ * @param a       Lote del ciclo (NULL = pread() directa)
+ *
+ * @return float Temperatura en °C, o -1.0 si el canal no es legible
+ */
+float sensors_read(const sensor_table *t, int channel, const acquire *a);
+
 #endif // TEMP_MONITOR_H - Fin de las guardas de inclusión
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+ * @brief Prueba del muestreo de cpu.stat y del ranking de cgroups
+ * @description Recorre el árbol tests/cgroup/t0 con cgroup_set_open(),
+ *              muestrea su cpu.stat y vuelve a muestrear con los cpu.stat
+ *              de t1 (mismo árbol, contadores posteriores). Comprueba:
+ *              - los deltas de usage_usec, nr_throttled y throttled_usec
+ *                entre las claves user_usec, nr_periods, nr_bursts...
+ *              - un grupo sin el controlador cpu (sin claves de throttling)
+ *              - el consumo propio (sin los hijos) y el ranking de
+ *                cgroup_set_top(): un slice con un servicio activo no debe
+ *                aparecer por delante de su propio servicio
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage test_cgroup <directorio tests/cgroup>
+ */
+
+#include <stdio.h>        // Para printf(), fprintf(), snprintf()
+#include <string.h>       // Para strcmp()
+#include <unistd.h>       // Para close()
+#include <fcntl.h>        // Para open() y constantes O_*
+#include "cgroup_stat.h"  // Para cgroup_set_open() y cgroup_set_top()
+
+/**
+ * @brief Deltas esperados de un grupo entre t0 y t1
+ */
+typedef struct {
+    const char *name;
+    uint64_t d_usage_usec;
+    uint64_t d_self_usec;
+    uint64_t d_nr_throttled;
+    uint64_t d_throttled_usec;
+} expect_group;
+
+static const expect_group groups[] = {
+    {".", 860000, 10000, 0, 0},
+    {"system.slice", 650000, 50000, 0, 0},
+    {"system.slice/a.service", 500000, 500000, 3, 15000},
+    {"system.slice/b.service", 100000, 100000, 0, 0},
+    {"user.slice", 200000, 200000, 0, 0},
+};
+
+// Ranking esperado por consumo propio
+static const char *const top_names[] = {"system.slice/a.service", "user.slice", "system.slice/b.service"};
+
+#define NGROUPS ((int)(sizeof(groups) / sizeof(groups[0])))
+#define NTOP ((int)(sizeof(top_names) / sizeof(top_names[0])))
+
+/**
+ * @brief Busca un grupo por nombre
+ * @return int Índice en el conjunto, -1 si no existe
+ */
+static int find_group(const cgroup_set *s, const char *name) {
+    for (int i = 0; i < s->count; i++) {
+        if (strcmp(s->cg[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Apunta el cpu.stat de cada grupo al del árbol @p dir
+ * @return int 0 si éxito, -1 si falta algún archivo
+ */
+static int reopen(cgroup_set *s, const char *dir) {
+    char path[PATH_MAX + CGROUP_NAME_LEN + 16];
+
+    for (int i = 0; i < s->count; i++) {
+        close(s->cg[i].stat_fd);
+        snprintf(path, sizeof(path), "%s/%s/cpu.stat", dir, s->cg[i].name);
+        s->cg[i].stat_fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (s->cg[i].stat_fd < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    char dir[PATH_MAX];
+    static cgroup_set s;
+    int failed = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "Uso: %s <directorio tests/cgroup>\n", argv[0]);
+        return 2;
+    }
+
+    snprintf(dir, sizeof(dir), "%s/t0", argv[1]);
+    if (cgroup_set_open(&s, dir, 2) != NGROUPS) {
+        fprintf(stderr, "%s: %d grupos, se esperaban %d\n", dir, s.count, NGROUPS);
+        return 1;
+    }
+    cgroup_set_sample(&s, NULL);
+
+    snprintf(dir, sizeof(dir), "%s/t1", argv[1]);
+    if (reopen(&s, dir) < 0) {
+        fprintf(stderr, "%s: falta algún cpu.stat\n", dir);
+        return 1;
+    }
+    cgroup_set_sample(&s, NULL);
+
+    for (int k = 0; k < NGROUPS; k++) {
+        const expect_group *e = &groups[k];
+        int i = find_group(&s, e->name);
+        if (i < 0) {
+            fprintf(stderr, "falta el grupo %s\n", e->name);
+            failed++;
+            continue;
+        }
+        const cgroup_entry *g = &s.cg[i];
+        if (g->d_usage_usec != e->d_usage_usec || g->d_self_usec != e->d_self_usec ||
+            g->d_nr_throttled != e->d_nr_throttled || g->d_throttled_usec != e->d_throttled_usec) {
+            fprintf(stderr, "%s: usage %llu propio %llu throttled %llu/%llu, se esperaba %llu %llu %llu/%llu\n",
+                    e->name, (unsigned long long)g->d_usage_usec, (unsigned long long)g->d_self_usec,
+                    (unsigned long long)g->d_nr_throttled, (unsigned long long)g->d_throttled_usec,
+                    (unsigned long long)e->d_usage_usec, (unsigned long long)e->d_self_usec,
+                    (unsigned long long)e->d_nr_throttled, (unsigned long long)e->d_throttled_usec);
+            failed++;
+        }
+    }
+    printf("%-14s %s\n", "deltas", failed ? "FALLO" : "ok");
+
+    int top[NTOP];
+    int n = cgroup_set_top(&s, top, NTOP);
+    int bad = n != NTOP;
+    for (int k = 0; k < n && !bad; k++) {
+        bad = strcmp(s.cg[top[k]].name, top_names[k]) != 0;
+    }
+    if (bad) {
+        fprintf(stderr, "ranking:");
+        for (int k = 0; k < n; k++) {
+            fprintf(stderr, " %s", s.cg[top[k]].name);
+        }
+        fprintf(stderr, "\n");
+    }
+    printf("%-14s %s\n", "top", bad ? "FALLO" : "ok");
+
+    cgroup_set_close(&s);
+    return failed || bad ? 1 : 0;
+}
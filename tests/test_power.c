@@ -0,0 +1,177 @@
+/**
+ * @brief Prueba del descubrimiento de zonas de energía y del cálculo de potencia
+ * @description Ejecuta power_open() sobre el árbol tests/power/rapl y
+ *              comprueba nombre, dominio y max_energy_range_uj de cada zona:
+ *              - intel-rapl:0 y sus subzonas core y dram (con el prefijo
+ *                de la zona padre)
+ *              - intel-rapl-mmio:0, duplicado de la zona MSR, se ignora
+ *              - amd_energy (hwmon): Esocket0 y Ecore000, sin vuelta a cero
+ *              Después sustituye los contadores por archivos en memoria y
+ *              comprueba power_sample():
+ *              - la vuelta a cero en max_energy_range_uj
+ *              - un contador sin max_range que retrocede da 0 W
+ *              - una lectura fallida conserva la lectura y el instante
+ *                anteriores de esa zona, sin afectar a las demás
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage test_power <directorio tests/power/rapl>
+ */
+
+#define _GNU_SOURCE     // Para memfd_create()
+
+#include <stdio.h>      // Para printf(), fprintf(), snprintf()
+#include <string.h>     // Para strcmp()
+#include <unistd.h>     // Para pwrite(), ftruncate(), close()
+#include <sys/mman.h>   // Para memfd_create()
+#include "power.h"      // Para power_open() y power_sample()
+
+// Vuelta a cero de las zonas RAPL del árbol (max_energy_range_uj)
+#define RAPL_RANGE 262143328850ull
+
+/**
+ * @brief Zona esperada en el árbol
+ */
+typedef struct {
+    const char *name;
+    power_kind kind;
+    uint64_t max_range_uj;
+} expect_zone;
+
+static const expect_zone zones[] = {
+    {"package-0", POWER_PACKAGE, RAPL_RANGE},
+    {"package-0/core", POWER_CORE, RAPL_RANGE},
+    {"package-0/dram", POWER_OTHER, 65712999613ull},
+    {"Esocket0", POWER_PACKAGE, 0},
+    {"Ecore000", POWER_CORE, 0},
+};
+
+#define NZONES ((int)(sizeof(zones) / sizeof(zones[0])))
+
+/**
+ * @brief Busca una zona por nombre
+ * @return int Índice en el conjunto, -1 si no existe
+ */
+static int find_zone(const power_set *p, const char *name) {
+    for (int i = 0; i < p->count; i++) {
+        if (strcmp(p->z[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Fija el valor del contador en memoria de una zona (NULL = vacío)
+ */
+static void set_counter(const power_zone *z, const char *text) {
+    if (ftruncate(z->fd, 0) < 0) {
+        return;
+    }
+    if (text) {
+        pwrite(z->fd, text, strlen(text), 0);
+    }
+}
+
+/**
+ * @brief Compara una potencia con la esperada (tolerancia de 1 mW)
+ * @return int 1 si no coincide
+ */
+static int check_watts(const char *what, double got, double want) {
+    if (got < want - 1e-3 || got > want + 1e-3) {
+        fprintf(stderr, "%s: %.3f W, se esperaban %.3f W\n", what, got, want);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Comprueba el descubrimiento de zonas
+ * @return int Número de fallos
+ */
+static int check_discovery(const power_set *p) {
+    int failed = 0;
+
+    if (p->count != NZONES) {
+        fprintf(stderr, "%d zonas, se esperaban %d\n", p->count, NZONES);
+        failed++;
+    }
+    for (int k = 0; k < NZONES; k++) {
+        int i = find_zone(p, zones[k].name);
+        if (i < 0) {
+            fprintf(stderr, "falta la zona %s\n", zones[k].name);
+            failed++;
+        } else if (p->z[i].kind != zones[k].kind || p->z[i].max_range_uj != zones[k].max_range_uj) {
+            fprintf(stderr, "%s: dominio %d rango %llu, se esperaba dominio %d rango %llu\n",
+                    zones[k].name, p->z[i].kind, (unsigned long long)p->z[i].max_range_uj,
+                    zones[k].kind, (unsigned long long)zones[k].max_range_uj);
+            failed++;
+        }
+    }
+    printf("%-14s %s\n", "discovery", failed ? "FALLO" : "ok");
+    return failed;
+}
+
+/**
+ * @brief Comprueba power_sample() con contadores controlados
+ * @return int Número de fallos
+ */
+static int check_sample(power_set *p) {
+    int pkg = find_zone(p, "package-0");
+    int core = find_zone(p, "package-0/core");
+    int sock = find_zone(p, "Esocket0");
+    int failed = 0;
+    char text[32];
+
+    if (pkg < 0 || core < 0 || sock < 0) {
+        return 1;
+    }
+    for (int i = 0; i < p->count; i++) {
+        close(p->z[i].fd);
+        p->z[i].fd = memfd_create("energy_uj", 0);
+        set_counter(&p->z[i], "0\n");
+    }
+
+    // t = 1 s: el paquete está a 1 J de la vuelta a cero
+    snprintf(text, sizeof(text), "%llu\n", RAPL_RANGE - 1000000ull);
+    set_counter(&p->z[pkg], text);
+    set_counter(&p->z[core], "5000000\n");
+    set_counter(&p->z[sock], "9000000\n");
+    power_sample(p, 1000000000ull, NULL);
+
+    // t = 2 s: el paquete vuelve a cero y suma 2 J en total; el socket de
+    // amd_energy retrocede (sin max_range); la lectura de core falla
+    set_counter(&p->z[pkg], "1000000\n");
+    set_counter(&p->z[core], NULL);
+    set_counter(&p->z[sock], "8000000\n");
+    power_sample(p, 2000000000ull, NULL);
+    failed += check_watts("vuelta a cero", p->z[pkg].watts, 2.0);
+    failed += check_watts("retroceso sin max_range", p->z[sock].watts, 0.0);
+    failed += check_watts("lectura fallida", p->z[core].watts, 0.0);
+    failed += check_watts("suma de paquetes", p->package_w, 2.0);
+
+    // t = 4 s: core suma 6 J desde su última lectura válida (t = 1 s)
+    set_counter(&p->z[pkg], "4000000\n");
+    set_counter(&p->z[core], "11000000\n");
+    power_sample(p, 4000000000ull, NULL);
+    failed += check_watts("paquete tras la vuelta", p->z[pkg].watts, 1.5);
+    failed += check_watts("intervalo por zona", p->z[core].watts, 2.0);
+    failed += check_watts("suma de núcleos", p->core_w, 2.0);
+
+    printf("%-14s %s\n", "sample", failed ? "FALLO" : "ok");
+    return failed;
+}
+
+int main(int argc, char *argv[]) {
+    static power_set p;
+    int failed = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "Uso: %s <directorio tests/power/rapl>\n", argv[0]);
+        return 2;
+    }
+    power_open(&p, argv[1]);
+    failed += check_discovery(&p);
+    failed += check_sample(&p);
+    power_close(&p);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @brief Prueba de la tabla de procesos sobre árboles /proc falsos
+ * @description Escanea tests/proc/t0 y después tests/proc/t1 (el mismo
+ *              sistema un intervalo más tarde) y comprueba el ranking de
+ *              proc_table_top(), una vez leyendo schedstat y otra solo stat:
+ *              - comm con espacios y ')' ("my proc) x") y comm de más de
+ *                15 caracteres, que se trunca como en el kernel
+ *              - un proceso nuevo en t1 cuenta todo su tiempo de CPU
+ *              - un proceso que terminó (300) sale de la tabla
+ *              El tiempo de CPU de los árboles es el mismo en schedstat (ns)
+ *              y en utime + stime de stat (ticks de 10 ms).
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage test_proc_top <directorio tests/proc>
+ */
+
+#include <stdio.h>      // Para printf(), fprintf(), snprintf()
+#include <string.h>     // Para strcmp()
+#include <unistd.h>     // Para close(), dup()
+#include <fcntl.h>      // Para open() y constantes O_*
+#include <limits.h>     // Para PATH_MAX
+#include "proc_top.h"   // Para proc_table_scan() y proc_table_top()
+
+/**
+ * @brief Proceso esperado en el ranking
+ */
+typedef struct {
+    int pid;
+    const char *comm;
+} expect_proc;
+
+static const expect_proc ranking[] = {
+    {200, "worker"},
+    {400, "newbie"},
+    {100, "my proc) x"},
+    {1, "systemd-journal"},
+};
+
+#define NRANK ((int)(sizeof(ranking) / sizeof(ranking[0])))
+
+/**
+ * @brief Cambia el directorio de procesos de la tabla a @p dir
+ * @return int 0 si éxito, -1 si no se pudo abrir
+ */
+static int switch_root(proc_table *t, const char *dir) {
+    closedir(t->dir);
+    close(t->proc_fd);
+    t->proc_fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    t->dir = t->proc_fd >= 0 ? fdopendir(dup(t->proc_fd)) : NULL;
+    return t->dir ? 0 : -1;
+}
+
+/**
+ * @brief Escanea t0 y t1 y comprueba el ranking
+ * @return int Número de fallos
+ */
+static int check_mode(const char *base, int use_schedstat) {
+    const char *mode = use_schedstat ? "schedstat" : "stat";
+    char dir[PATH_MAX];
+    proc_table t;
+    proc_usage top[PROC_TOP_MAX];
+    int failed = 0;
+
+    snprintf(dir, sizeof(dir), "%s/t0", base);
+    if (proc_table_init(&t, dir) < 0) {
+        fprintf(stderr, "%s: proc_table_init() falló\n", dir);
+        return 1;
+    }
+    t.use_schedstat = use_schedstat;
+    t.clk_tck = 100;
+
+    int alive0 = proc_table_scan(&t);
+    snprintf(dir, sizeof(dir), "%s/t1", base);
+    if (switch_root(&t, dir) < 0) {
+        fprintf(stderr, "%s: no se pudo abrir\n", dir);
+        proc_table_free(&t);
+        return 1;
+    }
+    int alive1 = proc_table_scan(&t);
+    if (alive0 != 4 || alive1 != 4 || t.used != 4) {
+        fprintf(stderr, "%s: %d y %d procesos vivos, %zu en la tabla; se esperaban 4\n",
+                mode, alive0, alive1, t.used);
+        failed++;
+    }
+
+    int n = proc_table_top(&t, top, PROC_TOP_MAX);
+    if (n != NRANK) {
+        fprintf(stderr, "%s: %d procesos en el ranking, se esperaban %d\n", mode, n, NRANK);
+        failed++;
+    }
+    for (int k = 0; k < n && k < NRANK; k++) {
+        if (top[k].pid != ranking[k].pid || strcmp(top[k].comm, ranking[k].comm) != 0) {
+            fprintf(stderr, "%s: puesto %d es %s(%d), se esperaba %s(%d)\n", mode, k + 1,
+                    top[k].comm, top[k].pid, ranking[k].comm, ranking[k].pid);
+            failed++;
+        }
+    }
+
+    proc_table_free(&t);
+    printf("%-14s %s\n", mode, failed ? "FALLO" : "ok");
+    return failed;
+}
+
+int main(int argc, char *argv[]) {
+    int failed = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "Uso: %s <directorio tests/proc>\n", argv[0]);
+        return 2;
+    }
+    failed += check_mode(argv[1], 1);
+    failed += check_mode(argv[1], 0);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @brief Prueba del parser de Pressure Stall Information
+ * @description Ejecuta psi_sample() sobre dos lecturas consecutivas de
+ *              tests/psi (t0 y t1, cada una con pressure/cpu, memory e io)
+ *              y comprueba avg10 (en centésimas) y los deltas de los totales:
+ *              - cpu:     t0 sin línea "full" (kernels anteriores a 5.13)
+ *              - memory:  avg10 con dos decimales y deltas de ambas líneas
+ *              - io:      avg10 de 100.00 y totales que retroceden (delta 0)
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage test_psi <directorio tests/psi>
+ */
+
+#include <stdio.h>      // Para printf(), fprintf(), snprintf()
+#include <unistd.h>     // Para close()
+#include <fcntl.h>      // Para open() y constantes O_*
+#include <limits.h>     // Para PATH_MAX
+#include "psi.h"        // Para psi_open() y psi_sample()
+
+/**
+ * @brief Estado esperado de un recurso tras la segunda lectura
+ */
+typedef struct {
+    uint32_t some_avg10;
+    uint32_t full_avg10;
+    uint64_t d_some_us;
+    uint64_t d_full_us;
+} expect_psi;
+
+static const expect_psi expected[PSI_RESOURCES] = {
+    [PSI_CPU] = {1250, 0, 100000, 0},
+    [PSI_MEMORY] = {4567, 9999, 2000000, 1500000},
+    [PSI_IO] = {10000, 10000, 0, 0},
+};
+
+/**
+ * @brief Sustituye los descriptores por los archivos de otra lectura
+ * @return int 0 si éxito, -1 si falta algún archivo
+ */
+static int reopen(psi_set *p, const char *dir) {
+    char path[PATH_MAX];
+
+    for (int i = 0; i < PSI_RESOURCES; i++) {
+        close(p->r[i].fd);
+        snprintf(path, sizeof(path), "%s/pressure/%s", dir, psi_resource_name((psi_resource)i));
+        p->r[i].fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (p->r[i].fd < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    char dir[PATH_MAX];
+    static psi_set p;
+    int failed = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "Uso: %s <directorio tests/psi>\n", argv[0]);
+        return 2;
+    }
+
+    snprintf(dir, sizeof(dir), "%s/t0", argv[1]);
+    if (psi_open(&p, dir) != PSI_RESOURCES || psi_sample(&p, NULL) < 0) {
+        fprintf(stderr, "%s: no se pudieron leer los tres recursos\n", dir);
+        return 1;
+    }
+    if (p.r[PSI_CPU].some_avg10 != 304 || p.r[PSI_CPU].d_some_us != 0) {
+        fprintf(stderr, "t0 cpu: avg10 %u delta %llu, se esperaba 304 y 0\n",
+                p.r[PSI_CPU].some_avg10, (unsigned long long)p.r[PSI_CPU].d_some_us);
+        failed++;
+    }
+
+    snprintf(dir, sizeof(dir), "%s/t1", argv[1]);
+    if (reopen(&p, dir) < 0 || psi_sample(&p, NULL) < 0) {
+        fprintf(stderr, "%s: no se pudieron leer los tres recursos\n", dir);
+        return 1;
+    }
+    for (int i = 0; i < PSI_RESOURCES; i++) {
+        const psi_state *s = &p.r[i];
+        const expect_psi *e = &expected[i];
+        int bad = s->some_avg10 != e->some_avg10 || s->full_avg10 != e->full_avg10 ||
+                  s->d_some_us != e->d_some_us || s->d_full_us != e->d_full_us;
+        if (bad) {
+            fprintf(stderr, "%s: some %u/%llu full %u/%llu, se esperaba some %u/%llu full %u/%llu\n",
+                    psi_resource_name((psi_resource)i),
+                    s->some_avg10, (unsigned long long)s->d_some_us,
+                    s->full_avg10, (unsigned long long)s->d_full_us,
+                    e->some_avg10, (unsigned long long)e->d_some_us,
+                    e->full_avg10, (unsigned long long)e->d_full_us);
+        }
+        printf("%-14s %s\n", psi_resource_name((psi_resource)i), bad ? "FALLO" : "ok");
+        failed += bad;
+    }
+
+    psi_close(&p);
+    return failed ? 1 : 0;
+}
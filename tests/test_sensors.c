@@ -0,0 +1,135 @@
+/**
+ * @brief Prueba del descubrimiento de sensores sobre árboles hwmon falsos
+ * @description Ejecuta sensors_discover() sobre cada árbol de tests/hwmon y
+ *              comprueba el rol y el índice de cada canal y el canal
+ *              elegido como primario:
+ *              - k10temp-tctl:  Zen 2 y posteriores, solo Tctl
+ *              - k10temp-tdie:  Zen 1 / Zen+, Tctl con offset, Tdie y CCDs
+ *              - zenpower:      mismas etiquetas que k10temp en otro orden
+ *              - coretemp:      dos paquetes con "Package id N" y "Core N"
+ *              - acpitz:        zonas sin etiqueta junto a un driver sin perfil
+ *              Los canales se buscan por driver y etiqueta: el orden de
+ *              readdir() no está definido.
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage test_sensors <directorio tests/hwmon>
+ */
+
+#include <stdio.h>          // Para printf(), fprintf(), snprintf()
+#include <string.h>         // Para strcmp()
+#include "temp_monitor.h"   // Para sensors_discover() y sensor_table
+
+/**
+ * @brief Canal esperado en un árbol
+ */
+typedef struct {
+    const char *driver;
+    const char *label;
+    sensor_role role;
+    int index;
+} expect_channel;
+
+/**
+ * @brief Árbol de prueba y resultado esperado
+ */
+typedef struct {
+    const char *tree;               // Subdirectorio de tests/hwmon
+    const char *primary_driver;     // Canal primario esperado
+    const char *primary_label;
+    int count;                      // Canales esperados
+    expect_channel ch[8];
+} expect_tree;
+
+static const expect_tree trees[] = {
+    {"k10temp-tctl", "k10temp", "Tctl", 1, {
+        {"k10temp", "Tctl", SENSOR_ROLE_CONTROL, 0},
+    }},
+    {"k10temp-tdie", "k10temp", "Tdie", 4, {
+        {"k10temp", "Tctl", SENSOR_ROLE_CONTROL, 0},
+        {"k10temp", "Tdie", SENSOR_ROLE_DIE, 0},
+        {"k10temp", "Tccd1", SENSOR_ROLE_CCD, 1},
+        {"k10temp", "Tccd2", SENSOR_ROLE_CCD, 2},
+    }},
+    {"zenpower", "zenpower", "Tdie", 4, {
+        {"zenpower", "Tdie", SENSOR_ROLE_DIE, 0},
+        {"zenpower", "Tctl", SENSOR_ROLE_CONTROL, 0},
+        {"zenpower", "Tccd1", SENSOR_ROLE_CCD, 1},
+        {"zenpower", "Tccd2", SENSOR_ROLE_CCD, 2},
+    }},
+    {"coretemp", "coretemp", "Package id 0", 5, {
+        {"coretemp", "Package id 0", SENSOR_ROLE_PACKAGE, 0},
+        {"coretemp", "Package id 1", SENSOR_ROLE_PACKAGE, 1},
+        {"coretemp", "Core 4", SENSOR_ROLE_CORE, 4},
+    }},
+    {"acpitz", "acpitz", "temp1", 3, {
+        {"acpitz", "temp1", SENSOR_ROLE_ZONE, 1},
+        {"acpitz", "temp2", SENSOR_ROLE_ZONE, 2},
+        {"nvme", "Composite", SENSOR_ROLE_OTHER, 0},
+    }},
+};
+
+/**
+ * @brief Busca un canal por driver y etiqueta
+ * @return int Índice en la tabla, -1 si no existe
+ */
+static int find_channel(const sensor_table *t, const char *driver, const char *label) {
+    for (int i = 0; i < t->count; i++) {
+        if (strcmp(t->ch[i].driver, driver) == 0 && strcmp(t->ch[i].label, label) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Comprueba un árbol
+ * @return int Número de fallos
+ */
+static int check_tree(const char *base, const expect_tree *e) {
+    char root[SENSOR_PATH_LEN];
+    static sensor_table t;
+    int failed = 0;
+
+    snprintf(root, sizeof(root), "%s/%s", base, e->tree);
+    int n = sensors_discover(&t, root);
+    if (n != e->count) {
+        fprintf(stderr, "%s: %d canales, se esperaban %d\n", e->tree, n, e->count);
+        return 1;
+    }
+
+    for (int k = 0; k < 8 && e->ch[k].driver; k++) {
+        const expect_channel *x = &e->ch[k];
+        int i = find_channel(&t, x->driver, x->label);
+        if (i < 0) {
+            fprintf(stderr, "%s: falta %s/%s\n", e->tree, x->driver, x->label);
+            failed++;
+        } else if (t.ch[i].role != (int)x->role || t.ch[i].index != x->index) {
+            fprintf(stderr, "%s: %s/%s rol %d índice %d, se esperaba rol %d índice %d\n",
+                    e->tree, x->driver, x->label, t.ch[i].role, t.ch[i].index, x->role, x->index);
+            failed++;
+        }
+    }
+
+    int want = find_channel(&t, e->primary_driver, e->primary_label);
+    if (want < 0 || t.primary != want) {
+        fprintf(stderr, "%s: primario %s, se esperaba %s\n", e->tree,
+                t.primary >= 0 ? t.ch[t.primary].label : "(ninguno)", e->primary_label);
+        failed++;
+    }
+
+    printf("%-14s %s\n", e->tree, failed ? "FALLO" : "ok");
+    return failed;
+}
+
+int main(int argc, char *argv[]) {
+    int failed = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "Uso: %s <directorio tests/hwmon>\n", argv[0]);
+        return 2;
+    }
+    for (size_t i = 0; i < sizeof(trees) / sizeof(trees[0]); i++) {
+        failed += check_tree(argv[1], &trees[i]);
+    }
+    return failed ? 1 : 0;
+}
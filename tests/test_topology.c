@@ -0,0 +1,151 @@
+/**
+ * @brief Prueba del mapa de topología sobre árboles sysfs falsos
+ * @description Ejecuta sensors_discover() y topology_build() sobre cada
+ *              árbol de tests/topology y comprueba el número de unidades por
+ *              nivel y el canal de temperatura asignado a cada CPU:
+ *              - zen2:         un paquete, 4 núcleos con SMT (cpuN y cpuN+4)
+ *                              y un dominio de L3 por núcleo; Tccd1 cubre
+ *                              los dos primeros dominios y Tccd2 el resto
+ *              - coretemp-2s:  dos paquetes (coretemp.0 y coretemp.1) en dos
+ *                              nodos, cada uno con "Core 0" y "Core 1"
+ *              En zen2 comprueba además con topology_update() que los
+ *              contadores de throttling, que sysfs repite en cada hilo,
+ *              se cuentan una vez por núcleo y una vez por paquete.
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage test_topology <directorio tests/topology>
+ */
+
+#include <stdio.h>          // Para printf(), fprintf(), snprintf()
+#include <string.h>         // Para strcmp(), strstr()
+#include "topology.h"       // Para topology_build() y topology_update()
+
+// CPUs máximas de un árbol de prueba
+#define TEST_MAX_CPUS 8
+
+/**
+ * @brief Árbol de prueba y resultado esperado
+ */
+typedef struct {
+    const char *tree;                   // Subdirectorio de tests/topology
+    int ncpu;                           // CPUs del árbol
+    int units[TOPO_LEVELS];             // Unidades esperadas por nivel
+    const char *hwmon[TEST_MAX_CPUS];   // Dispositivo del canal de cada CPU
+    const char *label[TEST_MAX_CPUS];   // Etiqueta del canal de cada CPU
+} expect_tree;
+
+static const expect_tree trees[] = {
+    {"zen2", 8, {4, 4, 1, 1},
+     {"hwmon0", "hwmon0", "hwmon0", "hwmon0", "hwmon0", "hwmon0", "hwmon0", "hwmon0"},
+     {"Tccd1", "Tccd1", "Tccd2", "Tccd2", "Tccd1", "Tccd1", "Tccd2", "Tccd2"}},
+    {"coretemp-2s", 4, {4, 2, 2, 2},
+     {"hwmon1", "hwmon1", "hwmon2", "hwmon2"},
+     {"Core 0", "Core 1", "Core 0", "Core 1"}},
+};
+
+/**
+ * @brief Comprueba el canal asignado a una CPU
+ * @return int 1 si no es el esperado
+ */
+static int check_cpu(const expect_tree *e, const topology *t, const sensor_table *s, int cpu) {
+    char dev[16];
+    int ch = t->cpu_chan[cpu];
+
+    snprintf(dev, sizeof(dev), "/%s/", e->hwmon[cpu]);
+    if (ch >= 0 && strcmp(s->ch[ch].label, e->label[cpu]) == 0 && strstr(s->ch[ch].path, dev)) {
+        return 0;
+    }
+    fprintf(stderr, "%s: cpu%d usa %s, se esperaba %s%s\n", e->tree, cpu,
+            ch >= 0 ? s->ch[ch].path : "(primario)", e->hwmon[cpu], e->label[cpu]);
+    return 1;
+}
+
+/**
+ * @brief Comprueba el recuento de throttling del árbol zen2
+ * @description sysfs repite core_throttle_count en los dos hilos de cada
+ *              núcleo y package_throttle_count en todas las CPUs.
+ *
+ * @return int Número de fallos
+ */
+static int check_throttle(topology *t) {
+    uint16_t util[TEST_MAX_CPUS] = {0}, freq[TEST_MAX_CPUS] = {0};
+    uint32_t core_thr[TEST_MAX_CPUS] = {1, 2, 3, 4, 1, 2, 3, 4};
+    uint32_t pkg_thr[TEST_MAX_CPUS] = {7, 7, 7, 7, 7, 7, 7, 7};
+    cpu_counters c;
+    int failed = 0;
+
+    memset(&c, 0, sizeof(c));
+    c.ncpu = TEST_MAX_CPUS;
+    c.util_pm = util;
+    c.freq_mhz = freq;
+    c.d_core_thr = core_thr;
+    c.d_pkg_thr = pkg_thr;
+    topology_update(t, 50.0f, &c);
+
+    const topo_agg *co = &t->level[TOPO_CORE];
+    for (int cpu = 0; cpu < 4; cpu++) {
+        if (co->throttle[co->unit[cpu]] != core_thr[cpu]) {
+            fprintf(stderr, "zen2: núcleo de cpu%d con %u eventos, se esperaban %u\n",
+                    cpu, co->throttle[co->unit[cpu]], core_thr[cpu]);
+            failed++;
+        }
+    }
+    // 1 + 2 + 3 + 4 de núcleo más 7 de paquete
+    for (int l = TOPO_PACKAGE; l <= TOPO_NODE; l++) {
+        if (t->level[l].throttle[0] != 17) {
+            fprintf(stderr, "zen2: %s con %u eventos, se esperaban 17\n",
+                    topology_level_name((topo_level)l), t->level[l].throttle[0]);
+            failed++;
+        }
+    }
+    return failed;
+}
+
+/**
+ * @brief Comprueba un árbol
+ * @return int Número de fallos
+ */
+static int check_tree(const char *base, const expect_tree *e) {
+    char root[SENSOR_PATH_LEN];
+    static sensor_table s;
+    topology t;
+    int failed = 0;
+
+    snprintf(root, sizeof(root), "%s/%s", base, e->tree);
+    sensors_discover(&s, root);
+    if (topology_build(&t, root, e->ncpu, &s) < 0) {
+        fprintf(stderr, "%s: topology_build() falló\n", e->tree);
+        return 1;
+    }
+
+    for (int l = 0; l < TOPO_LEVELS; l++) {
+        if (t.level[l].count != e->units[l]) {
+            fprintf(stderr, "%s: %d unidades %s, se esperaban %d\n", e->tree,
+                    t.level[l].count, topology_level_name((topo_level)l), e->units[l]);
+            failed++;
+        }
+    }
+    for (int cpu = 0; cpu < e->ncpu; cpu++) {
+        failed += check_cpu(e, &t, &s, cpu);
+    }
+    if (strcmp(e->tree, "zen2") == 0) {
+        failed += check_throttle(&t);
+    }
+    topology_free(&t);
+
+    printf("%-14s %s\n", e->tree, failed ? "FALLO" : "ok");
+    return failed;
+}
+
+int main(int argc, char *argv[]) {
+    int failed = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "Uso: %s <directorio tests/topology>\n", argv[0]);
+        return 2;
+    }
+    for (size_t i = 0; i < sizeof(trees) / sizeof(trees[0]); i++) {
+        failed += check_tree(argv[1], &trees[i]);
+    }
+    return failed ? 1 : 0;
+}
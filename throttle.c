@@ -0,0 +1,184 @@
+/**
+ * @brief Detector de episodios de throttling térmico
+ * @description Implementa la máquina de estados por núcleo (inactivo /
+ *              episodio abierto) y la agregación incremental de los
+ *              resúmenes por hora.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdlib.h>     // Para calloc(), free()
+#include <string.h>     // Para memset()
+#include "throttle.h"   // Header con declaraciones del módulo
+
+/**
+ * @brief Reinicia un resumen por hora
+ */
+static void hour_reset(throttle_hour *h, int64_t hour) {
+    memset(h, 0, sizeof(*h));
+    h->hour = hour;
+    h->worst_cpu = -1;
+}
+
+/**
+ * @brief Reserva el estado para @p ncpu núcleos
+ */
+int throttle_init(throttle_detector *d, int ncpu) {
+    memset(d, 0, sizeof(*d));
+    if (ncpu <= 0) {
+        return -1;
+    }
+
+    d->core = calloc((size_t)ncpu, sizeof(throttle_core));
+    d->hour_core_s = calloc((size_t)ncpu, sizeof(double));
+    d->closed = calloc((size_t)ncpu, sizeof(throttle_episode));
+    if (!d->core || !d->hour_core_s || !d->closed) {
+        throttle_free(d);
+        return -1;
+    }
+    d->ncpu = ncpu;
+    for (int i = 0; i < THROTTLE_HOURS; i++) {
+        hour_reset(&d->hours[i], 0);
+    }
+    return 0;
+}
+
+/**
+ * @brief Avanza el anillo de resúmenes si empezó una hora nueva
+ */
+const throttle_hour *throttle_roll(throttle_detector *d, time_t now) {
+    int64_t hour = (int64_t)now - (int64_t)now % 3600;
+    throttle_hour *h = &d->hours[d->cur];
+
+    if (d->ncpu == 0 || h->hour == hour) {
+        return NULL;
+    }
+    if (h->hour == 0) {
+        // Primera muestra desde el arranque
+        h->hour = hour;
+        return NULL;
+    }
+
+    d->cur = (d->cur + 1) % THROTTLE_HOURS;
+    hour_reset(&d->hours[d->cur], hour);
+    memset(d->hour_core_s, 0, sizeof(double) * (size_t)d->ncpu);
+
+    return h->episodes > 0 || h->core_s > 0.0 ? h : NULL;
+}
+
+/**
+ * @brief Banda de carga del sistema: utilización media de todas las CPUs
+ */
+static int load_band(const cpu_counters *c) {
+    uint32_t sum = 0;
+
+    for (int cpu = 0; cpu < c->ncpu; cpu++) {
+        sum += c->util_pm[cpu];
+    }
+    uint32_t avg = c->ncpu > 0 ? sum / (uint32_t)c->ncpu : 0;
+    int band = (int)(avg * THROTTLE_LOAD_BANDS / 1001);
+    return band < THROTTLE_LOAD_BANDS ? band : THROTTLE_LOAD_BANDS - 1;
+}
+
+/**
+ * @brief Procesa los contadores de un ciclo
+ */
+int throttle_update(throttle_detector *d, uint64_t ts_ns, float temp, float threshold,
+                    const cpu_counters *c) {
+    throttle_hour *h = &d->hours[d->cur];
+    int n = 0;
+
+    if (d->ncpu == 0) {
+        return 0;
+    }
+
+    // El intervalo que precede a la muestra es el que se atribuye
+    uint64_t dt_ns = d->last_ns && ts_ns > d->last_ns ? ts_ns - d->last_ns : 0;
+    double dt_s = dt_ns / 1e9;
+    int32_t milli = (int32_t)(temp * 1000.0f);
+    int hot = temp >= threshold;
+    int band = load_band(c);
+    d->last_ns = ts_ns;
+
+    for (int cpu = 0; cpu < d->ncpu && cpu < c->ncpu; cpu++) {
+        throttle_core *k = &d->core[cpu];
+        uint16_t freq = c->freq_mhz[cpu];
+        uint16_t util = c->util_pm[cpu];
+        uint16_t ref = k->ref_mhz[band];
+        int busy = util >= THROTTLE_BUSY_PM;
+
+        int counted = c->d_core_thr[cpu] || c->d_pkg_thr[cpu];
+        int dropped = hot && busy && ref && freq &&
+                      (uint32_t)freq * 100 < (uint32_t)ref * (100 - THROTTLE_FREQ_DROP_PCT);
+
+        if (!counted && !dropped) {
+            // Solo en frío y ocupado: la referencia es la frecuencia sin
+            // limitar para esta carga
+            if (!hot && busy && freq > ref) {
+                k->ref_mhz[band] = freq;
+            }
+            // Cerrar el episodio tras varias muestras tranquilas seguidas
+            if (k->active && ++k->quiet >= THROTTLE_CLOSE_SAMPLES) {
+                d->closed[n++] = k->ep;
+                k->active = 0;
+            }
+            continue;
+        }
+
+        if (!k->active) {
+            k->active = 1;
+            memset(&k->ep, 0, sizeof(k->ep));
+            k->ep.cpu = cpu;
+            k->ep.start_ns = ts_ns - dt_ns;
+            k->ep.peak_milli = milli;
+            d->episodes++;
+            h->episodes++;
+        }
+        k->quiet = 0;
+        k->ep.end_ns = ts_ns;
+        if (milli > k->ep.peak_milli) {
+            k->ep.peak_milli = milli;
+        }
+
+        // Ciclos perdidos: diferencia con la frecuencia de referencia
+        // durante el tiempo en que el núcleo estuvo ocupado
+        double lost = 0.0;
+        if (freq && ref > freq) {
+            lost = (ref - freq) * 1e6 * dt_s * util / 1000.0;
+        }
+        k->ep.lost_cycles += (uint64_t)lost;
+
+        h->core_s += dt_s;
+        h->lost_gcycles += lost / 1e9;
+        if (h->peak_milli < milli) {
+            h->peak_milli = milli;
+        }
+        d->hour_core_s[cpu] += dt_s;
+        if (d->hour_core_s[cpu] > h->worst_core_s) {
+            h->worst_core_s = d->hour_core_s[cpu];
+            h->worst_cpu = cpu;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Número de núcleos con un episodio abierto
+ */
+int throttle_open_count(const throttle_detector *d) {
+    int n = 0;
+
+    for (int i = 0; i < d->ncpu; i++) {
+        n += d->core[i].active;
+    }
+    return n;
+}
+
+/**
+ * @brief Libera el estado del detector
+ */
+void throttle_free(throttle_detector *d) {
+    free(d->core);
+    free(d->hour_core_s);
+    free(d->closed);
+    memset(d, 0, sizeof(*d));
+}
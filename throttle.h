@@ -0,0 +1,140 @@
+/**
+ * @brief Header del detector de episodios de throttling térmico
+ * @description Define un detector que, a partir de los contadores por CPU
+ *              de cada ciclo (eventos de thermal_throttle y frecuencia de
+ *              cpufreq) y de la temperatura, abre y cierra "episodios de
+ *              throttling" por núcleo. Cada episodio acumula su duración, su
+ *              temperatura máxima y una estimación de los ciclos perdidos.
+ *              Los mismos valores se agregan en resúmenes por hora con un
+ *              coste constante por muestra, suficientes para ordenar hosts
+ *              por el coste del throttling.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef THROTTLE_H  // Si THROTTLE_H no está definido
+#define THROTTLE_H  // Definir THROTTLE_H como macro de protección
+
+#include <stdint.h>        // Para tipos de ancho fijo
+#include <time.h>          // Para time_t
+#include "cpu_counters.h"  // Para cpu_counters
+
+// Resúmenes por hora conservados (el actual incluido)
+#define THROTTLE_HOURS 24
+
+// Muestras consecutivas sin throttling que cierran un episodio
+#define THROTTLE_CLOSE_SAMPLES 2
+
+// Utilización mínima (por mil) para considerar ocupado un núcleo
+#define THROTTLE_BUSY_PM 500
+
+// Caída de frecuencia (%) que cuenta como throttling sin eventos de contador
+#define THROTTLE_FREQ_DROP_PCT 10
+
+// Bandas de carga del sistema (utilización media de todas las CPUs) con su
+// propia frecuencia de referencia
+#define THROTTLE_LOAD_BANDS 4
+
+/**
+ * @brief Episodio de throttling de un núcleo
+ */
+typedef struct {
+    int cpu;               // Núcleo
+    uint64_t start_ns;     // Primera muestra limitada (CLOCK_MONOTONIC)
+    uint64_t end_ns;       // Última muestra limitada
+    int32_t peak_milli;    // Temperatura máxima durante el episodio
+    uint64_t lost_cycles;  // Ciclos perdidos estimados
+} throttle_episode;
+
+/**
+ * @brief Estado del detector para un núcleo
+ */
+typedef struct {
+    int active;              // 1 si hay un episodio abierto
+    unsigned quiet;          // Muestras seguidas sin throttling dentro del episodio
+    uint16_t ref_mhz[THROTTLE_LOAD_BANDS]; // Frecuencia máxima observada ocupado, por
+                                           // debajo del umbral, por banda de carga
+    throttle_episode ep;     // Episodio abierto
+} throttle_core;
+
+/**
+ * @brief Resumen de throttling de una hora
+ */
+typedef struct {
+    int64_t hour;            // Inicio de la hora (tiempo Unix, 0 = vacía)
+    uint32_t episodes;       // Episodios abiertos durante la hora
+    double core_s;           // Segundos-núcleo limitados
+    double lost_gcycles;     // Ciclos perdidos estimados (miles de millones)
+    int32_t peak_milli;      // Temperatura máxima durante el throttling
+    int worst_cpu;           // Núcleo con más segundos limitados (-1 = ninguno)
+    double worst_core_s;     // Segundos limitados de ese núcleo
+} throttle_hour;
+
+/**
+ * @brief Detector de episodios de throttling
+ */
+typedef struct {
+    int ncpu;                            // Núcleos (0 = desactivado)
+    throttle_core *core;                 // Estado por núcleo
+    double *hour_core_s;                 // Segundos limitados por núcleo en la hora actual
+    throttle_episode *closed;            // Episodios cerrados en el último ciclo
+    throttle_hour hours[THROTTLE_HOURS]; // Anillo de resúmenes por hora
+    unsigned cur;                        // Hora actual en el anillo
+    uint64_t episodes;                   // Episodios abiertos desde el arranque
+    uint64_t last_ns;                    // Marca de tiempo de la muestra anterior
+} throttle_detector;
+
+/**
+ * @brief Reserva el estado para @p ncpu núcleos
+ * @return int 0 si éxito, -1 si no hay memoria
+ */
+int throttle_init(throttle_detector *d, int ncpu);
+
+/**
+ * @brief Avanza el anillo de resúmenes si empezó una hora nueva
+ * @description Se llama antes de throttle_update() en cada ciclo.
+ *
+ * @return const throttle_hour* La hora que acaba de terminar (para
+ *         registrarla), o NULL si la hora no cambió o estaba vacía
+ */
+const throttle_hour *throttle_roll(throttle_detector *d, time_t now);
+
+/**
+ * @brief Procesa los contadores de un ciclo
+ * @description Una muestra de un núcleo está limitada si sus contadores de
+ *              throttling de núcleo o de paquete avanzaron, o si la
+ *              temperatura supera el umbral con el núcleo ocupado y su
+ *              frecuencia THROTTLE_FREQ_DROP_PCT por debajo de la de
+ *              referencia (CPUs sin thermal_throttle, como las de AMD).
+ *              La referencia es la frecuencia máxima del núcleo ocupado con
+ *              la temperatura por debajo del umbral y con una carga del
+ *              sistema parecida (misma banda de THROTTLE_LOAD_BANDS). Con
+ *              una sola referencia global, el boost de un solo núcleo con
+ *              el sistema en reposo haría pasar por throttling cualquier
+ *              carga de todos los núcleos por encima del umbral. Sin una
+ *              referencia en la banda actual (una carga que nunca se vio en
+ *              frío) solo cuentan los contadores.
+ *
+ * @param d         Detector
+ * @param ts_ns     Marca de tiempo de la muestra (CLOCK_MONOTONIC)
+ * @param temp      Temperatura de la muestra en °C
+ * @param threshold Umbral de temperatura configurado
+ * @param c         Contadores del ciclo
+ *
+ * @return int Número de episodios cerrados en este ciclo, disponibles en
+ *             d->closed hasta la siguiente llamada
+ */
+int throttle_update(throttle_detector *d, uint64_t ts_ns, float temp, float threshold,
+                    const cpu_counters *c);
+
+/**
+ * @brief Número de núcleos con un episodio abierto
+ */
+int throttle_open_count(const throttle_detector *d);
+
+/**
+ * @brief Libera el estado del detector
+ */
+void throttle_free(throttle_detector *d);
+
+#endif // THROTTLE_H - Fin de las guardas de inclusión
@@ -0,0 +1,429 @@
+/**
+ * @brief Módulo de topología de CPUs
+ * @description Implementa la lectura de la topología de sysfs, la
+ *              numeración densa de las unidades de cada nivel, la asignación
+ *              de canales de temperatura a CPUs y las reducciones por nivel.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <stdio.h>        // Para snprintf(), sscanf()
+#include <stdlib.h>       // Para calloc(), malloc(), free(), strtol()
+#include <string.h>       // Para memset(), strrchr(), strcmp()
+#include <unistd.h>       // Para readlink(), read(), close()
+#include <fcntl.h>        // Para open() y constantes O_*
+#include <dirent.h>       // Para opendir(), readdir()
+#include <limits.h>       // Para PATH_MAX
+#include "topology.h"     // Header con declaraciones del módulo
+
+// Nombres de los niveles (mismo orden que topo_level)
+static const char *const level_names[TOPO_LEVELS] = {"core", "ccd", "package", "node"};
+
+// Prioridad de asignación de un canal: el más específico gana
+enum {
+    PRIO_NONE,
+    PRIO_PACKAGE,
+    PRIO_DIE,       // Tdie gana a Tctl del mismo paquete (sin offset)
+    PRIO_CCD,
+    PRIO_CORE
+};
+
+/**
+ * @brief Lee un entero de un atributo de sysfs
+ * @return long Valor, o -1 si el atributo no existe
+ */
+static long read_int(const char *path) {
+    char buf[32];
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0) {
+        return -1;
+    }
+    buf[n] = '\0';
+    return strtol(buf, NULL, 10);
+}
+
+/**
+ * @brief Lee un atributo de topología de una CPU
+ */
+static long cpu_attr(const char *sysfs_root, int cpu, const char *attr) {
+    char path[PATH_MAX];
+
+    snprintf(path, sizeof(path), "%s/devices/system/cpu/cpu%d/%s", sysfs_root, cpu, attr);
+    return read_int(path);
+}
+
+/**
+ * @brief Nodo NUMA de una CPU (entrada "nodeN" en su directorio)
+ * @return int Nodo, 0 si el kernel no tiene NUMA
+ */
+static int cpu_node(const char *sysfs_root, int cpu) {
+    char path[PATH_MAX];
+    int node = 0;
+
+    snprintf(path, sizeof(path), "%s/devices/system/cpu/cpu%d", sysfs_root, cpu);
+    DIR *d = opendir(path);
+    if (!d) {
+        return 0;
+    }
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        if (sscanf(e->d_name, "node%d", &node) == 1) {
+            break;
+        }
+    }
+    closedir(d);
+    return node;
+}
+
+/**
+ * @brief Busca una clave en la lista de unidades del nivel o la añade
+ * @return int Índice denso de la unidad
+ */
+static int unit_index(topo_agg *a, long *keys, long key, int id, int package) {
+    for (int i = 0; i < a->count; i++) {
+        if (keys[i] == key) {
+            return i;
+        }
+    }
+    keys[a->count] = key;
+    a->id[a->count] = id;
+    a->package[a->count] = package;
+    return a->count++;
+}
+
+/**
+ * @brief Reserva los arreglos de un nivel (como máximo una unidad por CPU)
+ */
+static int agg_alloc(topo_agg *a, int ncpu) {
+    size_t n = (size_t)ncpu;
+
+    a->unit = malloc(n * sizeof(int));
+    a->id = calloc(n, sizeof(int));
+    a->package = calloc(n, sizeof(int));
+    a->ncpus = calloc(n, sizeof(int));
+    a->temp_max = calloc(n, sizeof(float));
+    a->util_pm = calloc(n, sizeof(uint16_t));
+    a->freq_mhz = calloc(n, sizeof(uint16_t));
+    a->throttle = calloc(n, sizeof(uint32_t));
+    a->util_sum = calloc(n, sizeof(uint32_t));
+    a->freq_sum = calloc(n, sizeof(uint32_t));
+    if (!a->unit || !a->id || !a->package || !a->ncpus || !a->temp_max || !a->util_pm ||
+        !a->freq_mhz || !a->throttle || !a->util_sum || !a->freq_sum) {
+        return -1;
+    }
+    for (int i = 0; i < ncpu; i++) {
+        a->unit[i] = -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Paquete al que pertenece el dispositivo hwmon de un canal
+ * @description Se lee el destino del enlace "device" del directorio hwmonN:
+ *              "coretemp.N" en Intel y la función PCI "0000:00:18+N.3" del
+ *              data fabric en AMD (un dispositivo por socket).
+ *
+ * @return int Paquete, o -1 si el canal describe todos los paquetes
+ */
+static int channel_package(const sensor_channel *c) {
+    char link[SENSOR_PATH_LEN + 8];
+    char target[PATH_MAX];
+    unsigned domain, bus, slot, fn;
+    int pkg;
+
+    const char *slash = strrchr(c->path, '/');
+    if (!slash) {
+        return -1;
+    }
+    snprintf(link, sizeof(link), "%.*s/device", (int)(slash - c->path), c->path);
+    ssize_t n = readlink(link, target, sizeof(target) - 1);
+    if (n <= 0) {
+        return -1;
+    }
+    target[n] = '\0';
+
+    const char *base = strrchr(target, '/');
+    base = base ? base + 1 : target;
+    if (sscanf(base, "coretemp.%d", &pkg) == 1) {
+        return pkg;
+    }
+    if ((strcmp(c->driver, "k10temp") == 0 || strcmp(c->driver, "zenpower") == 0) &&
+        sscanf(base, "%x:%x:%x.%x", &domain, &bus, &slot, &fn) == 4 && slot >= 0x18) {
+        return (int)(slot - 0x18);
+    }
+    return -1;
+}
+
+/**
+ * @brief Asigna un canal a las CPUs que describe si es más específico
+ */
+static void assign(topology *t, int *prio, int cpu, int ch, int p) {
+    if (p > prio[cpu]) {
+        prio[cpu] = p;
+        t->cpu_chan[cpu] = ch;
+    }
+}
+
+/**
+ * @brief Asigna los canales de temperatura a las CPUs
+ */
+static void map_channels(topology *t, const sensor_table *sensors, const long *core_id, int *prio) {
+    const topo_agg *pk = &t->level[TOPO_PACKAGE];
+    const topo_agg *cd = &t->level[TOPO_CCD];
+
+    // Ordinal de cada CCD dentro de su paquete (por identificador de L3)
+    int *ordinal = calloc((size_t)(cd->count + 1), sizeof(int));
+    if (!ordinal) {
+        return;
+    }
+    for (int u = 0; u < cd->count; u++) {
+        for (int v = 0; v < cd->count; v++) {
+            ordinal[u] += cd->package[v] == cd->package[u] && cd->id[v] < cd->id[u];
+        }
+    }
+
+    for (int ch = 0; ch < sensors->count; ch++) {
+        const sensor_channel *c = &sensors->ch[ch];
+        int chan_pkg = channel_package(c);
+        int n = c->index;
+
+        for (int cpu = 0; cpu < t->ncpu; cpu++) {
+            int u = pk->unit[cpu];
+            if (u < 0 || (chan_pkg >= 0 && pk->id[u] != chan_pkg)) {
+                continue;
+            }
+
+            if (c->role == SENSOR_ROLE_CORE && core_id[cpu] == n) {
+                assign(t, prio, cpu, ch, PRIO_CORE);
+            } else if (c->role == SENSOR_ROLE_PACKAGE && pk->id[u] == n) {
+                assign(t, prio, cpu, ch, PRIO_PACKAGE);
+            } else if (c->role == SENSOR_ROLE_CCD && n > 0) {
+                // En Zen 2 un CCD tiene dos dominios de L3: repartir los
+                // dominios del paquete entre sus canales Tccd
+                int nt = 0, nl = 0;
+                for (int k = 0; k < sensors->count; k++) {
+                    nt += sensors->ch[k].role == SENSOR_ROLE_CCD &&
+                          channel_package(&sensors->ch[k]) == chan_pkg;
+                }
+                for (int v = 0; v < cd->count; v++) {
+                    nl += cd->package[v] == pk->id[u];
+                }
+                int span = nt > 0 && nl % nt == 0 ? nl / nt : 1;
+                if (ordinal[cd->unit[cpu]] / span == n - 1) {
+                    assign(t, prio, cpu, ch, PRIO_CCD);
+                }
+            } else if (c->role == SENSOR_ROLE_DIE) {
+                assign(t, prio, cpu, ch, PRIO_DIE);
+            } else if (c->role == SENSOR_ROLE_CONTROL) {
+                assign(t, prio, cpu, ch, PRIO_PACKAGE);
+            }
+        }
+    }
+    free(ordinal);
+}
+
+/**
+ * @brief Construye el mapa de topología y asigna los canales de temperatura
+ */
+int topology_build(topology *t, const char *sysfs_root, int ncpu, const sensor_table *sensors) {
+    memset(t, 0, sizeof(*t));
+    if (ncpu <= 0) {
+        return -1;
+    }
+
+    long *keys[TOPO_LEVELS] = {0};
+    long *core_id = calloc((size_t)ncpu, sizeof(long));
+    int *prio = calloc((size_t)ncpu, sizeof(int));
+    int rc = -1;
+
+    t->ncpu = ncpu;
+    t->primary = sensors->primary;
+    t->cpu_chan = malloc((size_t)ncpu * sizeof(int));
+    t->cpu_temp = calloc((size_t)ncpu, sizeof(float));
+    t->thr_first = calloc((size_t)ncpu, 1);
+    if (!core_id || !prio || !t->cpu_chan || !t->cpu_temp || !t->thr_first) {
+        goto out;
+    }
+    for (int l = 0; l < TOPO_LEVELS; l++) {
+        keys[l] = calloc((size_t)ncpu, sizeof(long));
+        if (!keys[l] || agg_alloc(&t->level[l], ncpu) < 0) {
+            goto out;
+        }
+    }
+
+    int online = 0;
+    for (int cpu = 0; cpu < ncpu; cpu++) {
+        t->cpu_chan[cpu] = -1;
+
+        // Sin topology/ la CPU está fuera de línea
+        long pkg = cpu_attr(sysfs_root, cpu, "topology/physical_package_id");
+        if (pkg < 0) {
+            continue;
+        }
+        long core = cpu_attr(sysfs_root, cpu, "topology/core_id");
+        long l3 = cpu_attr(sysfs_root, cpu, "cache/index3/id");
+        int node = cpu_node(sysfs_root, cpu);
+        core_id[cpu] = core;
+
+        t->level[TOPO_PACKAGE].unit[cpu] = unit_index(&t->level[TOPO_PACKAGE], keys[TOPO_PACKAGE],
+                                                      pkg, (int)pkg, (int)pkg);
+        t->level[TOPO_CORE].unit[cpu] = unit_index(&t->level[TOPO_CORE], keys[TOPO_CORE],
+                                                   pkg * 65536 + core, (int)core, (int)pkg);
+        // Sin L3 identificable, el paquete completo es un único dominio
+        t->level[TOPO_CCD].unit[cpu] = l3 >= 0
+            ? unit_index(&t->level[TOPO_CCD], keys[TOPO_CCD], l3, (int)l3, (int)pkg)
+            : unit_index(&t->level[TOPO_CCD], keys[TOPO_CCD], -1 - pkg, (int)pkg, (int)pkg);
+        t->level[TOPO_NODE].unit[cpu] = unit_index(&t->level[TOPO_NODE], keys[TOPO_NODE],
+                                                   node, node, (int)pkg);
+        for (int l = 0; l < TOPO_LEVELS; l++) {
+            t->level[l].ncpus[t->level[l].unit[cpu]]++;
+        }
+        online++;
+    }
+
+    if (online > 0) {
+        // core_throttle_count es del núcleo (compartido por los hilos SMT) y
+        // package_throttle_count del paquete, aunque sysfs los repita en
+        // cada cpuN: se cuentan solo en la primera CPU de cada unidad
+        const topo_agg *co = &t->level[TOPO_CORE], *pk = &t->level[TOPO_PACKAGE];
+        unsigned char *seen_core = calloc((size_t)co->count + 1, 1);
+        unsigned char *seen_pkg = calloc((size_t)pk->count + 1, 1);
+        if (!seen_core || !seen_pkg) {
+            free(seen_core);
+            free(seen_pkg);
+            goto out;
+        }
+        for (int cpu = 0; cpu < ncpu; cpu++) {
+            if (co->unit[cpu] >= 0 && !seen_core[co->unit[cpu]]) {
+                seen_core[co->unit[cpu]] = 1;
+                t->thr_first[cpu] |= 1;
+            }
+            if (pk->unit[cpu] >= 0 && !seen_pkg[pk->unit[cpu]]) {
+                seen_pkg[pk->unit[cpu]] = 1;
+                t->thr_first[cpu] |= 2;
+            }
+        }
+        free(seen_core);
+        free(seen_pkg);
+
+        map_channels(t, sensors, core_id, prio);
+        for (int cpu = 0; cpu < ncpu; cpu++) {
+            int ch = t->cpu_chan[cpu];
+            if (ch >= 0 && ch != t->primary) {
+                t->chan_used[ch] = 1;
+                t->mapped = 1;
+            }
+        }
+        rc = 0;
+    }
+
+out:
+    for (int l = 0; l < TOPO_LEVELS; l++) {
+        free(keys[l]);
+    }
+    free(core_id);
+    free(prio);
+    if (rc < 0) {
+        topology_free(t);
+    }
+    return rc;
+}
+
+/**
+ * @brief Lee los canales de temperatura asignados a alguna CPU
+ */
+void topology_read_sensors(topology *t, const sensor_table *sensors, const acquire *a) {
+    for (int ch = 0; ch < sensors->count && ch < SENSOR_MAX_CHANNELS; ch++) {
+        if (t->chan_used[ch]) {
+            t->chan_temp[ch] = sensors_read(sensors, ch, a);
+        }
+    }
+}
+
+/**
+ * @brief Calcula los agregados de todos los niveles
+ * @description Una pasada por CPU para su temperatura y una pasada por CPU
+ *              y nivel sobre los arreglos de unidad, con acumuladores
+ *              enteros; al final se dividen por el número de CPUs. Los
+ *              eventos de throttling de núcleo se cuentan una vez por
+ *              núcleo y los de paquete una vez por paquete, solo en los
+ *              niveles de paquete y nodo.
+ */
+void topology_update(topology *t, float primary, const cpu_counters *c) {
+    for (int cpu = 0; cpu < t->ncpu; cpu++) {
+        int ch = t->cpu_chan[cpu];
+        t->cpu_temp[cpu] = ch < 0 || ch == t->primary ? primary : t->chan_temp[ch];
+    }
+
+    for (int l = 0; l < TOPO_LEVELS; l++) {
+        topo_agg *a = &t->level[l];
+        size_t n = (size_t)a->count;
+
+        for (size_t u = 0; u < n; u++) {
+            a->temp_max[u] = -1.0f;
+        }
+        memset(a->util_sum, 0, n * sizeof(uint32_t));
+        memset(a->freq_sum, 0, n * sizeof(uint32_t));
+        memset(a->throttle, 0, n * sizeof(uint32_t));
+
+        for (int cpu = 0; cpu < t->ncpu; cpu++) {
+            int u = a->unit[cpu];
+            if (u < 0) {
+                continue;
+            }
+            if (t->cpu_temp[cpu] > a->temp_max[u]) {
+                a->temp_max[u] = t->cpu_temp[cpu];
+            }
+            if (cpu < c->ncpu) {
+                a->util_sum[u] += c->util_pm[cpu];
+                a->freq_sum[u] += c->freq_mhz[cpu];
+                // Eventos del paquete solo en los niveles que lo contienen
+                if (t->thr_first[cpu] & 1) {
+                    a->throttle[u] += c->d_core_thr[cpu];
+                }
+                if ((t->thr_first[cpu] & 2) && (l == TOPO_PACKAGE || l == TOPO_NODE)) {
+                    a->throttle[u] += c->d_pkg_thr[cpu];
+                }
+            }
+        }
+
+        for (size_t u = 0; u < n; u++) {
+            a->util_pm[u] = (uint16_t)(a->util_sum[u] / (uint32_t)a->ncpus[u]);
+            a->freq_mhz[u] = (uint16_t)(a->freq_sum[u] / (uint32_t)a->ncpus[u]);
+        }
+    }
+}
+
+/**
+ * @brief Nombre de un nivel ("core", "ccd", "package", "node")
+ */
+const char *topology_level_name(topo_level level) {
+    return level >= 0 && level < TOPO_LEVELS ? level_names[level] : "?";
+}
+
+/**
+ * @brief Libera el mapa de topología
+ */
+void topology_free(topology *t) {
+    for (int l = 0; l < TOPO_LEVELS; l++) {
+        topo_agg *a = &t->level[l];
+        free(a->unit);
+        free(a->id);
+        free(a->package);
+        free(a->ncpus);
+        free(a->temp_max);
+        free(a->util_pm);
+        free(a->freq_mhz);
+        free(a->throttle);
+        free(a->util_sum);
+        free(a->freq_sum);
+    }
+    free(t->cpu_chan);
+    free(t->cpu_temp);
+    free(t->thr_first);
+    memset(t, 0, sizeof(*t));
+}
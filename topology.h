@@ -0,0 +1,110 @@
+/**
+ * @brief Header del módulo de topología de CPUs
+ * @description Define el mapa de topología construido a partir de
+ *              <sysfs_root>/devices/system/cpu: a qué núcleo físico, CCD
+ *              (dominio de L3), paquete (socket) y nodo NUMA pertenece cada
+ *              CPU lógica, y qué canal de temperatura describe mejor cada
+ *              CPU. En cada ciclo se calculan agregados por nivel
+ *              (temperatura máxima, utilización y frecuencia medias, eventos
+ *              de throttling) recorriendo arreglos contiguos indexados por
+ *              CPU, para detectar un socket o un CCD caliente que la lectura
+ *              única de Tctl no muestra.
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef TOPOLOGY_H  // Si TOPOLOGY_H no está definido
+#define TOPOLOGY_H  // Definir TOPOLOGY_H como macro de protección
+
+#include <stdint.h>          // Para tipos de ancho fijo
+#include "temp_monitor.h"    // Para sensor_table
+#include "cpu_counters.h"    // Para cpu_counters
+
+/**
+ * @brief Niveles de la topología
+ */
+typedef enum {
+    TOPO_CORE,     // Núcleo físico (hilos SMT hermanos)
+    TOPO_CCD,      // Dominio de L3: un CCD en Zen 3+, un CCX en Zen 2
+    TOPO_PACKAGE,  // Paquete (socket)
+    TOPO_NODE,     // Nodo NUMA
+    TOPO_LEVELS
+} topo_level;
+
+/**
+ * @brief Unidades y agregados de un nivel
+ * @description Todos los arreglos por unidad tienen count elementos; unit
+ *              tiene ncpu elementos y da la unidad de cada CPU (-1 = CPU
+ *              fuera de línea).
+ */
+typedef struct {
+    int count;            // Unidades del nivel
+    int *unit;            // CPU -> unidad
+    int *id;              // Identificador de sysfs de cada unidad
+    int *package;         // Paquete de cada unidad
+    int *ncpus;           // CPUs lógicas de cada unidad
+    float *temp_max;      // Temperatura máxima de las CPUs de la unidad
+    uint16_t *util_pm;    // Utilización media (por mil)
+    uint16_t *freq_mhz;   // Frecuencia media en MHz
+    uint32_t *throttle;   // Eventos de throttling de núcleo (y de paquete en package y node)
+    uint32_t *util_sum;   // Acumuladores de la pasada por CPU
+    uint32_t *freq_sum;
+} topo_agg;
+
+/**
+ * @brief Mapa de topología
+ */
+typedef struct {
+    int ncpu;                       // CPUs configuradas (0 = sin topología)
+    topo_agg level[TOPO_LEVELS];    // Unidades y agregados por nivel
+    int *cpu_chan;                  // CPU -> canal de temperatura más específico (-1 = primario)
+    float *cpu_temp;                // Temperatura de cada CPU en el último ciclo
+    unsigned char *thr_first;       // Bit 0/1: primera CPU de su núcleo/paquete
+    int primary;                    // Canal primario de la tabla de sensores
+    int mapped;                     // 1 si algún canal describe solo parte de las CPUs
+    unsigned char chan_used[SENSOR_MAX_CHANNELS]; // 1 si alguna CPU usa el canal
+    float chan_temp[SENSOR_MAX_CHANNELS];         // Lecturas del último ciclo por canal
+} topology;
+
+/**
+ * @brief Construye el mapa de topología y asigna los canales de temperatura
+ * @description Lee physical_package_id, core_id, cache/index3/id y el
+ *              enlace nodeN de cada CPU. Los canales se asignan por driver:
+ *              - coretemp: "Core N" a las CPUs con core_id N de su paquete y
+ *                "Package id N" a todo el paquete
+ *              - k10temp / zenpower: "TccdN" al N-ésimo CCD de su paquete y
+ *                Tctl / Tdie a todo el paquete
+ *              El paquete de un canal se obtiene del dispositivo hwmon
+ *              (coretemp.N o la función PCI 00:18+N.3 de AMD).
+ *
+ * @return int 0 si éxito, -1 si no hay memoria o no existe la topología
+ */
+int topology_build(topology *t, const char *sysfs_root, int ncpu, const sensor_table *sensors);
+
+/**
+ * @brief Lee los canales de temperatura asignados a alguna CPU
+ * @description Solo hace falta cuando t->mapped: si todos los canales
+ *              describen la máquina completa basta con el primario.
+ */
+void topology_read_sensors(topology *t, const sensor_table *sensors, const acquire *a);
+
+/**
+ * @brief Calcula los agregados de todos los niveles
+ *
+ * @param t       Mapa de topología
+ * @param primary Temperatura del canal primario (CPUs sin canal propio)
+ * @param c       Contadores por CPU del ciclo
+ */
+void topology_update(topology *t, float primary, const cpu_counters *c);
+
+/**
+ * @brief Nombre de un nivel ("core", "ccd", "package", "node")
+ */
+const char *topology_level_name(topo_level level);
+
+/**
+ * @brief Libera el mapa de topología
+ */
+void topology_free(topology *t);
+
+#endif // TOPOLOGY_H - Fin de las guardas de inclusión
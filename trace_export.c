@@ -0,0 +1,377 @@
+/**
+ * @brief Exportador del log binario del daemon a formato Chrome trace-event
+ * @description Convierte un log binario de cpu_daemon (binlog_path) en JSON
+ *              de eventos de traza, cargable en chrome://tracing, Perfetto UI
+ *              o Speedscope junto a las trazas de las aplicaciones:
+ *              - Cada canal de temperatura es una pista de contador ("ph":"C")
+ *              - Cada alerta es un evento instantáneo global ("ph":"i")
+ *              - Cada etapa del ciclo del daemon es un span completo ("ph":"X")
+ *              - Cada cgroup muestreado es una pista de contador con su % de
+ *                CPU del host y su tiempo limitado por cpu.max
+ *              - Cada CPU es una pista de contador con su utilización, su
+ *                frecuencia y sus eventos de throttling térmico
+ *              - Cada episodio de throttling es un span completo del núcleo
+ *              - Cada zona de energía (RAPL) es una pista de contador en vatios
+ *              - La presión (PSI) de cpu, memory e io es una pista de
+ *                contador por recurso
+ *              - El IPC y la frecuencia efectiva de cada CPU (perf_event)
+ *                son una pista de contador por CPU
+ *              - Cada núcleo, CCD, paquete y nodo NUMA es una pista de
+ *                contador con su temperatura máxima, utilización, frecuencia
+ *                y throttling
+ *              - El rendimiento de cpu_stressor es una pista de contador en
+ *                unidades de trabajo por segundo
+ *              - El log de latencias de cpu_stressor (-l) es un proceso
+ *                propio con una pista de contador por hilo (mínimo, media
+ *                y máximo de cada ventana) y un evento instantáneo con los
+ *                percentiles finales
+ *              Las marcas de tiempo son CLOCK_MONOTONIC en microsegundos, el
+ *              mismo reloj que usan perf y Perfetto, así que las pistas se
+ *              alinean con otras trazas del mismo host.
+ *              La conversión es en streaming: un registro a la vez, con
+ *              memoria constante sea cual sea la longitud de la traza.
+ * @author Sistema de monitoreo CPU
+ *
+ * @usage cpu_trace_export [-o salida.json] log_binario [log_binario...]
+ *        Con "-" como log se lee la entrada estándar. Los logs del daemon y
+ *        de cpu_stressor -l se pueden combinar en una sola traza.
+ */
+
+#include <stdio.h>         // Para FILE, fprintf(), fopen()
+#include <string.h>        // Para strcmp(), memcpy()
+#include <unistd.h>        // Para getopt()
+#include "binlog.h"        // Formato del log binario
+#include "selfstat.h"      // Para selfstat_stage_name()
+#include "temp_monitor.h"  // Para SENSOR_MAX_CHANNELS
+#include "cgroup_stat.h"   // Para CGROUP_MAX, CGROUP_NAME_LEN
+#include "power.h"         // Para POWER_MAX_ZONES, POWER_NAME_LEN
+#include "psi.h"           // Para psi_resource_name()
+#include "topology.h"      // Para topology_level_name()
+
+/**
+ * @brief Estado del exportador: solo la tabla de nombres de canal
+ * @description El índice 0 corresponde al canal -1 (comando 'sensors').
+ */
+typedef struct {
+    FILE *out;
+    int first;                                        // Sin coma antes del primer evento
+    int32_t pid;                                      // PID del último BINLOG_START
+    char labels[SENSOR_MAX_CHANNELS + 1][32];         // Etiquetas por canal
+    char cgroups[CGROUP_MAX][CGROUP_NAME_LEN];        // Nombres de cgroup por índice
+    char zones[POWER_MAX_ZONES][POWER_NAME_LEN];      // Nombres de zona de energía
+} exporter;
+
+/**
+ * @brief Escribe una cadena JSON escapando comillas, barras y controles
+ */
+static void json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Inicia un evento: separador y campos comunes (ph, ts, pid, tid)
+ */
+static void event_begin(exporter *e, const char *ph, uint64_t ts_ns) {
+    fputs(e->first ? "\n" : ",\n", e->out);
+    e->first = 0;
+    fprintf(e->out, "{\"ph\":\"%s\",\"ts\":%llu.%03llu,\"pid\":%d,\"tid\":%d",
+            ph, (unsigned long long)(ts_ns / 1000), (unsigned long long)(ts_ns % 1000),
+            (int)e->pid, (int)e->pid);
+}
+
+/**
+ * @brief Nombre de un canal para las pistas de contador
+ */
+static const char *channel_label(const exporter *e, int32_t channel) {
+    if (channel < -1 || channel >= SENSOR_MAX_CHANNELS || e->labels[channel + 1][0] == '\0') {
+        return channel < 0 ? "sensors" : "channel";
+    }
+    return e->labels[channel + 1];
+}
+
+/**
+ * @brief Convierte un registro del log binario en eventos de traza
+ */
+static void export_record(exporter *e, const binlog_record *r) {
+    switch (r->hdr.type) {
+        case BINLOG_START: {
+            binlog_start s;
+            memcpy(&s, r->payload, sizeof(s));
+            e->pid = s.pid;
+            event_begin(e, "M", r->hdr.ts_ns);
+            fprintf(e->out, ",\"name\":\"process_name\",\"args\":{\"name\":\"cpu_daemon\"}}");
+            break;
+        }
+        case BINLOG_CHANNEL: {
+            binlog_channel c;
+            memcpy(&c, r->payload, sizeof(c));
+            if (c.channel >= -1 && c.channel < SENSOR_MAX_CHANNELS) {
+                snprintf(e->labels[c.channel + 1], sizeof(e->labels[0]), "%.15s %.15s",
+                         c.driver, c.label);
+            }
+            break;
+        }
+        case BINLOG_SAMPLE: {
+            binlog_sample s;
+            memcpy(&s, r->payload, sizeof(s));
+            event_begin(e, "C", r->hdr.ts_ns);
+            fputs(",\"cat\":\"temperature\",\"name\":", e->out);
+            json_string(e->out, channel_label(e, s.channel));
+            fprintf(e->out, ",\"args\":{\"celsius\":%.3f}}", s.milli / 1000.0);
+            break;
+        }
+        case BINLOG_ALERT: {
+            binlog_alert a;
+            memcpy(&a, r->payload, sizeof(a));
+            event_begin(e, "i", r->hdr.ts_ns);
+            fputs(",\"s\":\"g\",\"cat\":\"alert\",\"name\":\"thermal alert\",\"args\":{\"channel\":", e->out);
+            json_string(e->out, channel_label(e, a.channel));
+            fprintf(e->out, ",\"celsius\":%.3f,\"threshold\":%.3f}}",
+                    a.milli / 1000.0, a.threshold_milli / 1000.0);
+            break;
+        }
+        case BINLOG_SPAN: {
+            binlog_span s;
+            memcpy(&s, r->payload, sizeof(s));
+            event_begin(e, "X", r->hdr.ts_ns);
+            fprintf(e->out, ",\"cat\":\"daemon\",\"name\":\"%s\",\"dur\":%llu.%03llu}",
+                    selfstat_stage_name((selfstat_stage)s.stage),
+                    (unsigned long long)(s.dur_ns / 1000), (unsigned long long)(s.dur_ns % 1000));
+            break;
+        }
+        case BINLOG_CGROUP_NAME: {
+            binlog_cgroup_name c;
+            memcpy(&c, r->payload, sizeof(c));
+            if (c.id >= 0 && c.id < CGROUP_MAX) {
+                snprintf(e->cgroups[c.id], sizeof(e->cgroups[0]), "%.*s",
+                         (int)sizeof(c.name), c.name);
+            }
+            break;
+        }
+        case BINLOG_CGROUP: {
+            binlog_cgroup c;
+            memcpy(&c, r->payload, sizeof(c));
+            if (c.id < 0 || c.id >= CGROUP_MAX) {
+                break;
+            }
+            event_begin(e, "C", r->hdr.ts_ns);
+            fputs(",\"cat\":\"cgroup\",\"name\":", e->out);
+            char name[CGROUP_NAME_LEN + 8];
+            snprintf(name, sizeof(name), "cgroup %s", e->cgroups[c.id]);
+            json_string(e->out, name);
+            fprintf(e->out, ",\"args\":{\"cpu_host_pct\":%.4f,\"throttled_ms\":%.3f}}",
+                    c.host_share_ppm / 10000.0, c.throttled_usec / 1000.0);
+            break;
+        }
+        case BINLOG_CPU: {
+            binlog_cpu c;
+            memcpy(&c, r->payload, sizeof(c));
+            event_begin(e, "C", r->hdr.ts_ns);
+            fprintf(e->out, ",\"cat\":\"cpu\",\"name\":\"cpu %u\",\"args\":{\"util_pct\":%.1f,"
+                    "\"freq_mhz\":%u,\"throttle_events\":%u}}",
+                    (unsigned)c.cpu, c.util_pm / 10.0, (unsigned)c.freq_mhz,
+                    c.core_throttle + c.pkg_throttle);
+            break;
+        }
+        case BINLOG_THROTTLE: {
+            binlog_throttle t;
+            memcpy(&t, r->payload, sizeof(t));
+            event_begin(e, "X", r->hdr.ts_ns);
+            fprintf(e->out, ",\"cat\":\"throttle\",\"name\":\"throttle cpu %u\",\"dur\":%llu.%03llu,"
+                    "\"args\":{\"peak_celsius\":%.3f,\"lost_gcycles\":%.3f}}",
+                    (unsigned)t.cpu,
+                    (unsigned long long)(t.dur_ns / 1000), (unsigned long long)(t.dur_ns % 1000),
+                    t.peak_milli / 1000.0, t.lost_cycles / 1e9);
+            break;
+        }
+        case BINLOG_POWER_ZONE: {
+            binlog_power_zone z;
+            memcpy(&z, r->payload, sizeof(z));
+            if (z.id >= 0 && z.id < POWER_MAX_ZONES) {
+                snprintf(e->zones[z.id], sizeof(e->zones[0]), "%.*s", (int)sizeof(z.name), z.name);
+            }
+            break;
+        }
+        case BINLOG_POWER: {
+            binlog_power p;
+            memcpy(&p, r->payload, sizeof(p));
+            if (p.id < 0 || p.id >= POWER_MAX_ZONES) {
+                break;
+            }
+            event_begin(e, "C", r->hdr.ts_ns);
+            fputs(",\"cat\":\"power\",\"name\":", e->out);
+            char name[POWER_NAME_LEN + 8];
+            snprintf(name, sizeof(name), "power %s", e->zones[p.id]);
+            json_string(e->out, name);
+            fprintf(e->out, ",\"args\":{\"watts\":%.3f}}", p.milliwatts / 1000.0);
+            break;
+        }
+        case BINLOG_PSI: {
+            binlog_psi p;
+            memcpy(&p, r->payload, sizeof(p));
+            event_begin(e, "C", r->hdr.ts_ns);
+            fprintf(e->out, ",\"cat\":\"pressure\",\"name\":\"pressure %s\",\"args\":{"
+                    "\"some_avg10\":%.2f,\"full_avg10\":%.2f,\"some_stall_ms\":%.3f}}",
+                    psi_resource_name((psi_resource)p.resource),
+                    p.some_avg10 / 100.0, p.full_avg10 / 100.0, p.some_us / 1000.0);
+            break;
+        }
+        case BINLOG_PMU: {
+            binlog_pmu p;
+            memcpy(&p, r->payload, sizeof(p));
+            event_begin(e, "C", r->hdr.ts_ns);
+            fprintf(e->out, ",\"cat\":\"pmu\",\"name\":\"pmu cpu %u\",\"args\":{\"util_pct\":%.1f",
+                    (unsigned)p.cpu, p.busy_pm / 10.0);
+            if (p.hardware) {
+                fprintf(e->out, ",\"ipc\":%.3f,\"ghz\":%.3f", p.ipc_milli / 1000.0, p.eff_mhz / 1000.0);
+            }
+            fputs("}}", e->out);
+            break;
+        }
+        case BINLOG_TOPO: {
+            binlog_topo t;
+            memcpy(&t, r->payload, sizeof(t));
+            event_begin(e, "C", r->hdr.ts_ns);
+            fprintf(e->out, ",\"cat\":\"topology\",\"name\":\"%s %u\",\"args\":{"
+                    "\"temp_c\":%.3f,\"util_pct\":%.1f,\"freq_mhz\":%u,\"throttle\":%u}}",
+                    topology_level_name((topo_level)t.level), (unsigned)t.id,
+                    t.temp_milli / 1000.0, t.util_pm / 10.0, (unsigned)t.freq_mhz, t.throttle);
+            break;
+        }
+        case BINLOG_STRESS: {
+            binlog_stress s;
+            memcpy(&s, r->payload, sizeof(s));
+            s.kernel[sizeof(s.kernel) - 1] = '\0';
+            s.unit[sizeof(s.unit) - 1] = '\0';
+            event_begin(e, "C", r->hdr.ts_ns);
+            fputs(",\"cat\":\"stress\",\"name\":", e->out);
+            char name[sizeof(s.kernel) + 8];
+            snprintf(name, sizeof(name), "stress %s", s.kernel);
+            json_string(e->out, name);
+            fputs(",\"args\":{", e->out);
+            char key[sizeof(s.unit) + 8];
+            snprintf(key, sizeof(key), "%s_per_s", s.unit);
+            json_string(e->out, key);
+            fprintf(e->out, ":%llu}}", (unsigned long long)s.ops_per_s);
+            break;
+        }
+        case BINLOG_CHUNK_INFO: {
+            binlog_chunk_info c;
+            memcpy(&c, r->payload, sizeof(c));
+            c.kernel[sizeof(c.kernel) - 1] = '\0';
+            event_begin(e, "M", r->hdr.ts_ns);
+            fprintf(e->out, ",\"name\":\"process_name\",\"args\":{\"name\":");
+            char name[sizeof(c.kernel) + 16];
+            snprintf(name, sizeof(name), "cpu_stressor %s", c.kernel);
+            json_string(e->out, name);
+            fputs("}}", e->out);
+            break;
+        }
+        case BINLOG_CHUNK: {
+            binlog_chunk c;
+            memcpy(&c, r->payload, sizeof(c));
+            event_begin(e, "C", r->hdr.ts_ns);
+            fprintf(e->out, ",\"cat\":\"chunk\",\"name\":\"chunk cpu%u\",\"args\":{"
+                    "\"min_us\":%.3f,\"mean_us\":%.3f,\"max_us\":%.3f}}",
+                    (unsigned)c.cpu, c.min_ns / 1000.0, c.mean_ns / 1000.0, c.max_ns / 1000.0);
+            break;
+        }
+        case BINLOG_CHUNK_SUMMARY: {
+            binlog_chunk_summary c;
+            memcpy(&c, r->payload, sizeof(c));
+            event_begin(e, "i", r->hdr.ts_ns);
+            fprintf(e->out, ",\"s\":\"p\",\"cat\":\"chunk\",\"name\":\"chunk latency thread %u cpu%u\","
+                    "\"args\":{\"count\":%llu,\"p50_us\":%.3f,\"p99_us\":%.3f,\"p999_us\":%.3f,\"max_us\":%.3f}}",
+                    (unsigned)c.thread, (unsigned)c.cpu, (unsigned long long)c.count,
+                    c.p50_ns / 1000.0, c.p99_ns / 1000.0, c.p999_ns / 1000.0, c.max_ns / 1000.0);
+            break;
+        }
+        default:
+            // Tipo desconocido (versión más nueva del daemon): se ignora
+            break;
+    }
+}
+
+/**
+ * @brief Exporta un log binario completo
+ * @return int 0 si éxito, -1 si el archivo no se pudo abrir o está corrupto
+ */
+static int export_file(exporter *e, const char *path) {
+    FILE *in = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    binlog_record rec;
+    int rc;
+
+    if (!in) {
+        perror(path);
+        return -1;
+    }
+    while ((rc = binlog_read(in, &rec)) > 0) {
+        export_record(e, &rec);
+    }
+    if (in != stdin) {
+        fclose(in);
+    }
+    if (rc < 0) {
+        // Un último registro incompleto es normal si el daemon sigue escribiendo
+        fprintf(stderr, "%s: registro final incompleto, se ignora\n", path);
+    }
+    return 0;
+}
+
+/**
+ * @brief Función principal del exportador
+ *
+ * @return int 0 si todos los logs se exportaron, 1 en caso contrario
+ */
+int main(int argc, char *argv[]) {
+    static exporter e;
+    const char *out_path = NULL;
+    int opt, rc = 0;
+
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        switch (opt) {
+            case 'o':
+                out_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-o salida.json] log_binario...\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "Uso: %s [-o salida.json] log_binario...\n", argv[0]);
+        return 1;
+    }
+
+    e.out = out_path ? fopen(out_path, "w") : stdout;
+    if (!e.out) {
+        perror(out_path);
+        return 1;
+    }
+    e.first = 1;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", e.out);
+    for (int i = optind; i < argc; i++) {
+        if (export_file(&e, argv[i]) < 0) {
+            rc = 1;
+        }
+    }
+    fputs("\n]}\n", e.out);
+
+    if (e.out != stdout && fclose(e.out) != 0) {
+        rc = 1;
+    }
+    return rc;
+}
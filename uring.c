@@ -0,0 +1,305 @@
+/**
+ * @brief Envoltorio mínimo de io_uring
+ * @description Implementa la creación del anillo, el registro de
+ *              descriptores y búferes, la preparación de lecturas fijas y la
+ *              recogida de resultados. La cola de envío la escribe solo este
+ *              proceso y la de finalización solo el kernel, así que basta
+ *              con cargas con acquire y almacenamientos con release sobre
+ *              las cabezas y colas compartidas.
+ * @author Sistema de monitoreo CPU
+ */
+
+#include <string.h>       // Para memset()
+#include <errno.h>        // Para errno, ENOSYS, EOPNOTSUPP
+#include <unistd.h>       // Para syscall(), close()
+#include <sys/mman.h>     // Para mmap(), munmap()
+#include <sys/syscall.h>  // Para __NR_io_uring_*
+#include "uring.h"        // Header con declaraciones del módulo
+
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h> // Para struct io_uring_params, io_uring_sqe, io_uring_cqe
+
+/**
+ * @brief Crea el anillo
+ * @description Mapea la cola de envío, la de finalización (en la misma
+ *              región si el kernel anuncia IORING_FEAT_SINGLE_MMAP) y el
+ *              arreglo de SQE.
+ */
+int uring_init(uring *r, unsigned entries) {
+    struct io_uring_params p;
+
+    memset(r, 0, sizeof(*r));
+    memset(&p, 0, sizeof(p));
+    r->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (r->fd < 0) {
+        r->fd = -1;
+        return -1;
+    }
+    r->entries = p.sq_entries;
+    r->features = p.features;
+
+    r->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    int single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && r->cq_len > r->sq_len) {
+        r->sq_len = r->cq_len;
+    }
+
+    r->sq_map = mmap(NULL, r->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     r->fd, IORING_OFF_SQ_RING);
+    if (r->sq_map == MAP_FAILED) {
+        r->sq_map = NULL;
+        goto fail;
+    }
+    r->cq_map = single ? r->sq_map
+                       : mmap(NULL, r->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                              r->fd, IORING_OFF_CQ_RING);
+    if (r->cq_map == MAP_FAILED) {
+        r->cq_map = NULL;
+        goto fail;
+    }
+    r->sqe_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    r->sqes = mmap(NULL, r->sqe_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   r->fd, IORING_OFF_SQES);
+    if (r->sqes == MAP_FAILED) {
+        r->sqes = NULL;
+        goto fail;
+    }
+
+    char *sq = r->sq_map, *cq = r->cq_map;
+    r->sq_head = (unsigned *)(sq + p.sq_off.head);
+    r->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    r->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    r->sq_array = (unsigned *)(sq + p.sq_off.array);
+    r->cq_head = (unsigned *)(cq + p.cq_off.head);
+    r->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    r->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    r->cqes = cq + p.cq_off.cqes;
+    return 0;
+
+fail:
+    uring_free(r);
+    return -1;
+}
+
+/**
+ * @brief Destruye el anillo y libera sus registros
+ */
+void uring_free(uring *r) {
+    if (r->sqes != NULL) {
+        munmap(r->sqes, r->sqe_len);
+    }
+    if (r->cq_map != NULL && r->cq_map != r->sq_map) {
+        munmap(r->cq_map, r->cq_len);
+    }
+    if (r->sq_map != NULL) {
+        munmap(r->sq_map, r->sq_len);
+    }
+    if (r->fd >= 0) {
+        // Cerrar el anillo libera también los descriptores y búferes registrados
+        close(r->fd);
+    }
+    memset(r, 0, sizeof(*r));
+    r->fd = -1;
+}
+
+/**
+ * @brief Registra los descriptores que usarán las lecturas
+ */
+int uring_register_files(uring *r, const int *fds, unsigned n) {
+    // Sin registro previo, UNREGISTER falla con ENXIO: se ignora
+    syscall(__NR_io_uring_register, r->fd, IORING_UNREGISTER_FILES, NULL, 0);
+    return syscall(__NR_io_uring_register, r->fd, IORING_REGISTER_FILES, fds, n) < 0 ? -1 : 0;
+}
+
+/**
+ * @brief Registra las regiones de memoria de destino de las lecturas
+ */
+int uring_register_buffers(uring *r, const struct iovec *iov, unsigned n) {
+    syscall(__NR_io_uring_register, r->fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+    return syscall(__NR_io_uring_register, r->fd, IORING_REGISTER_BUFFERS, iov, n) < 0 ? -1 : 0;
+}
+
+/**
+ * @brief Prepara una lectura desde el desplazamiento 0
+ * @description La SQE no es visible para el kernel hasta uring_submit().
+ */
+int uring_queue_read(uring *r, unsigned file, void *buf, unsigned len, unsigned buf_index,
+                     uint64_t user_data) {
+    unsigned tail = *r->sq_tail + r->queued;
+    unsigned head = __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE);
+    if (tail - head >= r->entries) {
+        return -1;
+    }
+
+    unsigned idx = tail & *r->sq_mask;
+    struct io_uring_sqe *sqe = (struct io_uring_sqe *)r->sqes + idx;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ_FIXED;
+    sqe->flags = IOSQE_FIXED_FILE;
+    sqe->fd = (int)file;
+    sqe->addr = (uint64_t)(uintptr_t)buf;
+    sqe->len = len;
+    sqe->off = 0;
+    sqe->buf_index = (uint16_t)buf_index;
+    sqe->user_data = user_data;
+    r->sq_array[idx] = idx;
+    r->queued++;
+    return 0;
+}
+
+/**
+ * @brief Hace visibles al kernel las lecturas preparadas
+ * @return unsigned Entradas de la cola que el kernel aún no tomó (incluidas
+ *                  las de un envío anterior interrumpido)
+ */
+static unsigned publish(uring *r) {
+    unsigned tail = *r->sq_tail + r->queued;
+    __atomic_store_n(r->sq_tail, tail, __ATOMIC_RELEASE);
+    r->queued = 0;
+    return tail - __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Envía las lecturas preparadas con una sola llamada al sistema
+ */
+int uring_submit(uring *r, unsigned wait_nr) {
+    unsigned n = publish(r);
+
+    int ret = (int)syscall(__NR_io_uring_enter, r->fd, n, wait_nr,
+                           wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    return ret < 0 ? -1 : ret;
+}
+
+/**
+ * @brief Envía las lecturas preparadas y espera resultados con un plazo
+ * @description El plazo va en struct io_uring_getevents_arg
+ *              (IORING_ENTER_EXT_ARG): un lote con un archivo bloqueado no
+ *              bloquea al llamante.
+ */
+int uring_submit_timeout(uring *r, unsigned wait_nr, uint64_t timeout_ns) {
+#ifdef IORING_FEAT_EXT_ARG
+    struct __kernel_timespec ts = {
+        .tv_sec = (long long)(timeout_ns / 1000000000ull),
+        .tv_nsec = (long long)(timeout_ns % 1000000000ull),
+    };
+    struct io_uring_getevents_arg arg = {.ts = (uint64_t)(uintptr_t)&ts};
+    unsigned n = publish(r);
+
+    int ret = (int)syscall(__NR_io_uring_enter, r->fd, n, wait_nr,
+                           IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    return ret < 0 ? -1 : ret;
+#else
+    (void)r; (void)wait_nr; (void)timeout_ns;
+    errno = EOPNOTSUPP;
+    return -1;
+#endif
+}
+
+/**
+ * @brief Indica si el kernel admite esperas con plazo (IORING_FEAT_EXT_ARG)
+ */
+int uring_has_timeout(const uring *r) {
+#ifdef IORING_FEAT_EXT_ARG
+    return r->fd >= 0 && (r->features & IORING_FEAT_EXT_ARG) != 0;
+#else
+    (void)r;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Retira de la cola las lecturas que el kernel no llegó a tomar
+ * @description Sin SQPOLL el kernel solo consume la cola dentro de
+ *              io_uring_enter(), así que fuera de él se puede retroceder la
+ *              cola hasta su cabeza.
+ */
+unsigned uring_unqueue(uring *r) {
+    unsigned head = __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE);
+    unsigned n = *r->sq_tail - head;
+    __atomic_store_n(r->sq_tail, head, __ATOMIC_RELEASE);
+    n += r->queued;
+    r->queued = 0;
+    return n;
+}
+
+/**
+ * @brief Recoge todos los resultados disponibles, sin llamadas al sistema
+ * @description Lee la cola del kernel una vez y avanza la cabeza una vez
+ *              para todo el lote.
+ */
+unsigned uring_reap(uring *r, uring_completion *out, unsigned max) {
+    unsigned head = *r->cq_head;
+    unsigned tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+    unsigned n = 0;
+
+    for (; head != tail && n < max; head++, n++) {
+        const struct io_uring_cqe *cqe = (const struct io_uring_cqe *)r->cqes + (head & *r->cq_mask);
+        out[n].user_data = cqe->user_data;
+        out[n].res = cqe->res;
+    }
+    __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+}
+
+#else // Sin <linux/io_uring.h>: siempre se usa pread()
+
+int uring_init(uring *r, unsigned entries) {
+    (void)entries;
+    memset(r, 0, sizeof(*r));
+    r->fd = -1;
+    errno = ENOSYS;
+    return -1;
+}
+
+void uring_free(uring *r) {
+    memset(r, 0, sizeof(*r));
+    r->fd = -1;
+}
+
+int uring_register_files(uring *r, const int *fds, unsigned n) {
+    (void)r; (void)fds; (void)n;
+    errno = ENOSYS;
+    return -1;
+}
+
+int uring_register_buffers(uring *r, const struct iovec *iov, unsigned n) {
+    (void)r; (void)iov; (void)n;
+    errno = ENOSYS;
+    return -1;
+}
+
+int uring_queue_read(uring *r, unsigned file, void *buf, unsigned len, unsigned buf_index,
+                     uint64_t user_data) {
+    (void)r; (void)file; (void)buf; (void)len; (void)buf_index; (void)user_data;
+    return -1;
+}
+
+int uring_submit(uring *r, unsigned wait_nr) {
+    (void)r; (void)wait_nr;
+    errno = ENOSYS;
+    return -1;
+}
+
+int uring_submit_timeout(uring *r, unsigned wait_nr, uint64_t timeout_ns) {
+    (void)r; (void)wait_nr; (void)timeout_ns;
+    errno = ENOSYS;
+    return -1;
+}
+
+int uring_has_timeout(const uring *r) {
+    (void)r;
+    return 0;
+}
+
+unsigned uring_unqueue(uring *r) {
+    (void)r;
+    return 0;
+}
+
+unsigned uring_reap(uring *r, uring_completion *out, unsigned max) {
+    (void)r; (void)out; (void)max;
+    return 0;
+}
+
+#endif // HAVE_LINUX_IO_URING_H
@@ -0,0 +1,152 @@
+/**
+ * @brief Header del envoltorio mínimo de io_uring
+ * @description Define un anillo io_uring creado con las llamadas al sistema
+ *              directas (io_uring_setup, io_uring_enter, io_uring_register),
+ *              sin liburing. Solo cubre lo que necesita la adquisición de
+ *              sensores: lecturas con descriptores y búferes registrados
+ *              (IORING_OP_READ_FIXED con IOSQE_FIXED_FILE), enviadas en un
+ *              solo lote y recogidas de una vez. Si el sistema se compiló
+ *              sin <linux/io_uring.h>, uring_init() falla con ENOSYS y el
+ *              llamante usa pread().
+ * @author Sistema de monitoreo CPU
+ */
+
+// Guardas de inclusión para prevenir inclusiones múltiples del header
+#ifndef URING_H  // Si URING_H no está definido
+#define URING_H  // Definir URING_H como macro de protección
+
+#include <stdint.h>     // Para tipos de ancho fijo
+#include <stddef.h>     // Para size_t
+#include <sys/uio.h>    // Para struct iovec
+
+/**
+ * @brief Anillo io_uring mapeado en memoria
+ * @description Las colas de envío y finalización son memoria compartida con
+ *              el kernel; los punteros apuntan a sus cabeceras y arreglos.
+ */
+typedef struct {
+    int fd;                    // Descriptor del anillo (-1 = sin anillo)
+    unsigned entries;          // Entradas de la cola de envío
+    unsigned features;         // IORING_FEAT_* anunciadas por el kernel
+    unsigned *sq_head;         // Cabeza de la cola de envío (la avanza el kernel)
+    unsigned *sq_tail;         // Cola de la cola de envío (la avanzamos nosotros)
+    unsigned *sq_mask;
+    unsigned *sq_array;        // Índices de las SQE enviadas
+    void *sqes;                // struct io_uring_sqe[entries]
+    unsigned *cq_head;         // Cabeza de la cola de finalización (nuestra)
+    unsigned *cq_tail;         // Cola de la cola de finalización (del kernel)
+    unsigned *cq_mask;
+    void *cqes;                // struct io_uring_cqe[]
+    unsigned queued;           // SQE preparadas y aún no enviadas
+    void *sq_map, *cq_map;     // Regiones mapeadas (cq_map == sq_map con un solo mmap)
+    size_t sq_len, cq_len, sqe_len;
+} uring;
+
+/**
+ * @brief Resultado de una operación terminada
+ */
+typedef struct {
+    uint64_t user_data;        // Valor dado a uring_queue_read()
+    int32_t res;               // Bytes leídos, o -errno
+} uring_completion;
+
+/**
+ * @brief Crea el anillo
+ *
+ * @param r       Anillo (queda con fd = -1 si falla)
+ * @param entries Entradas de la cola de envío (potencia de 2 o se redondea)
+ *
+ * @return int 0 si éxito, -1 si io_uring no está disponible (errno)
+ */
+int uring_init(uring *r, unsigned entries);
+
+/**
+ * @brief Destruye el anillo y libera sus registros
+ */
+void uring_free(uring *r);
+
+/**
+ * @brief Registra los descriptores que usarán las lecturas
+ * @description Evita la búsqueda y el recuento de referencias del
+ *              descriptor en cada operación. Sustituye un registro previo.
+ *
+ * @return int 0 si éxito, -1 si error (errno)
+ */
+int uring_register_files(uring *r, const int *fds, unsigned n);
+
+/**
+ * @brief Registra las regiones de memoria de destino de las lecturas
+ * @description El kernel fija las páginas una sola vez en lugar de en cada
+ *              lectura. Sustituye un registro previo.
+ *
+ * @return int 0 si éxito, -1 si error (errno)
+ */
+int uring_register_buffers(uring *r, const struct iovec *iov, unsigned n);
+
+/**
+ * @brief Prepara una lectura desde el desplazamiento 0
+ *
+ * @param r         Anillo
+ * @param file      Índice en los descriptores registrados
+ * @param buf       Destino, dentro de la región registrada buf_index
+ * @param len       Bytes a leer
+ * @param buf_index Índice en las regiones registradas
+ * @param user_data Valor devuelto con el resultado
+ *
+ * @return int 0 si éxito, -1 si la cola de envío está llena
+ */
+int uring_queue_read(uring *r, unsigned file, void *buf, unsigned len, unsigned buf_index,
+                     uint64_t user_data);
+
+/**
+ * @brief Envía las lecturas preparadas con una sola llamada al sistema
+ *
+ * @param r       Anillo
+ * @param wait_nr Resultados a esperar antes de volver (0 = no esperar)
+ *
+ * @return int Operaciones enviadas, -1 si error (errno)
+ */
+int uring_submit(uring *r, unsigned wait_nr);
+
+/**
+ * @brief Envía las lecturas preparadas y espera resultados con un plazo
+ * @description Vuelve al llegar wait_nr resultados o al vencer el plazo, lo
+ *              que ocurra antes; las lecturas que no terminaron siguen en
+ *              curso y su resultado llegará en una recogida posterior.
+ *              Requiere uring_has_timeout().
+ *
+ * @param r          Anillo
+ * @param wait_nr    Resultados a esperar
+ * @param timeout_ns Espera máxima
+ *
+ * @return int Operaciones enviadas (0 si no había ninguna preparada), -1 si
+ *             error o si venció el plazo sin enviar nada (errno = ETIME)
+ */
+int uring_submit_timeout(uring *r, unsigned wait_nr, uint64_t timeout_ns);
+
+/**
+ * @brief Indica si el kernel admite esperas con plazo (IORING_FEAT_EXT_ARG)
+ */
+int uring_has_timeout(const uring *r);
+
+/**
+ * @brief Retira de la cola las lecturas que el kernel no llegó a tomar
+ * @description Tras un envío parcial o interrumpido (o un plazo que venció
+ *              antes de enviar), las lecturas retiradas nunca se ejecutan.
+ *
+ * @return unsigned Lecturas retiradas (las últimas preparadas)
+ */
+unsigned uring_unqueue(uring *r);
+
+/**
+ * @brief Recoge todos los resultados disponibles, sin llamadas al sistema
+ *
+ * @param r   Anillo
+ * @param out Destino de los resultados
+ * @param max Capacidad de out
+ *
+ * @return unsigned Resultados recogidos
+ */
+unsigned uring_reap(uring *r, uring_completion *out, unsigned max);
+
+#endif // URING_H - Fin de las guardas de inclusión